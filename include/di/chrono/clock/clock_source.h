@@ -0,0 +1,43 @@
+#pragma once
+
+#include "di/types/integers.h"
+
+// The clock source provides the raw readings for di's clocks, in nanoseconds. When using DI_NO_USE_STD on a platform
+// other than Linux, or when DI_CUSTOM_CLOCK_SOURCE is defined, these functions must be defined by the environment.
+#if defined(DI_CUSTOM_CLOCK_SOURCE) || (defined(DI_NO_USE_STD) && !defined(__linux__))
+namespace di::chrono::detail {
+auto read_steady_clock() -> i64;
+auto read_system_clock() -> i64;
+}
+#elifdef DI_NO_USE_STD
+#include "di/platform/linux_syscall.h"
+
+namespace di::chrono::detail {
+inline auto read_clock(int clock) -> i64 {
+    auto result = platform::linux_syscall::clock_gettime(clock);
+    return result.seconds * 1000000000 + result.nanoseconds;
+}
+
+inline auto read_steady_clock() -> i64 {
+    return read_clock(platform::linux_syscall::clock_monotonic);
+}
+
+inline auto read_system_clock() -> i64 {
+    return read_clock(platform::linux_syscall::clock_realtime);
+}
+}
+#else
+#include <chrono>
+
+namespace di::chrono::detail {
+inline auto read_steady_clock() -> i64 {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+inline auto read_system_clock() -> i64 {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+}
+#endif
@@ -0,0 +1,4 @@
+#pragma once
+
+#include "di/chrono/clock/steady_clock.h"
+#include "di/chrono/clock/system_clock.h"
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "di/chrono/clock/clock_source.h"
+#include "di/chrono/duration/duration_literals.h"
+#include "di/chrono/time_point/time_point.h"
+
+namespace di::chrono {
+/// @brief A monotonic clock, suitable for measuring intervals and scheduling timers.
+///
+/// The epoch of this clock is unspecified, but it is guaranteed to never go backwards.
+class SteadyClock {
+public:
+    using Duration = Nanoseconds;
+    using Representation = Duration::Representation;
+    using Period = Duration::Period;
+    using TimePoint = chrono::TimePoint<SteadyClock, Duration>;
+
+    constexpr static bool is_steady = true;
+
+    static auto now() -> TimePoint { return TimePoint(Duration(detail::read_steady_clock())); }
+};
+}
+
+namespace di {
+using chrono::SteadyClock;
+}
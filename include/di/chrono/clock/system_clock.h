@@ -0,0 +1,27 @@
+#pragma once
+
+#include "di/chrono/clock/clock_source.h"
+#include "di/chrono/duration/duration_literals.h"
+#include "di/chrono/time_point/time_point.h"
+
+namespace di::chrono {
+/// @brief A wall clock, measuring time since the Unix epoch.
+///
+/// This clock can jump forwards or backwards if the system time is adjusted, and so should not be used for measuring
+/// intervals. Use SteadyClock for that instead.
+class SystemClock {
+public:
+    using Duration = Nanoseconds;
+    using Representation = Duration::Representation;
+    using Period = Duration::Period;
+    using TimePoint = chrono::TimePoint<SystemClock, Duration>;
+
+    constexpr static bool is_steady = false;
+
+    static auto now() -> TimePoint { return TimePoint(Duration(detail::read_system_clock())); }
+};
+}
+
+namespace di {
+using chrono::SystemClock;
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "di/chrono/clock/prelude.h"
 #include "di/chrono/concepts/prelude.h"
 #include "di/chrono/duration/prelude.h"
 #include "di/chrono/time_point/prelude.h"
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "di/container/algorithm/max.h"
+#include "di/container/allocator/allocate.h"
+#include "di/container/allocator/allocation_result.h"
+#include "di/container/allocator/allocator.h"
+#include "di/container/allocator/deallocate.h"
+#include "di/container/allocator/infallible_allocator.h"
+#include "di/math/align_up.h"
+#include "di/types/byte.h"
+#include "di/types/prelude.h"
+#include "di/util/exchange.h"
+
+namespace di::container {
+/// @brief A region of memory which hands out allocations sequentially, and frees them all at once.
+///
+/// Memory is obtained from the global allocator in chunks, which grow geometrically, and allocations are carved out of
+/// the current chunk by bumping a pointer. Individual deallocations are ignored, except that the most recent allocation
+/// can be returned, which lets a container at the end of the arena shrink cheaply. All memory is released when the
+/// arena is destroyed or release() is called, regardless of how many allocations were made.
+///
+/// Objects allocated from an arena must not outlive it. Destructors still run as normal, but freeing memory is a no-op,
+/// so destroying a large tree of objects allocated from an arena costs nothing beyond the destructors themselves.
+///
+/// @see ArenaAllocator
+class Arena {
+private:
+    struct Chunk {
+        Chunk* previous { nullptr };
+        usize size { 0 };
+    };
+
+public:
+    constexpr static usize default_chunk_size = 4096;
+    constexpr static usize max_chunk_size = 1024 * 1024;
+
+    Arena() = default;
+
+    explicit Arena(usize initial_chunk_size) : m_next_chunk_size(initial_chunk_size) {}
+
+    Arena(Arena const&) = delete;
+    auto operator=(Arena const&) -> Arena& = delete;
+
+    ~Arena() { release(); }
+
+    auto allocate(usize size, usize alignment) -> AllocationResult<> {
+        auto* data = aligned(m_current, alignment);
+        if (!m_current || data + size > m_end) {
+            grow(size, alignment);
+            data = aligned(m_current, alignment);
+        }
+        m_current = data + size;
+        return AllocationResult<> { data, size };
+    }
+
+    void deallocate(void* data, usize size, usize) {
+        if (static_cast<byte*>(data) + size == m_current) {
+            m_current = static_cast<byte*>(data);
+        }
+    }
+
+    /// @brief Free all memory owned by the arena.
+    ///
+    /// This invalidates every allocation made from the arena.
+    void release() {
+        auto allocator = InfallibleAllocator {};
+        for (auto* chunk = util::exchange(m_chunks, nullptr); chunk;) {
+            auto* previous = chunk->previous;
+            di::deallocate(allocator, chunk, chunk->size, alignof(Chunk));
+            chunk = previous;
+        }
+        m_current = nullptr;
+        m_end = nullptr;
+    }
+
+private:
+    static auto aligned(byte* pointer, usize alignment) -> byte* {
+        return reinterpret_cast<byte*>(math::align_up(reinterpret_cast<uptr>(pointer), alignment));
+    }
+
+    void grow(usize size, usize alignment) {
+        auto const needed = sizeof(Chunk) + size + alignment;
+        auto const chunk_size = container::max(m_next_chunk_size, needed);
+        if (m_next_chunk_size < max_chunk_size) {
+            m_next_chunk_size *= 2;
+        }
+
+        auto allocator = InfallibleAllocator {};
+        auto [data, count] = di::allocate(allocator, chunk_size, alignof(Chunk));
+        auto* chunk = static_cast<Chunk*>(data);
+        chunk->previous = m_chunks;
+        chunk->size = count;
+        m_chunks = chunk;
+
+        m_current = reinterpret_cast<byte*>(chunk + 1);
+        m_end = static_cast<byte*>(data) + count;
+    }
+
+    Chunk* m_chunks { nullptr };
+    byte* m_current { nullptr };
+    byte* m_end { nullptr };
+    usize m_next_chunk_size { default_chunk_size };
+};
+
+/// @brief An allocator which allocates from an Arena.
+///
+/// This is a cheap handle to the arena, which is copied into every container using it, so containers must be
+/// explicitly constructed with an allocator to make use of the arena. A default constructed ArenaAllocator is not
+/// associated with any arena, and allocates from the global heap instead. Since containers carry their allocator along
+/// with their storage, this means containers created without an arena can be freely mixed with arena backed ones.
+///
+/// @see Arena
+class ArenaAllocator {
+public:
+    ArenaAllocator() = default;
+
+    constexpr explicit ArenaAllocator(Arena& arena) : m_arena(&arena) {}
+
+    auto allocate(usize size, usize alignment) const -> AllocationResult<> {
+        if (!m_arena) {
+            return InfallibleAllocator::allocate(size, alignment);
+        }
+        return m_arena->allocate(size, alignment);
+    }
+
+    void deallocate(void* data, usize size, usize alignment) const {
+        if (!m_arena) {
+            InfallibleAllocator::deallocate(data, size, alignment);
+            return;
+        }
+        m_arena->deallocate(data, size, alignment);
+    }
+
+    constexpr auto arena() const -> Arena* { return m_arena; }
+
+    constexpr friend auto operator==(ArenaAllocator const& a, ArenaAllocator const& b) -> bool {
+        return a.m_arena == b.m_arena;
+    }
+
+private:
+    Arena* m_arena { nullptr };
+};
+
+static_assert(di::concepts::Allocator<ArenaAllocator>, "ArenaAllocator must model di::Allocator");
+}
+
+namespace di {
+using container::Arena;
+using container::ArenaAllocator;
+}
@@ -0,0 +1,215 @@
+#pragma once
+
+#include "di/assert/assert_bool.h"
+#include "di/bit/operation/bit_ceil.h"
+#include "di/container/algorithm/max.h"
+#include "di/container/allocator/allocate_many.h"
+#include "di/container/allocator/allocation_result.h"
+#include "di/container/allocator/allocator.h"
+#include "di/container/allocator/deallocate_many.h"
+#include "di/meta/operations.h"
+#include "di/platform/prelude.h"
+#include "di/sync/atomic.h"
+#include "di/sync/cache_padded.h"
+#include "di/sync/memory_order.h"
+#include "di/types/prelude.h"
+#include "di/util/addressof.h"
+#include "di/util/construct_at.h"
+#include "di/util/destroy_at.h"
+#include "di/util/forward.h"
+#include "di/util/move.h"
+#include "di/vocab/expected/prelude.h"
+#include "di/vocab/optional/prelude.h"
+#include "di/vocab/span/prelude.h"
+
+namespace di::container {
+/// @brief A bounded, lock-free, multi-producer multi-consumer queue.
+///
+/// @tparam T The type of the elements.
+/// @tparam Alloc The allocator used for the queue's storage.
+///
+/// Every cell stores a sequence number next to its element, which says whether the cell is ready to be written or
+/// read for a given position. A producer claims a position by advancing the enqueue position with a compare-and-swap,
+/// constructs the element, and then publishes it by bumping the cell's sequence number. Consumers do the same with the
+/// dequeue position. So producers only contend with other producers, and consumers with other consumers, and the
+/// two positions live on separate cache lines. The bulk operations claim a run of consecutive cells using a single
+/// compare-and-swap.
+///
+/// The capacity is fixed by calling reserve_from_nothing() once, before the queue is shared between threads. It is
+/// rounded up to a power of 2, and is at least 2.
+///
+/// @note The queue is lock-free but not wait-free: a producer which is preempted after claiming a cell, but before
+/// publishing it, prevents consumers from reading past that cell until it resumes.
+///
+/// @see SpscRing
+template<typename T, concepts::Allocator Alloc = platform::DefaultAllocator>
+class MpmcQueue {
+private:
+    struct Cell {
+        explicit Cell(usize sequence_) : sequence(sequence_) {}
+
+        ~Cell() {}
+
+        sync::Atomic<usize> sequence;
+        union {
+            T value;
+        };
+    };
+
+public:
+    using Value = T;
+
+    MpmcQueue() = default;
+    explicit MpmcQueue(Alloc allocator) : m_allocator(util::move(allocator)) {}
+
+    MpmcQueue(MpmcQueue&&) = delete;
+
+    ~MpmcQueue() { deallocate(); }
+
+    auto capacity() const -> usize { return m_capacity; }
+
+    auto reserve_from_nothing(usize n) {
+        DI_ASSERT(capacity() == 0U);
+
+        // A single cell cannot tell a full queue from an empty one, so at least 2 are needed.
+        auto const new_capacity = bit::bit_ceil(container::max(n, 2zu));
+        return as_fallible(di::allocate_many<Cell>(m_allocator, new_capacity)) % [&](AllocationResult<Cell> result) {
+            m_cells = result.data;
+            m_capacity = new_capacity;
+            for (auto i = usize(0); i < m_capacity; i++) {
+                util::construct_at(m_cells + i, i);
+            }
+        } | try_infallible;
+    }
+
+    /// @brief Construct an element at the back of the queue, unless the queue is full.
+    template<typename... Args>
+    requires(concepts::ConstructibleFrom<T, Args...>)
+    auto try_emplace(Args&&... args) -> bool {
+        auto position = usize(0);
+        if (claim(*m_enqueue_position, 0, 1, position) == 0) {
+            return false;
+        }
+
+        auto& cell = cell_at(position);
+        util::construct_at(util::addressof(cell.value), util::forward<Args>(args)...);
+        cell.sequence.store(position + 1, sync::MemoryOrder::Release);
+        return true;
+    }
+
+    auto try_push(T const& value) -> bool
+    requires(concepts::CopyConstructible<T>)
+    {
+        return try_emplace(value);
+    }
+
+    auto try_push(T&& value) -> bool { return try_emplace(util::move(value)); }
+
+    /// @brief Remove the element at the front of the queue, unless the queue is empty.
+    auto try_pop() -> Optional<T> {
+        auto position = usize(0);
+        if (claim(*m_dequeue_position, 1, 1, position) == 0) {
+            return nullopt;
+        }
+
+        auto& cell = cell_at(position);
+        auto result = Optional<T>(util::move(cell.value));
+        util::destroy_at(util::addressof(cell.value));
+        cell.sequence.store(position + m_capacity, sync::MemoryOrder::Release);
+        return result;
+    }
+
+    /// @brief Move as many elements from the front of values as fit, returning the number pushed.
+    ///
+    /// The elements pushed are adjacent in the queue, so they are not interleaved with elements from other producers.
+    auto try_push_bulk(Span<T> values) -> usize {
+        auto position = usize(0);
+        auto const count = claim(*m_enqueue_position, 0, values.size(), position);
+        for (auto i = usize(0); i < count; i++) {
+            auto& cell = cell_at(position + i);
+            util::construct_at(util::addressof(cell.value), util::move(values[i]));
+            cell.sequence.store(position + i + 1, sync::MemoryOrder::Release);
+        }
+        return count;
+    }
+
+    /// @brief Move as many elements as are available into the front of output, returning the number popped.
+    auto try_pop_bulk(Span<T> output) -> usize
+    requires(concepts::MoveAssignable<T>)
+    {
+        auto position = usize(0);
+        auto const count = claim(*m_dequeue_position, 1, output.size(), position);
+        for (auto i = usize(0); i < count; i++) {
+            auto& cell = cell_at(position + i);
+            output[i] = util::move(cell.value);
+            util::destroy_at(util::addressof(cell.value));
+            cell.sequence.store(position + i + m_capacity, sync::MemoryOrder::Release);
+        }
+        return count;
+    }
+
+private:
+    auto cell_at(usize position) -> Cell& { return m_cells[position & (m_capacity - 1)]; }
+
+    // Claim up to max consecutive cells starting at the current value of counter, which are ready when their sequence
+    // number is their position plus offset. Returns the number of cells claimed, and stores the first one's position.
+    auto claim(sync::Atomic<usize>& counter, usize offset, usize max, usize& position) -> usize {
+        if (max == 0 || m_capacity == 0) {
+            return 0;
+        }
+
+        position = counter.load(sync::MemoryOrder::Relaxed);
+        for (;;) {
+            auto const sequence = cell_at(position).sequence.load(sync::MemoryOrder::Acquire);
+            auto const difference = isize(sequence - (position + offset));
+            if (difference < 0) {
+                // The other side has not finished with this cell yet, so the queue is full (or empty).
+                return 0;
+            }
+            if (difference > 0) {
+                // Another thread claimed this position already.
+                position = counter.load(sync::MemoryOrder::Relaxed);
+                continue;
+            }
+
+            // A cell's sequence number only changes once its position is claimed, so the run of ready cells stays
+            // ready as long as the compare-and-swap below succeeds.
+            auto count = usize(1);
+            while (count < max &&
+                   cell_at(position + count).sequence.load(sync::MemoryOrder::Acquire) == position + count + offset) {
+                count++;
+            }
+
+            if (counter.compare_exchange_weak(position, position + count, sync::MemoryOrder::Relaxed,
+                                              sync::MemoryOrder::Relaxed)) {
+                return count;
+            }
+        }
+    }
+
+    void deallocate() {
+        if (!m_cells) {
+            return;
+        }
+
+        auto const tail = m_enqueue_position->load(sync::MemoryOrder::Relaxed);
+        for (auto position = m_dequeue_position->load(sync::MemoryOrder::Relaxed); position != tail; position++) {
+            util::destroy_at(util::addressof(cell_at(position).value));
+        }
+        for (auto i = usize(0); i < m_capacity; i++) {
+            util::destroy_at(m_cells + i);
+        }
+        di::deallocate_many<Cell>(m_allocator, m_cells, m_capacity);
+    }
+
+    Cell* m_cells { nullptr };
+    usize m_capacity { 0 };
+    [[no_unique_address]] Alloc m_allocator {};
+    sync::CachePadded<sync::Atomic<usize>> m_enqueue_position { 0zu };
+    sync::CachePadded<sync::Atomic<usize>> m_dequeue_position { 0zu };
+};
+}
+
+namespace di {
+using container::MpmcQueue;
+}
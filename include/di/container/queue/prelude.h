@@ -1,5 +1,6 @@
 #pragma once
 
+#include "di/container/queue/mpmc_queue.h"
 #include "di/container/queue/priority_queue.h"
 #include "di/container/queue/queue.h"
 #include "di/container/queue/stack.h"
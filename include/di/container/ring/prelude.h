@@ -1,4 +1,5 @@
 #pragma once
 
 #include "di/container/ring/ring.h"
+#include "di/container/ring/spsc_ring.h"
 #include "di/container/ring/static_ring.h"
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "di/assert/assert_bool.h"
+#include "di/bit/operation/bit_ceil.h"
+#include "di/container/algorithm/min.h"
+#include "di/container/allocator/allocate_many.h"
+#include "di/container/allocator/allocation_result.h"
+#include "di/container/allocator/allocator.h"
+#include "di/container/allocator/deallocate_many.h"
+#include "di/meta/operations.h"
+#include "di/platform/prelude.h"
+#include "di/sync/atomic.h"
+#include "di/sync/cache_padded.h"
+#include "di/sync/memory_order.h"
+#include "di/types/prelude.h"
+#include "di/util/construct_at.h"
+#include "di/util/destroy_at.h"
+#include "di/util/forward.h"
+#include "di/util/move.h"
+#include "di/vocab/expected/prelude.h"
+#include "di/vocab/optional/prelude.h"
+#include "di/vocab/span/prelude.h"
+
+namespace di::container {
+/// @brief A bounded, lock-free, single-producer single-consumer ring.
+///
+/// @tparam T The type of the elements.
+/// @tparam Alloc The allocator used for the ring's storage.
+///
+/// The producer only writes the tail index, and the consumer only writes the head index, each on its own cache line.
+/// Next to its own index, each side keeps a cached copy of the other side's index, which is only reloaded when the
+/// cached copy says the ring is full (or empty). So in the common case, pushing and popping do not touch any cache line
+/// written by the other side.
+///
+/// Exactly one thread may push, and one thread may pop, at a time. The capacity is fixed by calling
+/// reserve_from_nothing() once, before the ring is shared between threads. It is rounded up to a power of 2.
+///
+/// @see MpmcQueue
+/// @see SpscByteRing
+template<typename T, concepts::Allocator Alloc = platform::DefaultAllocator>
+class SpscRing {
+private:
+    struct Side {
+        // The index owned by this side, which the other side reads.
+        sync::Atomic<usize> index { 0 };
+
+        // This side's copy of the other side's index.
+        usize cached_peer_index { 0 };
+    };
+
+public:
+    using Value = T;
+
+    SpscRing() = default;
+    explicit SpscRing(Alloc allocator) : m_allocator(util::move(allocator)) {}
+
+    SpscRing(SpscRing&&) = delete;
+
+    ~SpscRing() { deallocate(); }
+
+    auto capacity() const -> usize { return m_capacity; }
+
+    auto reserve_from_nothing(usize n) {
+        DI_ASSERT(capacity() == 0U);
+
+        auto const new_capacity = bit::bit_ceil(n);
+        return as_fallible(di::allocate_many<T>(m_allocator, new_capacity)) % [&](AllocationResult<T> result) {
+            m_data = result.data;
+            m_capacity = new_capacity;
+        } | try_infallible;
+    }
+
+    /// @name Producer
+    /// @{
+    template<typename... Args>
+    requires(concepts::ConstructibleFrom<T, Args...>)
+    auto try_emplace(Args&&... args) -> bool {
+        auto const tail = m_producer->index.load(sync::MemoryOrder::Relaxed);
+        if (writable(tail, 1) == 0) {
+            return false;
+        }
+
+        util::construct_at(slot_at(tail), util::forward<Args>(args)...);
+        m_producer->index.store(tail + 1, sync::MemoryOrder::Release);
+        return true;
+    }
+
+    auto try_push(T const& value) -> bool
+    requires(concepts::CopyConstructible<T>)
+    {
+        return try_emplace(value);
+    }
+
+    auto try_push(T&& value) -> bool { return try_emplace(util::move(value)); }
+
+    /// @brief Move as many elements from the front of values as fit, returning the number pushed.
+    ///
+    /// The elements are published to the consumer all at once.
+    auto try_push_bulk(Span<T> values) -> usize {
+        auto const tail = m_producer->index.load(sync::MemoryOrder::Relaxed);
+        auto const count = container::min(values.size(), writable(tail, values.size()));
+        for (auto i = usize(0); i < count; i++) {
+            util::construct_at(slot_at(tail + i), util::move(values[i]));
+        }
+        m_producer->index.store(tail + count, sync::MemoryOrder::Release);
+        return count;
+    }
+    /// @}
+
+    /// @name Consumer
+    /// @{
+    auto try_pop() -> Optional<T> {
+        auto const head = m_consumer->index.load(sync::MemoryOrder::Relaxed);
+        if (readable(head, 1) == 0) {
+            return nullopt;
+        }
+
+        auto* slot = slot_at(head);
+        auto result = Optional<T>(util::move(*slot));
+        util::destroy_at(slot);
+        m_consumer->index.store(head + 1, sync::MemoryOrder::Release);
+        return result;
+    }
+
+    /// @brief Move as many elements as are available into the front of output, returning the number popped.
+    auto try_pop_bulk(Span<T> output) -> usize
+    requires(concepts::MoveAssignable<T>)
+    {
+        auto const head = m_consumer->index.load(sync::MemoryOrder::Relaxed);
+        auto const count = container::min(output.size(), readable(head, output.size()));
+        for (auto i = usize(0); i < count; i++) {
+            auto* slot = slot_at(head + i);
+            output[i] = util::move(*slot);
+            util::destroy_at(slot);
+        }
+        m_consumer->index.store(head + count, sync::MemoryOrder::Release);
+        return count;
+    }
+    /// @}
+
+private:
+    auto slot_at(usize index) -> T* { return m_data + (index & (m_capacity - 1)); }
+
+    // The number of free slots, which reloads the head only if the cached copy says fewer than wanted are free.
+    auto writable(usize tail, usize wanted) -> usize {
+        auto space = m_capacity - (tail - m_producer->cached_peer_index);
+        if (space < wanted) {
+            m_producer->cached_peer_index = m_consumer->index.load(sync::MemoryOrder::Acquire);
+            space = m_capacity - (tail - m_producer->cached_peer_index);
+        }
+        return space;
+    }
+
+    // The number of elements available, which reloads the tail only if the cached copy says fewer than wanted are.
+    auto readable(usize head, usize wanted) -> usize {
+        auto available = m_consumer->cached_peer_index - head;
+        if (available < wanted) {
+            m_consumer->cached_peer_index = m_producer->index.load(sync::MemoryOrder::Acquire);
+            available = m_consumer->cached_peer_index - head;
+        }
+        return available;
+    }
+
+    void deallocate() {
+        if (!m_data) {
+            return;
+        }
+
+        auto const tail = m_producer->index.load(sync::MemoryOrder::Relaxed);
+        for (auto head = m_consumer->index.load(sync::MemoryOrder::Relaxed); head != tail; head++) {
+            util::destroy_at(slot_at(head));
+        }
+        di::deallocate_many<T>(m_allocator, m_data, m_capacity);
+    }
+
+    T* m_data { nullptr };
+    usize m_capacity { 0 };
+    [[no_unique_address]] Alloc m_allocator {};
+    sync::CachePadded<Side> m_producer;
+    sync::CachePadded<Side> m_consumer;
+};
+}
+
+namespace di {
+using container::SpscRing;
+}
@@ -29,6 +29,7 @@ public:
     using Allocator = Alloc;
 
     constexpr Vector() = default;
+    constexpr explicit Vector(Alloc allocator) : m_allocator(util::move(allocator)) {}
     constexpr Vector(Vector const&) = delete;
     constexpr Vector(Vector&& other)
         : m_data(util::exchange(other.m_data, nullptr))
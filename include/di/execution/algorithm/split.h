@@ -20,6 +20,7 @@
 #include "di/meta/algorithm.h"
 #include "di/platform/compiler.h"
 #include "di/sync/atomic.h"
+#include "di/sync/cache_padded.h"
 #include "di/sync/memory_order.h"
 #include "di/sync/stop_token/in_place_stop_token.h"
 #include "di/util/addressof.h"
@@ -129,7 +130,7 @@ namespace split_ns {
                 // value which indicates that the operation has completed, since we know that we are a valid pointer
                 // but are not an operation state. This could instead be done using a bitflag in the pointer, but this
                 // is simpler.
-                auto* operations = waiting.exchange(static_cast<void*>(this), sync::MemoryOrder::AcquireRelease);
+                auto* operations = waiting->exchange(static_cast<void*>(this), sync::MemoryOrder::AcquireRelease);
 
                 // Now walk the linked list of pending operations and notify them that the operation has completed.
                 // There cannot be races here because we just stole the list of pending operations, so it is not visible
@@ -141,9 +142,9 @@ namespace split_ns {
                 }
             }
 
-            void bump_ref_count() { ref_count.fetch_add(1, sync::MemoryOrder::Relaxed); }
+            void bump_ref_count() { ref_count->fetch_add(1, sync::MemoryOrder::Relaxed); }
             void drop_ref_count() {
-                if (ref_count.fetch_sub(1, sync::MemoryOrder::Release) == 1) {
+                if (ref_count->fetch_sub(1, sync::MemoryOrder::Release) == 1) {
                     // Destroy the shared state when the reference count reaches 0. Since we store the allocator
                     // ourselves, we must first move it out of the operation state before destroying ourselves.
                     auto allocator = util::move(this->allocator);
@@ -156,8 +157,9 @@ namespace split_ns {
             Storage storage;
             StopSource stop_source;
             SenderAttr sender_attr;
-            sync::Atomic<usize> ref_count { 1 };
-            sync::Atomic<void*> waiting { nullptr };
+            // These are updated by every receiver, so they are kept apart from the rest of the state.
+            sync::CachePadded<sync::Atomic<usize>> ref_count { 1 };
+            sync::CachePadded<sync::Atomic<void*>> waiting { nullptr };
             [[no_unique_address]] Alloc allocator;
             DI_IMMOVABLE_NO_UNIQUE_ADDRESS Op operation;
         };
@@ -211,7 +213,7 @@ namespace split_ns {
                 // again. Additionally, we stop trying if the old head is the sentinel value, which indicates that the
                 // operation has already completed, and just return after forwarding the values. We need to load the old
                 // value with acquire semantics to since we write the sentinel value with acquire-release semantics.
-                auto* old_head = state.waiting.load(sync::MemoryOrder::Acquire);
+                auto* old_head = state.waiting->load(sync::MemoryOrder::Acquire);
                 auto* sentinel = static_cast<void*>(self.m_state);
                 do {
                     if (old_head == sentinel) {
@@ -221,8 +223,8 @@ namespace split_ns {
                     }
 
                     self.next = static_cast<OperationStateBase*>(old_head);
-                } while (!state.waiting.compare_exchange_weak(old_head, static_cast<void*>(util::addressof(self)),
-                                                              sync::MemoryOrder::Release, sync::MemoryOrder::Acquire));
+                } while (!state.waiting->compare_exchange_weak(old_head, static_cast<void*>(util::addressof(self)),
+                                                               sync::MemoryOrder::Release, sync::MemoryOrder::Acquire));
 
                 // Emplace the stop callback.
                 self.m_stop_callback.emplace(execution::get_stop_token(execution::get_env(self.m_receiver)),
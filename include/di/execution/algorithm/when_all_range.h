@@ -0,0 +1,398 @@
+#pragma once
+
+#include "di/container/allocator/allocate_many.h"
+#include "di/container/allocator/allocator.h"
+#include "di/container/allocator/deallocate_many.h"
+#include "di/container/allocator/fallible_allocator.h"
+#include "di/container/allocator/infallible_allocator.h"
+#include "di/container/concepts/input_container.h"
+#include "di/container/concepts/sized_container.h"
+#include "di/container/interface/begin.h"
+#include "di/container/interface/end.h"
+#include "di/container/interface/size.h"
+#include "di/container/meta/container_value.h"
+#include "di/container/vector/vector.h"
+#include "di/execution/algorithm/when_all.h"
+#include "di/execution/concepts/receiver.h"
+#include "di/execution/concepts/receiver_of.h"
+#include "di/execution/concepts/sender.h"
+#include "di/execution/concepts/single_sender.h"
+#include "di/execution/interface/connect.h"
+#include "di/execution/interface/get_env.h"
+#include "di/execution/interface/start.h"
+#include "di/execution/meta/completion_signatures_of.h"
+#include "di/execution/meta/connect_result.h"
+#include "di/execution/meta/env_of.h"
+#include "di/execution/meta/single_sender_value_type.h"
+#include "di/execution/meta/stop_token_of.h"
+#include "di/execution/query/get_completion_signatures.h"
+#include "di/execution/query/get_stop_token.h"
+#include "di/execution/query/make_env.h"
+#include "di/execution/receiver/set_error.h"
+#include "di/execution/receiver/set_stopped.h"
+#include "di/execution/receiver/set_value.h"
+#include "di/execution/types/completion_signuatures.h"
+#include "di/function/tag_invoke.h"
+#include "di/meta/algorithm.h"
+#include "di/meta/core.h"
+#include "di/meta/util.h"
+#include "di/platform/prelude.h"
+#include "di/sync/atomic.h"
+#include "di/sync/memory_order.h"
+#include "di/sync/stop_token/prelude.h"
+#include "di/types/integers.h"
+#include "di/util/addressof.h"
+#include "di/util/construct_at.h"
+#include "di/util/destroy_at.h"
+#include "di/util/immovable.h"
+#include "di/util/move.h"
+#include "di/vocab/error/error.h"
+#include "di/vocab/expected/as_fallible.h"
+#include "di/vocab/optional/prelude.h"
+#include "di/vocab/variant/holds_alternative.h"
+#include "di/vocab/variant/visit.h"
+
+namespace di::execution {
+namespace when_all_range_ns {
+    template<typename E>
+    using Env = when_all_ns::Env<E>;
+
+    template<typename Env, typename Send>
+    concept ValidSender = concepts::SingleSender<Send, Env>;
+
+    template<typename Env, typename Send>
+    using ChildValue = meta::SingleSenderValueType<Send, Env>;
+
+    template<typename Env, typename Send>
+    constexpr inline bool sends_void = concepts::LanguageVoid<ChildValue<Env, Send>>;
+
+    template<typename Env, typename Send>
+    using StoredValue = meta::Conditional<sends_void<Env, Send>, Void, meta::Decay<ChildValue<Env, Send>>>;
+
+    template<typename Env, typename Send, typename Alloc>
+    using StoredValues = meta::Conditional<sends_void<Env, Send>, Void, Vector<StoredValue<Env, Send>, Alloc>>;
+
+    template<typename Env, typename Send, typename Alloc>
+    struct ValueCompletionT : meta::TypeConstant<SetValue()> {};
+
+    template<typename Env, typename Send, typename Alloc>
+    requires(!sends_void<Env, Send>)
+    struct ValueCompletionT<Env, Send, Alloc> : meta::TypeConstant<SetValue(StoredValues<Env, Send, Alloc>)> {};
+
+    template<typename Env, typename Send, typename Alloc>
+    using ValueCompletion = meta::Type<ValueCompletionT<Env, Send, Alloc>>;
+
+    template<typename Alloc>
+    using AllocationCompletions = meta::Conditional<concepts::FallibleAllocator<Alloc>, meta::List<SetError(Error)>,
+                                                    meta::List<>>;
+
+    template<typename E, typename Send, typename Alloc>
+    using Sigs = meta::AsTemplate<
+        types::CompletionSignatures,
+        meta::Unique<meta::Concat<meta::List<ValueCompletion<Env<E>, Send, Alloc>>,
+                                  when_all_ns::NonValueCompletions<Env<E>, Send>, AllocationCompletions<Alloc>>>>;
+
+    template<typename Data>
+    struct ReceiverT {
+        struct Type {
+            using is_receiver = void;
+
+            Data* data;
+            usize index;
+
+            template<typename... Types>
+            friend void tag_invoke(types::Tag<execution::set_value>, Type&& self, Types&&... values) {
+                self.data->report_value(self.index, util::forward<Types>(values)...);
+            }
+
+            template<typename E>
+            friend void tag_invoke(types::Tag<execution::set_error>, Type&& self, E&& error) {
+                self.data->report_error(util::forward<E>(error));
+            }
+
+            friend void tag_invoke(types::Tag<execution::set_stopped>, Type&& self) { self.data->report_stop(); }
+
+            friend auto tag_invoke(types::Tag<execution::get_env>, Type const& self) {
+                return make_env(get_env(self.data->out_r),
+                                with(get_stop_token, self.data->stop_source.get_stop_token()));
+            }
+        };
+    };
+
+    template<typename Data>
+    using Receiver = meta::Type<ReceiverT<Data>>;
+
+    template<typename Send, typename Data>
+    struct SlotT {
+        struct Type : util::Immovable {
+        public:
+            using Rec = Receiver<Data>;
+            using Value = Data::Value;
+
+            explicit Type(Send&& sender, Data* data, usize index)
+                : op_state(execution::connect(util::forward<Send>(sender), Rec { data, index })) {}
+
+            vocab::Optional<Value> value;
+            meta::ConnectResult<Send, Rec> op_state;
+        };
+    };
+
+    template<typename Rec, typename Send, typename Alloc>
+    struct DataT {
+        struct Type {
+        public:
+            using Env = meta::EnvOf<Rec>;
+            using ChildEnv = when_all_range_ns::Env<Env>;
+            using Value = StoredValue<ChildEnv, Send>;
+            using Values = StoredValues<ChildEnv, Send, Alloc>;
+            using Error = when_all_ns::ErrorStorage<ChildEnv, Send>;
+            using Slot = meta::Type<SlotT<Send, Type>>;
+            using StopToken = meta::StopTokenOf<Env>;
+            using StopCallback = StopToken::template CallbackType<when_all_ns::StopCallbackFunction>;
+
+            explicit Type(Rec out_r_, usize count_, [[maybe_unused]] Alloc const& allocator)
+                : out_r(util::move(out_r_)), remaining(count_), count(count_) {
+                if constexpr (!sends_void<ChildEnv, Send>) {
+                    result_values = Values(allocator);
+                }
+            }
+
+            template<typename... Types>
+            void report_value(usize index, Types&&... values) {
+                slots[index].value.emplace(util::forward<Types>(values)...);
+                finish_one();
+            }
+
+            template<typename E>
+            void report_error(E&& error) {
+                auto old = failed.exchange(true, sync::MemoryOrder::AcquireRelease);
+                if (!old) {
+                    stop_source.request_stop();
+                    this->error.template emplace<meta::Decay<E>>(util::forward<E>(error));
+                }
+                finish_one();
+            }
+
+            void report_stop() {
+                auto old = failed.exchange(true, sync::MemoryOrder::AcquireRelease);
+                if (!old) {
+                    stop_source.request_stop();
+                    error.template emplace<when_all_ns::Stopped>();
+                }
+                finish_one();
+            }
+
+            void finish_one() {
+                auto old_value = remaining.fetch_sub(1, sync::MemoryOrder::AcquireRelease);
+                if (old_value == 1) {
+                    complete();
+                }
+            }
+
+            void complete() {
+                stop_callback.reset();
+
+                // This does not need to be atomic because all children have completed, and we used acquire release
+                // ordering when decrementing the count.
+                if (vocab::holds_alternative<when_all_ns::Stopped>(error)) {
+                    execution::set_stopped(util::move(out_r));
+                } else if (!vocab::holds_alternative<when_all_ns::NotError>(error)) {
+                    vocab::visit(
+                        [&]<typename E>(E&& e) {
+                            if constexpr (!concepts::OneOf<meta::RemoveCVRef<E>, when_all_ns::NotError,
+                                                           when_all_ns::Stopped>) {
+                                execution::set_error(util::move(out_r), util::forward<E>(e));
+                            }
+                        },
+                        util::move(error));
+                } else if constexpr (sends_void<ChildEnv, Send>) {
+                    execution::set_value(util::move(out_r));
+                } else {
+                    // The storage for the values was allocated when connecting, so this cannot fail.
+                    for (auto i = 0ZU; i < count; i++) {
+                        util::construct_at(result_values.data() + i, util::move(*slots[i].value));
+                    }
+                    result_values.assume_size(count);
+                    execution::set_value(util::move(out_r), util::move(result_values));
+                }
+            }
+
+            [[no_unique_address]] Error error;
+            [[no_unique_address]] Rec out_r;
+            [[no_unique_address]] Values result_values;
+            sync::InPlaceStopSource stop_source;
+            sync::Atomic<usize> remaining;
+            sync::Atomic<bool> failed { false };
+            vocab::Optional<StopCallback> stop_callback;
+            Slot* slots { nullptr };
+            usize count { 0 };
+        };
+    };
+
+    template<concepts::Receiver Rec, typename Send, concepts::Allocator Alloc>
+    using Data = meta::Type<DataT<Rec, Send, Alloc>>;
+
+    template<typename Rec, typename Send, typename Alloc>
+    struct OperationStateT {
+        struct Type : util::Immovable {
+        public:
+            using Data = when_all_range_ns::Data<Rec, Send, Alloc>;
+            using Slot = Data::Slot;
+
+            template<typename Con>
+            explicit Type(Rec out_r, Con&& senders, Alloc allocator)
+                : m_data(util::move(out_r), container::size(senders), allocator), m_allocator(util::move(allocator)) {
+                if (m_data.count == 0) {
+                    return;
+                }
+
+                // The storage for the resulting values is allocated up front, so that completing cannot fail after
+                // every child operation succeeded.
+                if constexpr (!sends_void<typename Data::ChildEnv, Send>) {
+                    if constexpr (concepts::FallibleAllocator<Alloc>) {
+                        if (!m_data.result_values.reserve_from_nothing(m_data.count)) {
+                            return;
+                        }
+                    } else {
+                        m_data.result_values.reserve_from_nothing(m_data.count);
+                    }
+                }
+
+                // All operation states are stored in a single buffer, which is allocated up front.
+                auto result = vocab::as_fallible(container::allocate_many<Slot>(m_allocator, m_data.count));
+                if (!result) {
+                    return;
+                }
+
+                auto* slots = result->data;
+                auto index = 0ZU;
+                for (auto&& sender : senders) {
+                    util::construct_at(slots + index, static_cast<Send&&>(sender), util::addressof(m_data), index);
+                    index++;
+                }
+                m_data.slots = slots;
+            }
+
+            ~Type() {
+                if (m_data.slots) {
+                    for (auto i = 0ZU; i < m_data.count; i++) {
+                        util::destroy_at(m_data.slots + i);
+                    }
+                    container::deallocate_many<Slot>(m_allocator, m_data.slots, m_data.count);
+                }
+            }
+
+        private:
+            friend void tag_invoke(types::Tag<execution::start>, Type& self) {
+                auto count = self.m_data.count;
+                if (count == 0) {
+                    self.m_data.complete();
+                    return;
+                }
+
+                if constexpr (concepts::FallibleAllocator<Alloc>) {
+                    if (!self.m_data.slots) {
+                        execution::set_error(util::move(self.m_data.out_r), Error(BasicError::NotEnoughMemory));
+                        return;
+                    }
+                }
+
+                // Emplace construct stop callback.
+                self.m_data.stop_callback.emplace(execution::get_stop_token(execution::get_env(self.m_data.out_r)),
+                                                  when_all_ns::StopCallbackFunction { self.m_data.stop_source });
+
+                // Check if stop requested:
+                if (self.m_data.stop_source.stop_requested()) {
+                    self.m_data.stop_callback.reset();
+                    execution::set_stopped(util::move(self.m_data.out_r));
+                    return;
+                }
+
+                // Call start on all operations. Once the last operation is started, this operation state may have
+                // already been destroyed, so only local variables are used to control the loop.
+                auto* slots = self.m_data.slots;
+                for (auto i = 0ZU; i < count; i++) {
+                    execution::start(slots[i].op_state);
+                }
+            }
+
+            [[no_unique_address]] Data m_data;
+            [[no_unique_address]] Alloc m_allocator;
+        };
+    };
+
+    template<concepts::Receiver Rec, typename Send, concepts::Allocator Alloc>
+    using OperationState = meta::Type<OperationStateT<Rec, Send, Alloc>>;
+
+    template<typename Con, typename Alloc>
+    struct SenderT {
+        struct Type {
+        public:
+            using is_sender = void;
+
+            template<typename C, typename A>
+            explicit Type(C&& senders, A&& allocator)
+                : m_senders(util::forward<C>(senders)), m_allocator(util::forward<A>(allocator)) {}
+
+        private:
+            using Send = meta::ContainerValue<Con>;
+
+            template<concepts::RemoveCVRefSameAs<Type> Self, typename E>
+            requires(ValidSender<Env<E>, meta::Like<Self, Send>>)
+            friend auto tag_invoke(types::Tag<execution::get_completion_signatures>, Self&&, E&&)
+                -> Sigs<E, meta::Like<Self, Send>, Alloc> {
+                return {};
+            }
+
+            template<concepts::RemoveCVRefSameAs<Type> Self, concepts::Receiver Rec>
+            requires(concepts::ReceiverOf<Rec, meta::CompletionSignaturesOf<meta::Like<Self, Type>, meta::EnvOf<Rec>>>)
+            friend auto tag_invoke(types::Tag<execution::connect>, Self&& self, Rec out_r) {
+                return OperationState<Rec, meta::Like<Self, Send>, Alloc> {
+                    util::move(out_r), util::forward<Self>(self).m_senders, util::forward<Self>(self).m_allocator
+                };
+            }
+
+            Con m_senders;
+            [[no_unique_address]] Alloc m_allocator;
+        };
+    };
+
+    template<typename Con, typename Alloc>
+    using Sender = meta::Type<SenderT<Con, Alloc>>;
+
+    struct Function {
+        template<concepts::InputContainer Con, concepts::Allocator Alloc = platform::DefaultAllocator>
+        requires(concepts::SizedContainer<Con> && concepts::Sender<meta::ContainerValue<Con>>)
+        auto operator()(Con&& senders, Alloc&& allocator = {}) const -> concepts::Sender auto {
+            if constexpr (concepts::TagInvocable<Function, Con, Alloc>) {
+                return function::tag_invoke(*this, util::forward<Con>(senders), util::forward<Alloc>(allocator));
+            } else {
+                return Sender<meta::RemoveCVRef<Con>, meta::Decay<Alloc>> { util::forward<Con>(senders),
+                                                                           util::forward<Alloc>(allocator) };
+            }
+        }
+    };
+}
+
+/// @brief Wait for a dynamically sized range of senders to complete.
+///
+/// @param senders A sized container of senders, which all have the same type.
+/// @param allocator The allocator to use for the operation states (optional).
+///
+/// @returns A sender which completes when all of the input senders complete.
+///
+/// This is the dynamic equivalent of execution::when_all(). Each input sender must complete with at most a single
+/// value. If the senders complete with `void`, the returned sender does too. Otherwise, the returned sender sends a
+/// vector of the values in the order of the input senders.
+///
+/// The operation states of the input senders are stored in a single buffer allocated using the provided allocator,
+/// which is sized when the returned sender is connected. The vector of values is also allocated using the provided
+/// allocator at that time. If a fallible allocator is used, allocation failure is reported by completing with an error
+/// when the operation is started.
+///
+/// If any sender completes with an error or is stopped, a stop request is sent to all other senders, and the first
+/// error is reported once every sender has completed.
+///
+/// @see when_all
+constexpr inline auto when_all_range = when_all_range_ns::Function {};
+}
@@ -14,4 +14,5 @@
 #include "di/execution/concepts/sender_of.h"
 #include "di/execution/concepts/sender_to.h"
 #include "di/execution/concepts/single_sender.h"
+#include "di/execution/concepts/time_scheduler.h"
 #include "di/execution/concepts/valid_completion_signatures.h"
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "di/execution/concepts/scheduler.h"
+#include "di/execution/interface/now.h"
+#include "di/execution/interface/schedule_after.h"
+#include "di/execution/interface/schedule_at.h"
+
+namespace di::concepts {
+template<typename T>
+concept TimeScheduler = Scheduler<T> && requires(T&& scheduler) {
+    execution::now(scheduler);
+    { execution::schedule_at(util::forward<T>(scheduler), execution::now(scheduler)) } -> Sender;
+    {
+        execution::schedule_after(util::forward<T>(scheduler), execution::now(scheduler) - execution::now(scheduler))
+    } -> Sender;
+};
+}
+
+namespace di {
+using concepts::TimeScheduler;
+}
@@ -0,0 +1,769 @@
+#pragma once
+
+#include "di/assert/assert_bool.h"
+#include "di/container/intrusive/prelude.h"
+#include "di/container/queue/prelude.h"
+#include "di/execution/algorithm/just_from.h"
+#include "di/execution/concepts/receiver_of.h"
+#include "di/execution/interface/connect.h"
+#include "di/execution/interface/get_env.h"
+#include "di/execution/interface/run.h"
+#include "di/execution/interface/schedule.h"
+#include "di/execution/interface/start.h"
+#include "di/execution/io/async_net.h"
+#include "di/execution/io/async_read_some.h"
+#include "di/execution/io/async_write_some.h"
+#include "di/execution/meta/env_of.h"
+#include "di/execution/meta/stop_token_of.h"
+#include "di/execution/query/get_completion_scheduler.h"
+#include "di/execution/query/get_stop_token.h"
+#include "di/execution/receiver/set_error.h"
+#include "di/execution/receiver/set_stopped.h"
+#include "di/execution/receiver/set_value.h"
+#include "di/function/make_deferred.h"
+#include "di/function/tag_invoke.h"
+#include "di/platform/linux_syscall.h"
+#include "di/platform/prelude.h"
+#include "di/sync/atomic.h"
+#include "di/sync/memory_order.h"
+#include "di/sync/synchronized.h"
+#include "di/types/byte.h"
+#include "di/types/integers.h"
+#include "di/util/addressof.h"
+#include "di/util/exchange.h"
+#include "di/util/noncopyable.h"
+#include "di/util/reference_wrapper.h"
+#include "di/vocab/array/array.h"
+#include "di/vocab/error/result.h"
+#include "di/vocab/optional/prelude.h"
+#include "di/vocab/span/prelude.h"
+#include "di/vocab/tuple/prelude.h"
+
+#ifdef __linux__
+namespace di::execution {
+class EpollFile;
+class EpollSocket;
+
+/// @brief A socket address, stored in the kernel's struct sockaddr layout.
+struct SocketAddress {
+    /// @brief An IPv4 address, with the address and port in host byte order.
+    static auto ipv4(u32 address, u16 port) -> SocketAddress {
+        auto result = SocketAddress {};
+        result.length = 16;
+        result.storage[0] = byte(platform::linux_syscall::address_family_ipv4);
+        result.storage[2] = byte(port >> 8);
+        result.storage[3] = byte(port);
+        for (auto i = 0U; i < 4; i++) {
+            result.storage[4 + i] = byte(address >> (24 - 8 * i));
+        }
+        return result;
+    }
+
+    /// @brief A unix domain socket address. A path starting with a null byte names a socket in the abstract namespace.
+    static auto unix_domain(Span<char const> path) -> Optional<SocketAddress> {
+        auto result = SocketAddress {};
+        if (path.size() + 3 > result.storage.size()) {
+            return nullopt;
+        }
+        result.storage[0] = byte(platform::linux_syscall::address_family_unix);
+        for (auto i = 0ZU; i < path.size(); i++) {
+            result.storage[2 + i] = byte(path[i]);
+        }
+
+        // Abstract names are not null terminated, so their length is determined by the address length alone.
+        auto const abstract = !path.empty() && path[0] == '\0';
+        result.length = u32(2 + path.size() + (abstract ? 0 : 1));
+        return result;
+    }
+
+    Array<byte, 128> storage {};
+    u32 length { 0 };
+};
+
+/// @brief A single threaded event loop for non-blocking file descriptors, built on edge-triggered epoll.
+///
+/// Operations first attempt their system call directly, and only wait for the event loop once the kernel reports
+/// that the file descriptor is not ready. Each file keeps a list of operations waiting to read and to write, which are
+/// moved onto the run queue when epoll reports the file as readable or writable. Files are registered with epoll the
+/// first time an operation has to wait on them, so files which never block never pay for it.
+///
+/// Operations waiting on a file are completed with stopped if their stop token is triggered, or if the context is
+/// finished.
+///
+/// @note Files must be destroyed on the thread running the context, or while it is not running.
+///
+/// @see EpollFile
+/// @see EpollSocket
+class EpollContext {
+private:
+    friend class EpollFile;
+    friend class EpollSocket;
+
+    struct OperationStateBase : IntrusiveForwardListNode<> {
+    public:
+        explicit OperationStateBase(EpollContext* parent_) : parent(parent_) {}
+
+        virtual void execute() = 0;
+
+        EpollContext* parent { nullptr };
+    };
+
+    struct WaiterTag : container::IntrusiveListTag<WaiterTag> {};
+
+    struct IoOperationBase;
+
+    using WaiterList = container::IntrusiveList<IoOperationBase, WaiterTag>;
+
+    // The fields of waiting operations are protected by the context's lock.
+    struct IoOperationBase
+        : OperationStateBase
+        , IntrusiveListNode<WaiterTag> {
+    public:
+        using OperationStateBase::OperationStateBase;
+
+        WaiterList* waiting_in { nullptr };
+        bool cancelled { false };
+    };
+
+    enum class Direction { Read, Write };
+
+    // The part of a file shared with the event loop. The waiter lists and registration are protected by the context's
+    // lock.
+    struct FileState : IntrusiveListNode<> {
+        int fd { -1 };
+        bool registered { false };
+        bool not_a_socket { false };
+        WaiterList readers;
+        WaiterList writers;
+
+        // Bumped whenever epoll reports a direction as ready, so that an operation which found the file not ready can
+        // tell whether it raced with the event before it started waiting.
+        sync::Atomic<u64> read_generation { 0 };
+        sync::Atomic<u64> write_generation { 0 };
+
+        auto generation(Direction direction) -> sync::Atomic<u64>& {
+            return direction == Direction::Read ? read_generation : write_generation;
+        }
+
+        auto waiters(Direction direction) -> WaiterList& { return direction == Direction::Read ? readers : writers; }
+    };
+
+    // Results of attempting an operation are system call results: a count, or a negated errno value. Only
+    // error_try_again makes the operation wait.
+    template<typename Op, typename Receiver>
+    struct IoOperationStateT {
+        struct Type : IoOperationBase {
+        private:
+            struct CancelFunction {
+                Type* operation;
+
+                void operator()() const noexcept { operation->parent->cancel(*operation); }
+            };
+
+        public:
+            using StopCallback = meta::StopTokenOf<meta::EnvOf<Receiver>>::template CallbackType<CancelFunction>;
+
+            Type(EpollContext* parent, FileState* file, Op op, Receiver&& receiver)
+                : IoOperationBase(parent), m_file(file), m_op(util::move(op)), m_receiver(util::move(receiver)) {}
+
+            void execute() override { attempt(); }
+
+        private:
+            void attempt() {
+                namespace linux_syscall = platform::linux_syscall;
+
+                for (;;) {
+                    auto const generation = m_file->generation(Op::direction).load(sync::MemoryOrder::Acquire);
+                    auto result = m_op.try_once(*m_file);
+                    if (result == -linux_syscall::error_interrupted) {
+                        continue;
+                    }
+                    if (result == -linux_syscall::error_try_again) {
+                        result = this->parent->wait(*this, *m_file, Op::direction, generation);
+                        if (result == 0) {
+                            return;
+                        }
+                        if (result == -linux_syscall::error_try_again) {
+                            continue;
+                        }
+                    }
+                    return complete(result);
+                }
+            }
+
+            void complete(long result) {
+                m_stop_callback.reset();
+                if (result == -platform::linux_syscall::error_cancelled) {
+                    set_stopped(util::move(m_receiver));
+                } else if (platform::linux_syscall::is_error(result)) {
+                    set_error(util::move(m_receiver), error_from(result));
+                } else {
+                    m_op.complete(util::move(m_receiver), result);
+                }
+            }
+
+            friend void tag_invoke(types::Tag<start>, Type& self) {
+                self.m_stop_callback.emplace(get_stop_token(get_env(self.m_receiver)), CancelFunction { &self });
+                self.attempt();
+            }
+
+            FileState* m_file;
+            Op m_op;
+            [[no_unique_address]] Receiver m_receiver;
+            Optional<StopCallback> m_stop_callback;
+        };
+    };
+
+    template<typename Op, typename Receiver>
+    using IoOperationState = meta::Type<IoOperationStateT<Op, Receiver>>;
+
+    template<typename Op>
+    struct IoSender {
+        using is_sender = void;
+
+        using CompletionSignatures = Op::CompletionSignatures;
+
+        EpollContext* parent;
+        FileState* file;
+        Op op;
+
+    private:
+        template<concepts::ReceiverOf<CompletionSignatures> Receiver>
+        friend auto tag_invoke(types::Tag<connect>, IoSender self, Receiver receiver) {
+            return IoOperationState<Op, Receiver> { self.parent, self.file, util::move(self.op),
+                                                    util::move(receiver) };
+        }
+    };
+
+    struct ReadOp {
+        using CompletionSignatures = types::CompletionSignatures<SetValue(usize), SetError(Error), SetStopped()>;
+
+        constexpr static auto direction = Direction::Read;
+
+        Span<byte> buffer;
+
+        auto try_once(FileState& file) const -> long {
+            return platform::linux_syscall::read(file.fd, buffer.data(), buffer.size());
+        }
+
+        template<typename Receiver>
+        static void complete(Receiver&& receiver, long result) {
+            set_value(util::move(receiver), usize(result));
+        }
+    };
+
+    struct WriteOp {
+        using CompletionSignatures = types::CompletionSignatures<SetValue(usize), SetError(Error), SetStopped()>;
+
+        constexpr static auto direction = Direction::Write;
+
+        Span<byte const> buffer;
+
+        // Sockets are written with send(), so that a peer which has gone away is reported as an error instead of
+        // raising SIGPIPE. Other files fall back to write().
+        auto try_once(FileState& file) const -> long {
+            if (!file.not_a_socket) {
+                auto result = platform::linux_syscall::send(file.fd, buffer.data(), buffer.size());
+                if (result != -platform::linux_syscall::error_not_socket) {
+                    return result;
+                }
+                file.not_a_socket = true;
+            }
+            return platform::linux_syscall::write(file.fd, buffer.data(), buffer.size());
+        }
+
+        template<typename Receiver>
+        static void complete(Receiver&& receiver, long result) {
+            set_value(util::move(receiver), usize(result));
+        }
+    };
+
+    struct ConnectOp {
+        using CompletionSignatures = types::CompletionSignatures<SetValue(), SetError(Error), SetStopped()>;
+
+        constexpr static auto direction = Direction::Write;
+
+        SocketAddress address;
+        bool in_progress { false };
+
+        // A non-blocking connect() finishes in the background, and the socket becomes writable once it does. Calling
+        // connect() again then reports how it went.
+        auto try_once(FileState& file) -> long {
+            namespace linux_syscall = platform::linux_syscall;
+
+            auto result = linux_syscall::connect(file.fd, address.storage.data(), address.length);
+            if (result == -linux_syscall::error_in_progress || result == -linux_syscall::error_already) {
+                in_progress = true;
+                return -linux_syscall::error_try_again;
+            }
+            if (in_progress && result == -linux_syscall::error_is_connected) {
+                return 0;
+            }
+            return result;
+        }
+
+        template<typename Receiver>
+        static void complete(Receiver&& receiver, long) {
+            set_value(util::move(receiver));
+        }
+    };
+
+    struct State {
+        Queue<OperationStateBase, IntrusiveForwardList<OperationStateBase>> queue;
+        IntrusiveList<FileState> files;
+        bool sleeping { false };
+        bool stopped { false };
+    };
+
+    template<typename Receiver>
+    struct ScheduleOperationStateT {
+        struct Type : OperationStateBase {
+        public:
+            Type(EpollContext* parent, Receiver&& receiver)
+                : OperationStateBase(parent), m_receiver(util::move(receiver)) {}
+
+            void execute() override {
+                if (get_stop_token(get_env(m_receiver)).stop_requested()) {
+                    set_stopped(util::move(m_receiver));
+                } else {
+                    set_value(util::move(m_receiver));
+                }
+            }
+
+        private:
+            friend void tag_invoke(types::Tag<start>, Type& self) { self.parent->push_back(self); }
+
+            [[no_unique_address]] Receiver m_receiver;
+        };
+    };
+
+    template<typename Receiver>
+    using ScheduleOperationState = meta::Type<ScheduleOperationStateT<Receiver>>;
+
+    struct Scheduler {
+    private:
+        struct Env {
+            EpollContext* parent;
+
+            template<typename CPO>
+            constexpr friend auto tag_invoke(GetCompletionScheduler<CPO>, Env const& self) {
+                return Scheduler { self.parent };
+            }
+        };
+
+        struct Sender {
+            using is_sender = void;
+
+            using CompletionSignatures = types::CompletionSignatures<SetValue(), SetStopped()>;
+
+            EpollContext* parent;
+
+        private:
+            template<concepts::ReceiverOf<CompletionSignatures> Receiver>
+            friend auto tag_invoke(types::Tag<connect>, Sender self, Receiver receiver) {
+                return ScheduleOperationState<Receiver> { self.parent, util::move(receiver) };
+            }
+
+            constexpr friend auto tag_invoke(types::Tag<get_env>, Sender const& self) { return Env { self.parent }; }
+        };
+
+    public:
+        EpollContext* parent { nullptr };
+
+    private:
+        friend auto tag_invoke(types::Tag<schedule>, Scheduler const& self) { return Sender { self.parent }; }
+
+        friend auto tag_invoke(types::Tag<async_make_socket>, Scheduler const& self, int domain, int type,
+                               int protocol = 0) {
+            return make_deferred<EpollSocket>(self.parent, domain, type, protocol);
+        }
+
+        constexpr friend auto operator==(Scheduler const&, Scheduler const&) -> bool = default;
+    };
+
+public:
+    static auto create() -> Result<EpollContext> {
+        namespace linux_syscall = platform::linux_syscall;
+
+        auto epoll_fd = linux_syscall::epoll_create();
+        if (linux_syscall::is_error(epoll_fd)) {
+            return Unexpected(error_from(epoll_fd));
+        }
+        auto context = EpollContext(int(epoll_fd));
+
+        auto wake_fd = linux_syscall::eventfd(0);
+        if (linux_syscall::is_error(wake_fd)) {
+            return Unexpected(error_from(wake_fd));
+        }
+        context.m_wake_fd = int(wake_fd);
+
+        // The wake up eventfd is the only registration whose data is not a FileState.
+        auto event = linux_syscall::EpollEvent { linux_syscall::epoll_in | linux_syscall::epoll_edge_triggered, 0 };
+        auto result = linux_syscall::epoll_add(context.m_epoll_fd, context.m_wake_fd, event);
+        if (linux_syscall::is_error(result)) {
+            return Unexpected(error_from(result));
+        }
+        return context;
+    }
+
+    /// @note A context can only be moved before it is used.
+    EpollContext(EpollContext&& other)
+        : m_epoll_fd(util::exchange(other.m_epoll_fd, -1)), m_wake_fd(util::exchange(other.m_wake_fd, -1)) {}
+
+    ~EpollContext() {
+        if (m_wake_fd >= 0) {
+            platform::linux_syscall::close(m_wake_fd);
+        }
+        if (m_epoll_fd >= 0) {
+            platform::linux_syscall::close(m_epoll_fd);
+        }
+    }
+
+    auto get_scheduler() -> Scheduler { return Scheduler { this }; }
+
+    /// @brief Run operations until finish() is called and every started operation has completed.
+    void run() {
+        auto events = Array<platform::linux_syscall::EpollEvent, max_events_per_poll> {};
+        auto executed = 0U;
+        for (;;) {
+            auto [operation, is_stopped] = m_state.with_lock([](State& state) -> Tuple<OperationStateBase*, bool> {
+                if (state.stopped) {
+                    cancel_waiters(state);
+                }
+                if (!state.queue.empty()) {
+                    return make_tuple(util::addressof(*state.queue.pop()), false);
+                }
+                if (state.stopped) {
+                    return make_tuple(nullptr, true);
+                }
+                state.sleeping = true;
+                return make_tuple(nullptr, false);
+            });
+
+            if (is_stopped) {
+                return;
+            }
+            if (!operation) {
+                executed = 0;
+                poll(events.span(), -1);
+                continue;
+            }
+
+            operation->execute();
+
+            // Check for events periodically while the queue is busy, so that a loop which is never idle does not
+            // starve operations waiting on their files.
+            if (++executed >= max_operations_between_polls) {
+                executed = 0;
+                poll(events.span(), 0);
+            }
+        }
+    }
+
+    /// @brief Make run() return once the queue is empty. Operations still waiting on a file complete with stopped.
+    void finish() {
+        auto should_wake = m_state.with_lock([](State& state) {
+            state.stopped = true;
+            return util::exchange(state.sleeping, false);
+        });
+        if (should_wake) {
+            wake();
+        }
+    }
+
+private:
+    constexpr static auto max_events_per_poll = 64ZU;
+    constexpr static auto max_operations_between_polls = 64U;
+
+    explicit EpollContext(int epoll_fd) : m_epoll_fd(epoll_fd) {}
+
+    // There is no errno error domain, so errors without a generic equivalent are reported as invalid arguments.
+    static auto error_from(long result) -> Error {
+        if (-result == platform::linux_syscall::error_no_memory) {
+            return Error(BasicError::NotEnoughMemory);
+        }
+        if (-result == platform::linux_syscall::error_cancelled) {
+            return Error(BasicError::OperationCanceled);
+        }
+        return Error(BasicError::InvalidArgument);
+    }
+
+    static void cancel_waiters(State& state) {
+        auto cancel_all = [&](WaiterList& waiters) {
+            while (auto operation = waiters.pop_front()) {
+                operation->waiting_in = nullptr;
+                operation->cancelled = true;
+                state.queue.push(*operation);
+            }
+        };
+        for (auto& file : state.files) {
+            cancel_all(file.readers);
+            cancel_all(file.writers);
+        }
+    }
+
+    void wake() {
+        auto const value = u64(1);
+        platform::linux_syscall::write(m_wake_fd, reinterpret_cast<byte const*>(&value), sizeof(value));
+    }
+
+    void push_back(OperationStateBase& operation) {
+        auto should_wake = m_state.with_lock([&](State& state) {
+            state.queue.push(operation);
+            return util::exchange(state.sleeping, false);
+        });
+        if (should_wake) {
+            wake();
+        }
+    }
+
+    // Returns 0 once the operation is waiting, -error_try_again if the file became ready in the meantime, or a negated
+    // errno value to complete the operation with.
+    auto wait(IoOperationBase& operation, FileState& file, Direction direction, u64 generation) -> long {
+        namespace linux_syscall = platform::linux_syscall;
+
+        return m_state.with_lock([&](State& state) -> long {
+            if (operation.cancelled || state.stopped) {
+                return -linux_syscall::error_cancelled;
+            }
+            if (file.generation(direction).load(sync::MemoryOrder::Relaxed) != generation) {
+                return -linux_syscall::error_try_again;
+            }
+
+            // NOTE: epoll reports the current readiness when a file is registered, so a file which became ready just
+            //       before this is not missed.
+            if (!file.registered) {
+                auto const events = linux_syscall::epoll_in | linux_syscall::epoll_out |
+                                    linux_syscall::epoll_read_hang_up | linux_syscall::epoll_edge_triggered;
+                auto result = linux_syscall::epoll_add(m_epoll_fd, file.fd, { events, reinterpret_cast<u64>(&file) });
+                if (linux_syscall::is_error(result)) {
+                    return result;
+                }
+                file.registered = true;
+                state.files.push_back(file);
+            }
+
+            auto& waiters = file.waiters(direction);
+            waiters.push_back(operation);
+            operation.waiting_in = &waiters;
+            return 0;
+        });
+    }
+
+    void cancel(IoOperationBase& operation) {
+        auto should_wake = m_state.with_lock([&](State& state) {
+            operation.cancelled = true;
+
+            // If the operation is not waiting, it is either running or already on the queue, and sees the flag the
+            // next time it would wait.
+            if (!operation.waiting_in) {
+                return false;
+            }
+            operation.waiting_in->erase(operation);
+            operation.waiting_in = nullptr;
+            state.queue.push(operation);
+            return util::exchange(state.sleeping, false);
+        });
+        if (should_wake) {
+            wake();
+        }
+    }
+
+    void poll(Span<platform::linux_syscall::EpollEvent> events, int timeout) {
+        namespace linux_syscall = platform::linux_syscall;
+
+        auto count = linux_syscall::epoll_wait(m_epoll_fd, events.data(), int(events.size()), timeout);
+        if (linux_syscall::is_error(count)) {
+            count = 0;
+        }
+
+        auto woken = false;
+        m_state.with_lock([&](State& state) {
+            state.sleeping = false;
+            for (auto const& event : Span { events.data(), usize(count) }) {
+                if (event.data == 0) {
+                    woken = true;
+                    continue;
+                }
+
+                auto& file = *reinterpret_cast<FileState*>(event.data);
+                auto const failed = (event.events & (linux_syscall::epoll_error | linux_syscall::epoll_hang_up)) != 0;
+                if (failed || (event.events & (linux_syscall::epoll_in | linux_syscall::epoll_read_hang_up)) != 0) {
+                    did_become_ready(state, file, Direction::Read);
+                }
+                if (failed || (event.events & linux_syscall::epoll_out) != 0) {
+                    did_become_ready(state, file, Direction::Write);
+                }
+            }
+        });
+
+        // The eventfd is edge-triggered, so it only needs to be drained to keep its counter from overflowing.
+        if (woken) {
+            auto value = u64(0);
+            linux_syscall::read(m_wake_fd, reinterpret_cast<byte*>(&value), sizeof(value));
+        }
+    }
+
+    static void did_become_ready(State& state, FileState& file, Direction direction) {
+        file.generation(direction).fetch_add(1, sync::MemoryOrder::Release);
+
+        auto& waiters = file.waiters(direction);
+        while (auto operation = waiters.pop_front()) {
+            operation->waiting_in = nullptr;
+            state.queue.push(*operation);
+        }
+    }
+
+    void forget(FileState& file) {
+        auto was_registered = m_state.with_lock([&](State& state) {
+            DI_ASSERT(file.readers.empty() && file.writers.empty());
+            if (!file.registered) {
+                return false;
+            }
+            state.files.erase(file);
+            file.registered = false;
+            return true;
+        });
+        if (was_registered) {
+            platform::linux_syscall::epoll_delete(m_epoll_fd, file.fd);
+        }
+    }
+
+    int m_epoll_fd { -1 };
+    int m_wake_fd { -1 };
+    sync::Synchronized<State> m_state;
+};
+
+/// @brief A non-blocking file descriptor whose reads and writes are driven by an EpollContext.
+///
+/// The file descriptor is owned by the EpollFile, and is made non-blocking when it is adopted.
+///
+/// @note A file can only be moved while no operation is using it.
+class EpollFile : util::NonCopyable {
+public:
+    explicit EpollFile(EpollContext& context, int fd) : m_context(util::addressof(context)) {
+        platform::linux_syscall::set_nonblocking(fd);
+        m_state.fd = fd;
+    }
+
+    // The context refers to the file's state by address, so the moved from file stops being registered, and the new
+    // one is registered the next time an operation has to wait.
+    EpollFile(EpollFile&& other) : m_context(other.m_context) {
+        other.m_context->forget(other.m_state);
+        m_state.fd = util::exchange(other.m_state.fd, -1);
+        m_state.not_a_socket = other.m_state.not_a_socket;
+    }
+
+    ~EpollFile() {
+        if (m_state.fd >= 0) {
+            m_context->forget(m_state);
+            platform::linux_syscall::close(m_state.fd);
+        }
+    }
+
+    auto fd() const -> int { return m_state.fd; }
+
+protected:
+    explicit EpollFile(EpollContext* context) : m_context(context) {}
+
+    auto context() const -> EpollContext* { return m_context; }
+    auto state() -> EpollContext::FileState* { return util::addressof(m_state); }
+
+    // File descriptors created by the context are already non-blocking.
+    void adopt(int fd) { m_state.fd = fd; }
+
+private:
+    friend auto tag_invoke(types::Tag<async_read_some>, EpollFile& self, Span<byte> buffer, Optional<u64>) {
+        return EpollContext::IoSender<EpollContext::ReadOp> { self.m_context, self.state(), { buffer } };
+    }
+
+    friend auto tag_invoke(types::Tag<async_write_some>, EpollFile& self, Span<byte const> buffer, Optional<u64>) {
+        return EpollContext::IoSender<EpollContext::WriteOp> { self.m_context, self.state(), { buffer } };
+    }
+
+    EpollContext* m_context;
+    EpollContext::FileState m_state;
+};
+
+/// @brief A socket driven by an EpollContext, created by async_make_socket() or async_accept().
+///
+/// The socket is an async resource: it is created (or accepted) when it is run.
+class EpollSocket : public EpollFile {
+private:
+    // Creating a socket never waits, while accepting one waits on the listening socket.
+    struct OpenOp {
+        using CompletionSignatures = types::CompletionSignatures<SetValue(util::ReferenceWrapper<EpollSocket>),
+                                                                 SetError(Error), SetStopped()>;
+
+        constexpr static auto direction = EpollContext::Direction::Read;
+
+        EpollSocket* socket;
+
+        auto try_once(EpollContext::FileState& file) const -> long {
+            if (socket->m_listener) {
+                return platform::linux_syscall::accept(file.fd);
+            }
+            return platform::linux_syscall::socket(socket->m_domain, socket->m_type, socket->m_protocol);
+        }
+
+        template<typename Receiver>
+        void complete(Receiver&& receiver, long result) const {
+            socket->adopt(int(result));
+            set_value(util::move(receiver), util::ref(*socket));
+        }
+    };
+
+public:
+    explicit EpollSocket(EpollContext* context, int domain, int type, int protocol)
+        : EpollFile(context), m_domain(domain), m_type(type), m_protocol(protocol) {}
+
+    explicit EpollSocket(EpollSocket* listener) : EpollFile(listener->context()), m_listener(listener) {}
+
+private:
+    friend auto tag_invoke(types::Tag<run>, EpollSocket& self) {
+        auto* file = self.m_listener ? self.m_listener->state() : self.state();
+        return EpollContext::IoSender<OpenOp> { self.context(), file, { util::addressof(self) } };
+    }
+
+    friend auto tag_invoke(types::Tag<async_bind>, EpollSocket& self, SocketAddress const& address) {
+        return just_from([&self, address] -> Result<> {
+            auto result = platform::linux_syscall::bind(self.fd(), address.storage.data(), address.length);
+            if (platform::linux_syscall::is_error(result)) {
+                return Unexpected(EpollContext::error_from(result));
+            }
+            return {};
+        });
+    }
+
+    friend auto tag_invoke(types::Tag<async_listen>, EpollSocket& self, int backlog) {
+        return just_from([&self, backlog] -> Result<> {
+            auto result = platform::linux_syscall::listen(self.fd(), backlog);
+            if (platform::linux_syscall::is_error(result)) {
+                return Unexpected(EpollContext::error_from(result));
+            }
+            return {};
+        });
+    }
+
+    friend auto tag_invoke(types::Tag<async_connect>, EpollSocket& self, SocketAddress const& address) {
+        return EpollContext::IoSender<EpollContext::ConnectOp> { self.context(), self.state(), { address } };
+    }
+
+    friend auto tag_invoke(types::Tag<async_accept>, EpollSocket& self) {
+        return make_deferred<EpollSocket>(util::addressof(self));
+    }
+
+    EpollSocket* m_listener { nullptr };
+    int m_domain { 0 };
+    int m_type { 0 };
+    int m_protocol { 0 };
+};
+}
+
+namespace di {
+using execution::EpollContext;
+using execution::EpollFile;
+using execution::EpollSocket;
+using execution::SocketAddress;
+}
+#endif
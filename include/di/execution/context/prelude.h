@@ -2,3 +2,5 @@
 
 #include "di/execution/context/inline_scheduler.h"
 #include "di/execution/context/run_loop.h"
+#include "di/execution/context/timing_wheel.h"
+#include "di/execution/context/trampoline_scheduler.h"
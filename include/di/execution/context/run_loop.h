@@ -1,18 +1,28 @@
 #pragma once
 
+#include "di/chrono/clock/steady_clock.h"
+#include "di/chrono/duration/duration_cast.h"
+#include "di/chrono/duration/duration_literals.h"
 #include "di/container/intrusive/prelude.h"
 #include "di/container/queue/prelude.h"
 #include "di/execution/concepts/receiver.h"
 #include "di/execution/concepts/receiver_of.h"
+#include "di/execution/context/timing_wheel.h"
 #include "di/execution/interface/connect.h"
 #include "di/execution/interface/get_env.h"
+#include "di/execution/interface/now.h"
+#include "di/execution/interface/schedule_at.h"
 #include "di/execution/interface/start.h"
+#include "di/execution/meta/env_of.h"
+#include "di/execution/meta/stop_token_of.h"
 #include "di/execution/query/get_completion_scheduler.h"
+#include "di/execution/query/get_stop_token.h"
 #include "di/function/tag_invoke.h"
 #include "di/platform/prelude.h"
 #include "di/sync/dumb_spinlock.h"
 #include "di/sync/synchronized.h"
 #include "di/util/immovable.h"
+#include "di/vocab/optional/prelude.h"
 
 namespace di::execution {
 template<concepts::Lock Lock = DefaultLock>
@@ -27,6 +37,16 @@ private:
         RunLoop* parent { nullptr };
     };
 
+    struct TimerOperationStateBase
+        : OperationStateBase
+        , TimingWheelNode {
+    public:
+        TimerOperationStateBase(RunLoop* parent_, u64 deadline)
+            : OperationStateBase(parent_), TimingWheelNode(deadline) {}
+
+        bool cancelled { false };
+    };
+
     template<typename Receiver>
     struct OperationStateT {
         struct Type : OperationStateBase {
@@ -34,7 +54,7 @@ private:
             Type(RunLoop* parent, Receiver&& receiver) : OperationStateBase(parent), m_receiver(util::move(receiver)) {}
 
             void execute() override {
-                if (get_stop_token(m_receiver).stop_requested()) {
+                if (get_stop_token(get_env(m_receiver)).stop_requested()) {
                     set_stopped(util::move(m_receiver));
                 } else {
                     set_value(util::move(m_receiver));
@@ -53,8 +73,57 @@ private:
     template<typename Receiver>
     using OperationState = meta::Type<OperationStateT<Receiver>>;
 
+    struct CancelTimerFunction {
+        TimerOperationStateBase* operation;
+
+        void operator()() const noexcept { operation->parent->cancel_timer(operation); }
+    };
+
+    template<typename Receiver>
+    struct TimerOperationStateT {
+        struct Type : TimerOperationStateBase {
+        public:
+            using StopCallback = meta::StopTokenOf<meta::EnvOf<Receiver>>::template CallbackType<CancelTimerFunction>;
+
+            Type(RunLoop* parent, u64 deadline, Receiver&& receiver)
+                : TimerOperationStateBase(parent, deadline), m_receiver(util::move(receiver)) {}
+
+            void execute() override {
+                m_stop_callback.reset();
+                if (this->cancelled || get_stop_token(get_env(m_receiver)).stop_requested()) {
+                    set_stopped(util::move(m_receiver));
+                } else {
+                    set_value(util::move(m_receiver));
+                }
+            }
+
+        private:
+            void do_start() {
+                m_stop_callback.emplace(get_stop_token(get_env(m_receiver)), CancelTimerFunction { this });
+                this->parent->insert_timer(this);
+            }
+
+            friend void tag_invoke(types::Tag<start>, Type& self) { self.do_start(); }
+
+            [[no_unique_address]] Receiver m_receiver;
+            Optional<StopCallback> m_stop_callback;
+        };
+    };
+
+    template<typename Receiver>
+    using TimerOperationState = meta::Type<TimerOperationStateT<Receiver>>;
+
     struct Scheduler {
     private:
+        struct Env {
+            RunLoop* parent;
+
+            template<typename CPO>
+            constexpr friend auto tag_invoke(GetCompletionScheduler<CPO>, Env const& self) {
+                return Scheduler { self.parent };
+            }
+        };
+
         struct Sender {
             using is_sender = void;
 
@@ -68,16 +137,26 @@ private:
                 return OperationState<Receiver> { self.parent, util::move(receiver) };
             }
 
-            struct Env {
-                RunLoop* parent;
+            constexpr friend auto tag_invoke(types::Tag<get_env>, Sender const& self) { return Env { self.parent }; }
+        };
 
-                template<typename CPO>
-                constexpr friend auto tag_invoke(GetCompletionScheduler<CPO>, Env const& self) {
-                    return Scheduler { self.parent };
-                }
-            };
+        struct TimerSender {
+            using is_sender = void;
 
-            constexpr friend auto tag_invoke(types::Tag<get_env>, Sender const& self) { return Env { self.parent }; }
+            using CompletionSignatures = types::CompletionSignatures<SetValue(), SetStopped()>;
+
+            RunLoop* parent;
+            u64 deadline;
+
+        private:
+            template<concepts::ReceiverOf<CompletionSignatures> Receiver>
+            friend auto tag_invoke(types::Tag<connect>, TimerSender self, Receiver receiver) {
+                return TimerOperationState<Receiver> { self.parent, self.deadline, util::move(receiver) };
+            }
+
+            constexpr friend auto tag_invoke(types::Tag<get_env>, TimerSender const& self) {
+                return Env { self.parent };
+            }
         };
 
     public:
@@ -86,11 +165,22 @@ private:
     private:
         friend auto tag_invoke(types::Tag<schedule>, Scheduler const& self) { return Sender { self.parent }; }
 
+        friend auto tag_invoke(types::Tag<now>, Scheduler const&) { return chrono::SteadyClock::now(); }
+
+        template<typename Duration>
+        friend auto tag_invoke(types::Tag<schedule_at>, Scheduler const& self,
+                               chrono::TimePoint<chrono::SteadyClock, Duration> const& deadline) {
+            return TimerSender { self.parent, to_tick(deadline) };
+        }
+
         constexpr friend auto operator==(Scheduler const&, Scheduler const&) -> bool = default;
     };
 
     struct State {
         Queue<OperationStateBase, IntrusiveForwardList<OperationStateBase>> queue;
+        TimingWheel<TimerOperationStateBase> timers;
+        auto (*read_clock)() -> u64 { nullptr };
+        u32 pops_since_advance { 0 };
         bool stopped { false };
     };
 
@@ -113,10 +203,45 @@ public:
     }
 
 private:
+    // The number of operations run between checks for expired timers, when the queue never becomes empty.
+    constexpr static auto max_pops_between_advances = 64U;
+
+    // Timers are tracked with millisecond resolution. Deadlines are rounded up, so that timers never fire early.
+    template<typename Duration>
+    constexpr static auto to_tick(chrono::TimePoint<chrono::SteadyClock, Duration> const& time_point) -> u64 {
+        auto since_epoch = time_point.time_since_epoch();
+        auto milliseconds = chrono::duration_cast<chrono::Milliseconds>(since_epoch);
+        if (milliseconds < since_epoch) {
+            ++milliseconds;
+        }
+        return milliseconds.count() < 0 ? 0 : u64(milliseconds.count());
+    }
+
+    static auto current_tick() -> u64 {
+        auto milliseconds = chrono::duration_cast<chrono::Milliseconds>(chrono::SteadyClock::now().time_since_epoch());
+        return milliseconds.count() < 0 ? 0 : u64(milliseconds.count());
+    }
+
     auto pop_front() -> OperationStateBase* {
         // FIXME: block instead of busy polling the queue when it is empty.
         for (;;) {
             auto [operation, is_stopped] = m_state.with_lock([](State& state) -> Tuple<OperationStateBase*, bool> {
+                if (state.stopped) {
+                    // Pending timers will not expire while the loop is stopping, so complete them with stopped now.
+                    state.timers.drain([&](TimerOperationStateBase& timer) {
+                        timer.cancelled = true;
+                        state.queue.push(timer);
+                    });
+                } else if (!state.timers.empty() &&
+                           (state.queue.empty() || ++state.pops_since_advance >= max_pops_between_advances)) {
+                    // Move any expired timers onto the queue. This is also done periodically while the queue is busy,
+                    // so that a loop which is never idle does not starve its timers.
+                    state.pops_since_advance = 0;
+                    state.timers.advance(state.read_clock(), [&](TimerOperationStateBase& timer) {
+                        state.queue.push(timer);
+                    });
+                }
+
                 // NOTE: even if a stop is requested, we must continue first empty the queue
                 //       before returning stopping execution. Otherwise, the receiver contract
                 //       will be violated (operation state will be destroyed without completion
@@ -124,7 +249,7 @@ private:
                 if (!state.queue.empty()) {
                     return make_tuple(util::addressof(*state.queue.pop()), false);
                 }
-                if (state.stopped) {
+                if (state.stopped && state.timers.empty()) {
                     return make_tuple(nullptr, true);
                 }
                 return make_tuple(nullptr, false);
@@ -133,7 +258,9 @@ private:
             if (is_stopped) {
                 return nullptr;
             }
-            return operation;
+            if (operation) {
+                return operation;
+            }
         }
     }
 
@@ -143,6 +270,39 @@ private:
         });
     }
 
+    void insert_timer(TimerOperationStateBase* operation) {
+        m_state.with_lock([&](State& state) {
+            // If the timer was cancelled before it could be inserted, or the loop is stopping, complete it immediately.
+            if (state.stopped) {
+                operation->cancelled = true;
+            }
+            if (operation->cancelled) {
+                state.queue.push(*operation);
+                return;
+            }
+
+            // NOTE: the clock is only read once a timer has been scheduled, so that run loops which are never used
+            //       for timed scheduling do not require a clock source.
+            if (state.timers.empty()) {
+                state.read_clock = &current_tick;
+                state.timers.reset(current_tick());
+            }
+            state.timers.insert(*operation);
+        });
+    }
+
+    void cancel_timer(TimerOperationStateBase* operation) {
+        m_state.with_lock([&](State& state) {
+            // If the timer already expired, it is already on the queue and there is nothing to do.
+            if (operation->linked()) {
+                state.timers.erase(*operation);
+                state.queue.push(*operation);
+            } else {
+                operation->cancelled = true;
+            }
+        });
+    }
+
     sync::Synchronized<State, Lock> m_state;
 };
 }
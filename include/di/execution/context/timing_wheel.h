@@ -0,0 +1,297 @@
+#pragma once
+
+#include "di/assert/assert_bool.h"
+#include "di/bit/operation/bit_width.h"
+#include "di/bit/operation/countr_zero.h"
+#include "di/container/intrusive/list.h"
+#include "di/function/invoke.h"
+#include "di/math/numeric_limits.h"
+#include "di/meta/core.h"
+#include "di/meta/operations.h"
+#include "di/types/integers.h"
+#include "di/util/move.h"
+#include "di/vocab/array/array.h"
+
+namespace di::execution {
+struct TimingWheelTag : container::IntrusiveListTag<TimingWheelTag> {};
+
+/// @brief Intrusive node for a timer stored in a TimingWheel.
+///
+/// Timers store their deadline as an abstract tick count, which is interpreted by the owner of the timing wheel. The
+/// node is immovable, and must outlive its membership in the timing wheel.
+class TimingWheelNode : public container::IntrusiveListNode<TimingWheelTag> {
+public:
+    TimingWheelNode() = default;
+
+    constexpr explicit TimingWheelNode(u64 deadline) : m_deadline(deadline) {}
+
+    constexpr auto deadline() const -> u64 { return m_deadline; }
+    constexpr void set_deadline(u64 deadline) {
+        DI_ASSERT(!m_linked);
+        m_deadline = deadline;
+    }
+
+    constexpr auto linked() const -> bool { return m_linked; }
+
+private:
+    template<typename, usize, usize>
+    friend class TimingWheel;
+
+    u64 m_deadline { 0 };
+    u16 m_level { 0 };
+    u16 m_slot { 0 };
+    bool m_linked { false };
+};
+
+/// @brief A hierarchical timing wheel.
+///
+/// @tparam T The timer type, which must inherit from TimingWheelNode.
+/// @tparam level_bits The number of bits of the deadline resolved by each level of the wheel.
+/// @tparam level_count The number of levels in the wheel.
+///
+/// A timing wheel is a priority queue specialized for timers, which supports O(1) insertion and cancellation. Each
+/// level of the wheel has `2^level_bits` slots, and level `n` has a resolution of `2^(level_bits * n)` ticks. Timers
+/// are placed in the level determined by the highest bit in which their deadline differs from the current tick, and are
+/// cascaded into lower levels as time advances. Timers whose deadline is too far in the future to be represented by
+/// the wheel are kept in a separate overflow list, which is re-examined each time the top level wraps around.
+///
+/// Each level keeps a bitmap of occupied slots, which allows advancing the wheel across large periods of idle time
+/// without visiting every intermediate tick.
+///
+/// This type is not thread-safe, and provides no notion of time on its own. Execution contexts embed a timing wheel and
+/// drive it using their clock of choice.
+template<typename T, usize level_bits = 6, usize level_count = 4>
+class TimingWheel {
+private:
+    static_assert(concepts::DerivedFrom<T, TimingWheelNode>, "Timers must inherit from di::TimingWheelNode.");
+    static_assert(level_bits > 0 && level_bits <= 6, "The slot bitmap of each level must fit in a u64.");
+    static_assert(level_count > 0);
+
+    using List = container::IntrusiveList<T, TimingWheelTag>;
+
+    constexpr static usize slot_count = usize(1) << level_bits;
+    constexpr static u64 slot_mask = slot_count - 1;
+    constexpr static usize total_bits = level_bits * level_count;
+    constexpr static bool has_overflow = total_bits < 64;
+    constexpr static u16 overflow_level = level_count;
+
+public:
+    constexpr explicit TimingWheel(u64 current_tick = 0) : m_current_tick(current_tick) {}
+
+    TimingWheel(TimingWheel const&) = delete;
+    auto operator=(TimingWheel const&) -> TimingWheel& = delete;
+
+    constexpr auto empty() const -> bool { return m_size == 0; }
+    constexpr auto size() const -> usize { return m_size; }
+
+    constexpr auto current_tick() const -> u64 { return m_current_tick; }
+
+    /// @brief Reset the current tick of an empty timing wheel.
+    ///
+    /// This allows the owner to avoid advancing through a long period of time in which no timers were present.
+    constexpr void reset(u64 current_tick) {
+        DI_ASSERT(empty());
+        m_current_tick = current_tick;
+    }
+
+    /// @brief Insert a timer into the wheel.
+    ///
+    /// Timers whose deadline has already passed will be expired by the next call to advance().
+    constexpr void insert(T& timer) {
+        DI_ASSERT(!node(timer).m_linked);
+        place(timer);
+        ++m_size;
+    }
+
+    /// @brief Remove a timer which has not yet expired from the wheel.
+    constexpr void erase(T& timer) {
+        auto& n = node(timer);
+        DI_ASSERT(n.m_linked);
+        auto& list = list_for(n.m_level, n.m_slot);
+        list.erase(timer);
+        if (list.empty() && n.m_level != overflow_level) {
+            m_occupied[n.m_level] &= ~(u64(1) << n.m_slot);
+        }
+        n.m_linked = false;
+        --m_size;
+    }
+
+    /// @brief Advance the wheel to the specified tick, expiring all timers whose deadline is at or before it.
+    ///
+    /// @param tick The new current tick, which must not be before the current tick.
+    /// @param on_expired A function called with each expired timer, which has already been removed from the wheel.
+    ///
+    /// @warning The expiry function must not modify the timing wheel.
+    template<concepts::Invocable<T&> Fun>
+    constexpr void advance(u64 tick, Fun&& on_expired) {
+        DI_ASSERT(tick >= m_current_tick);
+        for (;;) {
+            expire_current(on_expired);
+            if (m_current_tick >= tick) {
+                return;
+            }
+
+            // Jump directly to the next tick at which some timer either expires or must be cascaded.
+            auto next = next_event_tick();
+            if (next > tick) {
+                m_current_tick = tick;
+                return;
+            }
+            m_current_tick = next;
+            cascade();
+        }
+    }
+
+    /// @brief Remove every timer from the wheel, regardless of its deadline.
+    ///
+    /// @param on_removed A function called with each timer, which has already been removed from the wheel.
+    ///
+    /// This is used by execution contexts which stop before all of their timers expire. Timers are not removed in order
+    /// of their deadline.
+    ///
+    /// @warning The removal function must not modify the timing wheel.
+    template<concepts::Invocable<T&> Fun>
+    constexpr void drain(Fun&& on_removed) {
+        for (auto level = 0ZU; level < level_count; ++level) {
+            while (m_occupied[level] != 0) {
+                auto slot = u16(bit::countr_zero(m_occupied[level]));
+                m_occupied[level] &= ~(u64(1) << slot);
+                remove_all(m_slots[level][slot], on_removed);
+            }
+        }
+        remove_all(m_overflow, on_removed);
+    }
+
+    /// @brief Get a lower bound on the next tick at which a timer will expire.
+    ///
+    /// This can be used by an execution context to determine how long it can block while waiting for timers.
+    constexpr auto next_expiry_tick() const -> u64 {
+        if (m_occupied[0] & (u64(1) << (m_current_tick & slot_mask))) {
+            return m_current_tick;
+        }
+        return next_event_tick();
+    }
+
+private:
+    constexpr static auto node(T& timer) -> TimingWheelNode& { return static_cast<TimingWheelNode&>(timer); }
+
+    constexpr auto list_for(u16 level, u16 slot) -> List& {
+        if (level == overflow_level) {
+            return m_overflow;
+        }
+        return m_slots[level][slot];
+    }
+
+    constexpr void place(T& timer) {
+        auto& n = node(timer);
+        n.m_linked = true;
+
+        // Timers which are already due go in the current slot of the lowest level.
+        auto deadline = n.m_deadline > m_current_tick ? n.m_deadline : m_current_tick;
+
+        // The level is determined by the highest bit which differs from the current tick.
+        auto difference = deadline ^ m_current_tick;
+        auto level = difference == 0 ? 0ZU : usize(bit::bit_width(difference) - 1) / level_bits;
+        if (level >= level_count) {
+            n.m_level = overflow_level;
+            n.m_slot = 0;
+            m_overflow.push_back(timer);
+            return;
+        }
+
+        auto slot = (deadline >> (level * level_bits)) & slot_mask;
+        n.m_level = u16(level);
+        n.m_slot = u16(slot);
+        m_slots[level][slot].push_back(timer);
+        m_occupied[level] |= u64(1) << slot;
+    }
+
+    template<typename Fun>
+    constexpr void expire_current(Fun& on_expired) {
+        auto slot = m_current_tick & slot_mask;
+        if (!(m_occupied[0] & (u64(1) << slot))) {
+            return;
+        }
+
+        // Detach the slot before invoking any callbacks, so that the wheel is in a consistent state.
+        m_occupied[0] &= ~(u64(1) << slot);
+        remove_all(m_slots[0][slot], on_expired);
+    }
+
+    template<typename Fun>
+    constexpr void remove_all(List& list, Fun& on_removed) {
+        auto timers = util::move(list);
+        while (auto timer = timers.pop_front()) {
+            node(*timer).m_linked = false;
+            --m_size;
+            function::invoke(on_removed, *timer);
+        }
+    }
+
+    // Re-place every timer stored in a slot which the current tick has just entered.
+    constexpr void cascade() {
+        for (auto level = 1ZU; level < level_count; ++level) {
+            auto shift = level * level_bits;
+            if ((m_current_tick & ((u64(1) << shift) - 1)) != 0) {
+                return;
+            }
+
+            auto slot = (m_current_tick >> shift) & slot_mask;
+            if (m_occupied[level] & (u64(1) << slot)) {
+                m_occupied[level] &= ~(u64(1) << slot);
+                replace_all(m_slots[level][slot]);
+            }
+        }
+
+        if constexpr (has_overflow) {
+            if ((m_current_tick & ((u64(1) << total_bits) - 1)) == 0) {
+                replace_all(m_overflow);
+            }
+        }
+    }
+
+    constexpr void replace_all(List& list) {
+        auto timers = util::move(list);
+        while (auto timer = timers.pop_front()) {
+            place(*timer);
+        }
+    }
+
+    // Find the smallest tick after the current one which has a timer expiring or cascading. Since any slot in a lower
+    // level is reached before any slot in a higher level, the first level with an occupied slot determines the result.
+    constexpr auto next_event_tick() const -> u64 {
+        for (auto level = 0ZU; level < level_count; ++level) {
+            auto shift = level * level_bits;
+            auto digit = (m_current_tick >> shift) & slot_mask;
+            auto later =
+                digit == slot_mask ? u64(0) : m_occupied[level] & (math::NumericLimits<u64>::max << (digit + 1));
+            if (later == 0) {
+                continue;
+            }
+
+            auto slot = u64(bit::countr_zero(later));
+            auto upper_shift = shift + level_bits;
+            auto base = upper_shift >= 64 ? u64(0) : (m_current_tick >> upper_shift) << upper_shift;
+            return base | (slot << shift);
+        }
+
+        if constexpr (has_overflow) {
+            if (!m_overflow.empty()) {
+                return ((m_current_tick >> total_bits) + 1) << total_bits;
+            }
+        }
+        return math::NumericLimits<u64>::max;
+    }
+
+    vocab::Array<vocab::Array<List, slot_count>, level_count> m_slots;
+    vocab::Array<u64, level_count> m_occupied {};
+    List m_overflow;
+    u64 m_current_tick { 0 };
+    usize m_size { 0 };
+};
+}
+
+namespace di {
+using execution::TimingWheel;
+using execution::TimingWheelNode;
+}
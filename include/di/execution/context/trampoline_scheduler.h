@@ -0,0 +1,146 @@
+#pragma once
+
+#include "di/container/intrusive/forward_list.h"
+#include "di/container/queue/queue.h"
+#include "di/execution/concepts/operation_state.h"
+#include "di/execution/concepts/receiver.h"
+#include "di/execution/concepts/scheduler.h"
+#include "di/execution/interface/connect.h"
+#include "di/execution/interface/get_env.h"
+#include "di/execution/interface/start.h"
+#include "di/execution/query/get_completion_scheduler.h"
+#include "di/execution/query/get_stop_token.h"
+#include "di/execution/types/prelude.h"
+#include "di/function/tag_invoke.h"
+#include "di/types/integers.h"
+#include "di/util/immovable.h"
+
+namespace di::execution {
+/// @brief A scheduler which completes inline, but bounds the depth of recursive scheduling.
+///
+/// Scheduling onto an InlineScheduler from within a completion grows the stack without bound, which is a problem for
+/// algorithms which repeatedly reschedule themselves. The trampoline scheduler completes inline until the current
+/// thread has nested `max_recursion_depth` completions, at which point further work is queued and executed by the
+/// outermost call to start() once the stack has unwound.
+///
+/// @note This uses a thread local variable to track the trampoline of the current thread.
+class TrampolineScheduler {
+private:
+    struct OperationStateBase : IntrusiveForwardListNode<> {
+    public:
+        explicit OperationStateBase(usize max_recursion_depth_) : max_recursion_depth(max_recursion_depth_) {}
+
+        virtual void execute() = 0;
+
+        usize max_recursion_depth;
+    };
+
+    struct Trampoline {
+        Queue<OperationStateBase, IntrusiveForwardList<OperationStateBase>> pending;
+        usize depth { 0 };
+    };
+
+    static auto current_trampoline() -> Trampoline*& {
+        thread_local Trampoline* trampoline = nullptr;
+        return trampoline;
+    }
+
+    static void run(OperationStateBase& operation) {
+        auto*& current = current_trampoline();
+        if (!current) {
+            auto trampoline = Trampoline {};
+            current = &trampoline;
+
+            trampoline.depth = 1;
+            operation.execute();
+            while (auto next = trampoline.pending.pop()) {
+                trampoline.depth = 1;
+                next->execute();
+            }
+
+            current = nullptr;
+            return;
+        }
+
+        if (current->depth >= operation.max_recursion_depth) {
+            current->pending.push(operation);
+            return;
+        }
+
+        auto* trampoline = current;
+        ++trampoline->depth;
+        operation.execute();
+        --trampoline->depth;
+    }
+
+    template<typename Rec>
+    struct OperationStateT {
+        struct Type
+            : OperationStateBase
+            , util::Immovable {
+        public:
+            explicit Type(usize max_recursion_depth, Rec receiver)
+                : OperationStateBase(max_recursion_depth), m_receiver(util::move(receiver)) {}
+
+            void execute() override {
+                if (get_stop_token(get_env(m_receiver)).stop_requested()) {
+                    set_stopped(util::move(m_receiver));
+                } else {
+                    set_value(util::move(m_receiver));
+                }
+            }
+
+        private:
+            friend void tag_invoke(types::Tag<start>, Type& self) { run(self); }
+
+            [[no_unique_address]] Rec m_receiver;
+        };
+    };
+
+    template<concepts::Receiver Rec>
+    using OperationState = meta::Type<OperationStateT<Rec>>;
+
+    struct Sender {
+        using is_sender = void;
+
+        using CompletionSignatures = types::CompletionSignatures<SetValue(), SetStopped()>;
+
+        usize max_recursion_depth;
+
+    private:
+        template<concepts::ReceiverOf<CompletionSignatures> Rec>
+        friend auto tag_invoke(types::Tag<connect>, Sender self, Rec receiver) {
+            return OperationState<Rec> { self.max_recursion_depth, util::move(receiver) };
+        }
+
+        struct Env {
+            usize max_recursion_depth;
+
+            template<typename CPO>
+            friend auto tag_invoke(GetCompletionScheduler<CPO>, Env const& self) {
+                return TrampolineScheduler { self.max_recursion_depth };
+            }
+        };
+
+        friend auto tag_invoke(types::Tag<get_env>, Sender const& self) { return Env { self.max_recursion_depth }; }
+    };
+
+public:
+    constexpr static usize default_max_recursion_depth = 16;
+
+    constexpr explicit TrampolineScheduler(usize max_recursion_depth = default_max_recursion_depth)
+        : m_max_recursion_depth(max_recursion_depth) {}
+
+private:
+    friend auto operator==(TrampolineScheduler const&, TrampolineScheduler const&) -> bool = default;
+    friend auto tag_invoke(types::Tag<schedule>, TrampolineScheduler const& self) {
+        return Sender { self.m_max_recursion_depth };
+    }
+
+    usize m_max_recursion_depth { default_max_recursion_depth };
+};
+}
+
+namespace di {
+using execution::TrampolineScheduler;
+}
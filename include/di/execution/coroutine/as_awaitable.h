@@ -7,9 +7,43 @@
 #include "di/execution/meta/env_of.h"
 #include "di/execution/meta/single_sender_value_type.h"
 #include "di/meta/core.h"
+#include "di/sync/atomic.h"
+#include "di/sync/memory_order.h"
+#include "di/util/coroutine.h"
+#include "di/vocab/error/error.h"
+#include "di/vocab/optional/prelude.h"
 
 namespace di::execution {
 namespace as_awaitable_ns {
+    template<typename Result, typename Promise>
+    struct AwaitableData {
+        // Both the receiver and the awaiting coroutine's await_suspend() race to set this flag, and whichever side does
+        // so second is responsible for resuming the coroutine. When the sender completes inline, this is always
+        // await_suspend(), which resumes the coroutine via symmetric transfer. This keeps the stack depth constant when
+        // awaiting many synchronously completing senders in a loop.
+        auto complete() -> CoroutineHandle<> {
+            if (handoff.exchange(true, sync::MemoryOrder::AcquireRelease)) {
+                return next();
+            }
+            return noop_coroutine();
+        }
+
+        auto next() -> CoroutineHandle<> {
+            if (result.has_value()) {
+                return continuation;
+            }
+            if (error.has_value()) {
+                return continuation.promise().unhandled_error(util::move(error).value());
+            }
+            return continuation.promise().unhandled_stopped();
+        }
+
+        Optional<Result> result {};
+        Optional<Error> error {};
+        CoroutineHandle<Promise> continuation;
+        sync::Atomic<bool> handoff { false };
+    };
+
     template<typename Send, typename Promise>
     struct AwaitableReceiver<Send, Promise>::Type {
         using is_receiver = void;
@@ -17,27 +51,25 @@ namespace as_awaitable_ns {
         using Value = meta::SingleSenderValueType<Send, meta::EnvOf<Promise>>;
         using Result = meta::Conditional<concepts::LanguageVoid<Value>, Void, Value>;
 
-        Optional<Result>* result_pointer;
-        CoroutineHandle<Promise> continuation;
+        AwaitableData<Result, Promise>* data;
 
     private:
         template<typename... Args>
         requires(concepts::ConstructibleFrom<Result, Args...>)
         friend void tag_invoke(SetValue, Type&& self, Args&&... args) {
-            self.result_pointer->emplace(util::forward<Args>(args)...);
-            self.continuation.resume();
+            self.data->result.emplace(util::forward<Args>(args)...);
+            self.data->complete().resume();
         }
 
         friend void tag_invoke(SetError, Type&& self, Error error) {
-            static_cast<CoroutineHandle<>>(self.continuation.promise().unhandled_error(util::move(error))).resume();
+            self.data->error.emplace(util::move(error));
+            self.data->complete().resume();
         }
 
-        friend void tag_invoke(SetStopped, Type&& self) {
-            static_cast<CoroutineHandle<>>(self.continuation.promise().unhandled_stopped()).resume();
-        }
+        friend void tag_invoke(SetStopped, Type&& self) { self.data->complete().resume(); }
 
         constexpr friend auto tag_invoke(types::Tag<get_env> tag, Type const& self) -> decltype(auto) {
-            return tag(self.continuation.promise());
+            return tag(self.data->continuation.promise());
         }
     };
 
@@ -51,20 +83,22 @@ namespace as_awaitable_ns {
 
         public:
             explicit Type(Send&& sender, Promise& promise)
-                : m_state(connect(
-                      util::forward<Send>(sender),
-                      Receiver { util::addressof(m_result), CoroutineHandle<Promise>::from_promise(promise) })) {}
+                : m_data { .continuation = CoroutineHandle<Promise>::from_promise(promise) }
+                , m_state(connect(util::forward<Send>(sender), Receiver { util::addressof(m_data) })) {}
 
             auto await_ready() const noexcept -> bool { return false; }
-            void await_suspend(CoroutineHandle<>) noexcept { start(m_state); }
+            auto await_suspend(CoroutineHandle<>) noexcept -> CoroutineHandle<> {
+                start(m_state);
+                return m_data.complete();
+            }
             auto await_resume() -> Value {
                 if constexpr (!concepts::LanguageVoid<Value>) {
-                    return util::move(m_result).value();
+                    return util::move(m_data.result).value();
                 }
             }
 
         private:
-            Optional<Result> m_result {};
+            AwaitableData<Result, Promise> m_data;
             meta::ConnectResult<Send, Receiver> m_state;
         };
     };
@@ -0,0 +1,220 @@
+#pragma once
+
+#include "di/bit/operation/bit_width.h"
+#include "di/container/allocator/allocate.h"
+#include "di/container/allocator/allocator.h"
+#include "di/container/allocator/deallocate.h"
+#include "di/math/align_up.h"
+#include "di/meta/operations.h"
+#include "di/types/allocator_arg.h"
+#include "di/types/byte.h"
+#include "di/types/integers.h"
+#include "di/util/construct_at.h"
+#include "di/util/destroy_at.h"
+#include "di/util/move.h"
+#include "di/util/std_new.h"
+#include "di/vocab/array/array.h"
+#include "di/vocab/expected/as_fallible.h"
+
+namespace di::execution {
+namespace frame_allocator_ns {
+    constexpr inline usize frame_alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    // Every coroutine frame is followed by a trailer which records how to free it. Since the compiler passes the same
+    // size to operator delete as it did to operator new, the trailer can be located without any other bookkeeping.
+    using DeallocateFrame = void (*)(void* frame, usize size);
+
+    constexpr auto trailer_offset(usize size) -> usize {
+        return math::align_up(size, alignof(DeallocateFrame));
+    }
+
+    constexpr auto default_frame_size(usize size) -> usize {
+        return trailer_offset(size) + sizeof(DeallocateFrame);
+    }
+
+    template<typename Alloc>
+    constexpr auto allocator_offset(usize size) -> usize {
+        return math::align_up(default_frame_size(size), alignof(Alloc));
+    }
+
+    template<typename Alloc>
+    constexpr auto allocator_frame_size(usize size) -> usize {
+        return allocator_offset<Alloc>(size) + sizeof(Alloc);
+    }
+
+    template<typename T>
+    auto at_offset(void* frame, usize offset) -> T* {
+        return static_cast<T*>(static_cast<void*>(static_cast<byte*>(frame) + offset));
+    }
+
+    inline auto trailer(void* frame, usize size) -> DeallocateFrame& {
+        return *at_offset<DeallocateFrame>(frame, trailer_offset(size));
+    }
+
+#if !defined(DI_NO_USE_STD) && !defined(DI_NO_COROUTINE_FRAME_CACHE)
+    // A per-thread cache of recently freed coroutine frames, bucketed by power of 2 size classes. This makes the common
+    // case of repeatedly calling the same coroutine (for instance, once per request) avoid the global allocator.
+    class FrameCache {
+    private:
+        constexpr static usize min_class_size = 128;
+        constexpr static usize class_count = 4;
+        constexpr static usize max_cached_per_class = 16;
+
+        struct FreeFrame {
+            FreeFrame* next;
+        };
+
+    public:
+        static auto allocate(usize size) -> void* {
+            auto index = class_index(size);
+            if (index >= class_count) {
+                return ::operator new(size, std::nothrow);
+            }
+            if (!s_destroyed) {
+                auto& cache = get();
+                if (auto* frame = cache.m_free_lists[index]) {
+                    cache.m_free_lists[index] = frame->next;
+                    --cache.m_counts[index];
+                    return static_cast<void*>(frame);
+                }
+            }
+            return ::operator new(class_size(index), std::nothrow);
+        }
+
+        static void deallocate(void* pointer, usize size) {
+            auto index = class_index(size);
+            if (index >= class_count) {
+                ::operator delete(pointer, size);
+                return;
+            }
+            if (s_destroyed || get().m_counts[index] == max_cached_per_class) {
+                ::operator delete(pointer, class_size(index));
+                return;
+            }
+            auto& cache = get();
+            cache.m_free_lists[index] = util::construct_at(static_cast<FreeFrame*>(pointer), cache.m_free_lists[index]);
+            ++cache.m_counts[index];
+        }
+
+        FrameCache() = default;
+
+        FrameCache(FrameCache const&) = delete;
+        auto operator=(FrameCache const&) -> FrameCache& = delete;
+
+        ~FrameCache() {
+            s_destroyed = true;
+            for (auto index = 0ZU; index < class_count; ++index) {
+                while (auto* frame = m_free_lists[index]) {
+                    m_free_lists[index] = frame->next;
+                    ::operator delete(static_cast<void*>(frame), class_size(index));
+                }
+            }
+        }
+
+    private:
+        constexpr static auto class_index(usize size) -> usize {
+            if (size <= min_class_size) {
+                return 0;
+            }
+            return usize(bit::bit_width(size - 1)) - usize(bit::bit_width(min_class_size - 1));
+        }
+
+        constexpr static auto class_size(usize index) -> usize { return min_class_size << index; }
+
+        static auto get() -> FrameCache& {
+            thread_local auto cache = FrameCache {};
+            return cache;
+        }
+
+        // Frames can still be allocated or freed after the cache was destroyed at thread exit, for instance by the
+        // destructor of another thread local object. Since this flag is trivially destructible, it remains valid, and
+        // such frames bypass the cache.
+        constinit static inline thread_local bool s_destroyed = false;
+
+        vocab::Array<FreeFrame*, class_count> m_free_lists {};
+        vocab::Array<usize, class_count> m_counts {};
+    };
+
+    inline auto allocate_frame(usize size) noexcept -> void* {
+        auto* frame = FrameCache::allocate(default_frame_size(size));
+        if (!frame) {
+            return nullptr;
+        }
+        trailer(frame, size) = [](void* pointer, usize frame_size) {
+            FrameCache::deallocate(pointer, default_frame_size(frame_size));
+        };
+        return frame;
+    }
+#else
+    inline auto allocate_frame(usize size) noexcept -> void* {
+        auto* frame = ::operator new(default_frame_size(size), std::nothrow);
+        if (!frame) {
+            return nullptr;
+        }
+        trailer(frame, size) = [](void* pointer, usize frame_size) {
+            ::operator delete(pointer, default_frame_size(frame_size));
+        };
+        return frame;
+    }
+#endif
+
+    template<typename Alloc>
+    void deallocate_frame_with_allocator(void* frame, usize size) {
+        auto* stored = at_offset<Alloc>(frame, allocator_offset<Alloc>(size));
+        auto allocator = util::move(*stored);
+        util::destroy_at(stored);
+        di::deallocate(allocator, frame, allocator_frame_size<Alloc>(size), frame_alignment);
+    }
+
+    template<typename Alloc>
+    auto allocate_frame(Alloc const& allocator, usize size) noexcept -> void* {
+        static_assert(alignof(Alloc) <= frame_alignment, "Coroutine frame allocators must not be over-aligned.");
+
+        auto copy = allocator;
+        auto result = vocab::as_fallible(di::allocate(copy, allocator_frame_size<Alloc>(size), frame_alignment));
+        if (!result) {
+            return nullptr;
+        }
+
+        auto* frame = result->data;
+        trailer(frame, size) = &deallocate_frame_with_allocator<Alloc>;
+        util::construct_at(at_offset<Alloc>(frame, allocator_offset<Alloc>(size)), util::move(copy));
+        return frame;
+    }
+}
+
+/// @brief Base class for coroutine promise types which customizes frame allocation.
+///
+/// By default, coroutine frames are allocated from a small per-thread cache of recently freed frames, which avoids
+/// calling the global allocator when the same coroutines are invoked repeatedly. To use a specific allocator instead,
+/// pass di::allocator_arg followed by the allocator as the first parameters of the coroutine (after the implicit
+/// object parameter, for member functions). The allocator is copied into the coroutine frame, so that it can be used to
+/// free the frame later.
+///
+/// Allocation failure is reported by returning nullptr, so promise types using this must provide a
+/// `get_return_object_on_allocation_failure()` function.
+///
+/// @note The per-thread cache is disabled when DI_NO_USE_STD or DI_NO_COROUTINE_FRAME_CACHE is defined.
+struct WithFrameAllocator {
+    auto operator new(usize size) noexcept -> void* { return frame_allocator_ns::allocate_frame(size); }
+
+    template<concepts::Allocator Alloc, typename... Args>
+    auto operator new(usize size, AllocatorArg, Alloc const& allocator, Args const&...) noexcept -> void* {
+        return frame_allocator_ns::allocate_frame(allocator, size);
+    }
+
+    template<typename This, concepts::Allocator Alloc, typename... Args>
+    auto operator new(usize size, This const&, AllocatorArg, Alloc const& allocator, Args const&...) noexcept
+        -> void* {
+        return frame_allocator_ns::allocate_frame(allocator, size);
+    }
+
+    void operator delete(void* pointer, usize size) noexcept {
+        frame_allocator_ns::trailer(pointer, size)(pointer, size);
+    }
+};
+}
+
+namespace di {
+using execution::WithFrameAllocator;
+}
@@ -4,6 +4,7 @@
 #include "di/execution/algorithm/just.h"
 #include "di/execution/algorithm/just_or_error.h"
 #include "di/execution/coroutine/as_awaitable.h"
+#include "di/execution/coroutine/frame_allocator.h"
 #include "di/execution/coroutine/with_await_transform.h"
 #include "di/execution/coroutine/with_awaitable_senders.h"
 #include "di/execution/types/prelude.h"
@@ -31,13 +32,12 @@ namespace lazy_ns {
     struct AllocFailed {};
 
     template<typename Self, typename T>
-    class PromiseBase : public WithAwaitableSenders<Self> {
+    class PromiseBase
+        : public WithAwaitableSenders<Self>
+        , public WithFrameAllocator {
     public:
         PromiseBase() = default;
 
-        auto operator new(usize size) noexcept -> void* { return ::operator new(size, std::nothrow); }
-        void operator delete(void* ptr, usize size) noexcept { ::operator delete(ptr, size); }
-
         auto initial_suspend() noexcept -> SuspendAlways { return {}; }
         auto final_suspend() noexcept { return FinalAwaiter {}; }
 
@@ -1,5 +1,6 @@
 #pragma once
 
 #include "di/execution/coroutine/as_awaitable.h"
+#include "di/execution/coroutine/frame_allocator.h"
 #include "di/execution/coroutine/lazy.h"
 #include "di/execution/coroutine/with_awaitable_senders.h"
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "di/function/tag_invoke.h"
+#include "di/util/forward.h"
+
+namespace di::execution {
+namespace detail {
+    struct NowFunction {
+        template<typename Scheduler>
+        requires(concepts::TagInvocable<NowFunction, Scheduler const&>)
+        constexpr auto operator()(Scheduler const& scheduler) const {
+            return function::tag_invoke(*this, scheduler);
+        }
+    };
+}
+
+/// @brief Get the current time, as seen by a scheduler.
+///
+/// @param scheduler The scheduler to query.
+///
+/// @return A time point of the scheduler's clock.
+///
+/// Time schedulers customize this function to report the current time of the clock which is used by
+/// execution::schedule_at() and execution::schedule_after().
+///
+/// @see schedule_at
+/// @see schedule_after
+constexpr inline auto now = detail::NowFunction {};
+}
@@ -1,5 +1,8 @@
 #pragma once
 
 #include "di/execution/interface/connect.h"
+#include "di/execution/interface/now.h"
 #include "di/execution/interface/schedule.h"
+#include "di/execution/interface/schedule_after.h"
+#include "di/execution/interface/schedule_at.h"
 #include "di/execution/interface/start.h"
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "di/execution/concepts/sender.h"
+#include "di/execution/interface/now.h"
+#include "di/execution/interface/schedule_at.h"
+#include "di/function/tag_invoke.h"
+#include "di/util/forward.h"
+
+namespace di::execution {
+namespace detail {
+    struct ScheduleAfterFunction {
+        template<typename Scheduler, typename Duration>
+        requires(concepts::TagInvocable<ScheduleAfterFunction, Scheduler, Duration const&> ||
+                 requires(Scheduler&& scheduler, Duration const& delay) {
+                     schedule_at(util::forward<Scheduler>(scheduler), now(scheduler) + delay);
+                 })
+        constexpr auto operator()(Scheduler&& scheduler, Duration const& delay) const -> concepts::Sender auto {
+            if constexpr (concepts::TagInvocable<ScheduleAfterFunction, Scheduler, Duration const&>) {
+                return function::tag_invoke(*this, util::forward<Scheduler>(scheduler), delay);
+            } else {
+                auto deadline = now(scheduler) + delay;
+                return schedule_at(util::forward<Scheduler>(scheduler), deadline);
+            }
+        }
+    };
+}
+
+/// @brief Schedule work to run on a scheduler after a delay.
+///
+/// @param scheduler The scheduler to schedule work on.
+/// @param delay A duration to wait, relative to the current time of the scheduler.
+///
+/// @return A sender which completes on the scheduler once the delay has elapsed.
+///
+/// By default, this is implemented in terms of execution::now() and execution::schedule_at().
+///
+/// @see now
+/// @see schedule_at
+constexpr inline auto schedule_after = detail::ScheduleAfterFunction {};
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "di/execution/concepts/sender.h"
+#include "di/function/tag_invoke.h"
+#include "di/util/forward.h"
+
+namespace di::execution {
+namespace detail {
+    struct ScheduleAtFunction {
+        template<typename Scheduler, typename TimePoint>
+        requires(concepts::TagInvocable<ScheduleAtFunction, Scheduler, TimePoint const&>)
+        constexpr auto operator()(Scheduler&& scheduler, TimePoint const& deadline) const -> concepts::Sender auto {
+            return function::tag_invoke(*this, util::forward<Scheduler>(scheduler), deadline);
+        }
+    };
+}
+
+/// @brief Schedule work to run on a scheduler once a deadline has been reached.
+///
+/// @param scheduler The scheduler to schedule work on.
+/// @param deadline A time point of the scheduler's clock.
+///
+/// @return A sender which completes on the scheduler no earlier than the deadline.
+///
+/// The returned sender completes with set_stopped() if a stop is requested before the deadline is reached. Time
+/// schedulers must implement this operation without allocating, so that timeouts are cheap enough to be used on every
+/// request.
+///
+/// @see now
+/// @see schedule_after
+constexpr inline auto schedule_at = detail::ScheduleAtFunction {};
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "di/execution/io/async_read_some.h"
+#include "di/execution/sequence/async_generator.h"
+#include "di/serialization/json_event_reader.h"
+#include "di/util/move.h"
+#include "di/vocab/error/prelude.h"
+
+namespace di::execution {
+namespace async_json_events_ns {
+    struct Function {
+        template<concepts::AsyncReadable File>
+        auto operator()(File& file) const -> AsyncGenerator<serialization::json::Event> {
+            auto parser = serialization::detail::JsonEventParser {};
+            auto buffer = serialization::detail::JsonEventBuffer {};
+            auto at_end = false;
+            for (;;) {
+                auto event = parser.next(buffer.input(), at_end);
+                if (!event) {
+                    co_return vocab::Unexpected(util::move(event).error());
+                }
+                buffer.advance(parser.consumed());
+                if (*event) {
+                    co_yield **event;
+                    continue;
+                }
+                if (at_end) {
+                    co_return {};
+                }
+
+                auto space = buffer.prepare();
+                if (!space) {
+                    co_return vocab::Unexpected(BasicError::NotEnoughMemory);
+                }
+                auto nread = co_await async_read_some(file, *space);
+                buffer.commit(nread);
+                at_end = nread == 0;
+            }
+        }
+    };
+}
+
+/// @brief Produce a sequence of JSON events from an asynchronous reader.
+///
+/// @param file The reader to read from, which must outlive the sequence.
+///
+/// @return A lockstep sequence of json::Event values.
+///
+/// This is the asynchronous counterpart of JsonEventReader, and is suitable for scanning large inputs from a file or
+/// socket without blocking. Since the input is read incrementally, long strings are delivered as a series of
+/// json::StringChunk events. Strings in each event refer to the sequence's internal buffer, and so are only valid until
+/// the next event is requested.
+///
+/// @see JsonEventReader
+constexpr inline auto async_json_events = async_json_events_ns::Function {};
+}
+
+namespace di {
+using execution::async_json_events;
+}
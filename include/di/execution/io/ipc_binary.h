@@ -1,6 +1,9 @@
 #pragma once
 
+#include "di/assert/assert_bool.h"
 #include "di/bit/endian/little_endian.h"
+#include "di/container/algorithm/copy.h"
+#include "di/container/algorithm/max.h"
 #include "di/container/allocator/allocator.h"
 #include "di/container/intrusive/list.h"
 #include "di/container/intrusive/list_node.h"
@@ -10,6 +13,7 @@
 #include "di/execution/algorithm/let.h"
 #include "di/execution/algorithm/let_value_with.h"
 #include "di/execution/algorithm/read.h"
+#include "di/execution/algorithm/then.h"
 #include "di/execution/algorithm/when_all.h"
 #include "di/execution/algorithm/with_env.h"
 #include "di/execution/concepts/single_sender.h"
@@ -21,6 +25,8 @@
 #include "di/execution/io/async_write_exactly.h"
 #include "di/execution/io/async_write_some.h"
 #include "di/execution/io/ipc_protocol.h"
+#include "di/execution/meta/env_of.h"
+#include "di/execution/meta/stop_token_of.h"
 #include "di/execution/query/get_allocator.h"
 #include "di/execution/query/get_sequence_cardinality.h"
 #include "di/execution/query/get_stop_token.h"
@@ -42,7 +48,8 @@
 #include "di/function/make_deferred.h"
 #include "di/function/monad/monad_try.h"
 #include "di/function/tag_invoke.h"
-#include "di/io/vector_reader.h"
+#include "di/io/span_reader.h"
+#include "di/io/unchecked_span_writer.h"
 #include "di/io/vector_writer.h"
 #include "di/io/write_exactly.h"
 #include "di/math/intcmp/representable_as.h"
@@ -66,14 +73,18 @@
 #include "di/util/addressof.h"
 #include "di/util/bit_cast.h"
 #include "di/util/defer_construct.h"
+#include "di/util/exchange.h"
 #include "di/util/immovable.h"
 #include "di/util/named_arguments.h"
 #include "di/util/noncopyable.h"
 #include "di/util/reference_wrapper.h"
+#include "di/util/swap.h"
 #include "di/vocab/array/array.h"
 #include "di/vocab/error/error.h"
 #include "di/vocab/error/result.h"
+#include "di/vocab/optional/prelude.h"
 #include "di/vocab/span/span_forward_declaration.h"
+#include "di/vocab/tuple/prelude.h"
 #include "di/vocab/variant/holds_alternative.h"
 
 namespace di::execution {
@@ -107,6 +118,13 @@ namespace ipc_binary_ns {
         LittleEndian<u32> message_size;
     };
 
+    // Reads and writes are restarted once the previous one completes. Doing so from within the completion would destroy
+    // the operation state which is still completing, and operations which complete inline would recurse once per
+    // restart. So these operation states are kept in two slots, and the next one always goes into the slot which is not
+    // completing. Inline completions are instead handed back to a loop in the code which started the operation, using
+    // a flag on its stack. The flag stays valid even when completing destroys the object which started the operation.
+    enum class InlineCompletion { Pending, Continue, Done };
+
     struct ReplyWaiterBase : container::IntrusiveListNode<> {
         explicit ReplyWaiterBase(u32 message_number_, u32 message_index_,
                                  Function<void(Variant<void*, Error, SetStopped>)> callback_)
@@ -117,19 +135,429 @@ namespace ipc_binary_ns {
         Function<void(Variant<void*, Error, SetStopped>)> callback;
     };
 
+    // Outstanding reply waiters are indexed by message number, using a power of 2 sized ring of slots. Since message
+    // numbers are allocated sequentially, outstanding messages map to distinct slots as long as the ring is larger than
+    // the distance between the oldest and newest outstanding message. Otherwise, the ring grows until they do, up to
+    // max_slot_count slots. This limit is only reached when some message is never replied to, which the peer controls.
+    // So past it, colliding waiters are kept in an overflow list instead, which is searched linearly.
+    template<typename Alloc>
+    class ReplyWaiters {
+    public:
+        constexpr static usize min_slot_count = 16;
+        constexpr static usize max_slot_count = 4096;
+
+        auto insert(ReplyWaiterBase& waiter) -> Result<> {
+            if (m_slots.empty()) {
+                DI_TRY(grow(min_slot_count));
+            }
+            while (auto* existing = slot(waiter.message_number)) {
+                if (existing->message_number == waiter.message_number) {
+                    return Unexpected(BasicError::InvalidArgument);
+                }
+                if (m_slots.size() >= max_slot_count) {
+                    if (find_overflow(waiter.message_number)) {
+                        return Unexpected(BasicError::InvalidArgument);
+                    }
+                    m_overflow.push_back(waiter);
+                    return {};
+                }
+                DI_TRY(grow(m_slots.size() * 2));
+            }
+            slot(waiter.message_number) = di::addressof(waiter);
+            return {};
+        }
+
+        /// Remove and return the waiter for the given message number, if any.
+        auto take(u32 message_number) -> ReplyWaiterBase* {
+            if (m_slots.empty()) {
+                return nullptr;
+            }
+            auto* waiter = slot(message_number);
+            if (waiter && waiter->message_number == message_number) {
+                slot(message_number) = nullptr;
+                return waiter;
+            }
+            if (auto* overflow = find_overflow(message_number)) {
+                m_overflow.erase(*overflow);
+                return overflow;
+            }
+            return nullptr;
+        }
+
+        void erase(ReplyWaiterBase& waiter) {
+            if (m_slots.empty()) {
+                return;
+            }
+            if (slot(waiter.message_number) == di::addressof(waiter)) {
+                slot(waiter.message_number) = nullptr;
+            } else if (find_overflow(waiter.message_number) == di::addressof(waiter)) {
+                m_overflow.erase(waiter);
+            }
+        }
+
+    private:
+        auto find_overflow(u32 message_number) -> ReplyWaiterBase* {
+            for (auto& waiter : m_overflow) {
+                if (waiter.message_number == message_number) {
+                    return di::addressof(waiter);
+                }
+            }
+            return nullptr;
+        }
+
+        auto slot(u32 message_number) -> ReplyWaiterBase*& { return m_slots[message_number & (m_slots.size() - 1)]; }
+
+        // Waiters which occupy different slots are still in different slots after doubling the ring size.
+        auto grow(usize slot_count) -> Result<> {
+            auto slots = Vector<ReplyWaiterBase*, Alloc> {};
+            if constexpr (concepts::FallibleAllocator<Alloc>) {
+                DI_TRY(slots.resize(slot_count));
+            } else {
+                slots.resize(slot_count);
+            }
+            for (auto* waiter : m_slots) {
+                if (waiter) {
+                    slots[waiter->message_number & (slot_count - 1)] = waiter;
+                }
+            }
+            m_slots = di::move(slots);
+            return {};
+        }
+
+        Vector<ReplyWaiterBase*, Alloc> m_slots;
+        IntrusiveList<ReplyWaiterBase> m_overflow;
+    };
+
+    // The receive buffer reads ahead as much data as is available, so that multiple messages can be decoded after a
+    // single read. Since messages are decoded in place, each message must be stored contiguously. So instead of
+    // wrapping around, any partial message at the end of the buffer is moved to the front before reading more data.
+    template<typename Alloc>
+    class ReceiveBuffer {
+    public:
+        constexpr static usize min_read_size = 4096;
+
+        /// Get the header and body of the next message which is completely buffered, if any.
+        auto next_message() -> Result<Optional<Tuple<MessageHeader, Span<byte const>>>> {
+            auto header = peek_header();
+            if (!header) {
+                return {};
+            }
+
+            auto const total_size = usize(header->message_size.value());
+            if (total_size < sizeof(MessageHeader)) {
+                return Unexpected(BasicError::InvalidArgument);
+            }
+            if (total_size > buffered()) {
+                return {};
+            }
+
+            auto body = Span<byte const> { m_buffer.data() + m_begin + sizeof(MessageHeader),
+                                           total_size - sizeof(MessageHeader) };
+            consume(total_size);
+            return make_tuple(*header, body);
+        }
+
+        /// Get space to read more data into, which has room for at least the rest of the current message.
+        auto prepare() -> Result<Span<byte>> {
+            auto needed = min_read_size;
+            if (auto header = peek_header()) {
+                auto const total_size = usize(header->message_size.value());
+                if (total_size > buffered()) {
+                    needed = container::max(needed, total_size - buffered());
+                }
+            }
+
+            if (m_buffer.capacity() - m_end < needed && m_begin > 0) {
+                container::copy(m_buffer.data() + m_begin, m_buffer.data() + m_end, m_buffer.data());
+                m_end -= m_begin;
+                m_begin = 0;
+                m_buffer.assume_size(m_end);
+            }
+
+            if (m_buffer.capacity() - m_end < needed) {
+                if constexpr (concepts::FallibleAllocator<Alloc>) {
+                    DI_TRY(m_buffer.reserve(m_end + needed));
+                } else {
+                    m_buffer.reserve(m_end + needed);
+                }
+            }
+            return Span<byte> { m_buffer.data() + m_end, m_buffer.capacity() - m_end };
+        }
+
+        /// Mark bytes written into the span returned by prepare() as readable.
+        void commit(usize nread) {
+            m_end += nread;
+            m_buffer.assume_size(m_end);
+        }
+
+    private:
+        auto buffered() const -> usize { return m_end - m_begin; }
+
+        auto peek_header() const -> Optional<MessageHeader> {
+            if (buffered() < sizeof(MessageHeader)) {
+                return nullopt;
+            }
+            auto bytes = Array<byte, sizeof(MessageHeader)> {};
+            container::copy(m_buffer.data() + m_begin, m_buffer.data() + m_begin + sizeof(MessageHeader),
+                            bytes.data());
+            return util::bit_cast<MessageHeader>(bytes);
+        }
+
+        void consume(usize size) {
+            m_begin += size;
+            if (m_begin == m_end) {
+                m_begin = m_end = 0;
+            }
+        }
+
+        Vector<byte, Alloc> m_buffer;
+        usize m_begin { 0 };
+        usize m_end { 0 };
+    };
+
+    template<typename Alloc>
+    struct SendWaiter : container::IntrusiveListNode<> {
+        /// Append the serialized message to the outbound buffer.
+        virtual auto serialize(Vector<byte, Alloc>& buffer) -> Result<> = 0;
+
+        /// Called once the message has been written, or when it could not be.
+        virtual void complete(Result<> result) = 0;
+        virtual void stopped() = 0;
+
+        u64 end_offset { 0 };
+        IntrusiveList<SendWaiter>* queued_in { nullptr };
+    };
+
+    // The send queue serializes messages into a pending buffer while a write is in flight. Once the write finishes,
+    // every pending message is flushed using a single write. Senders whose message was written complete in order.
+    //
+    // For backpressure, new messages are held back once the amount of buffered data reaches the high watermark, and
+    // are only serialized again once the buffered data drops below the low watermark.
+    //
+    // A waiter can be cancelled while it is queued. If its message was already serialized, the message is still
+    // written, but the sender no longer waits for it.
+    //
+    // NOTE: like the rest of the connection state, this is not thread-safe. Senders must be started, stopped and
+    //       completed on a single execution context.
+    template<typename Write, typename Alloc>
+    class SendQueue {
+    private:
+        struct FlushReceiver {
+            using is_receiver = void;
+
+            SendQueue* self;
+
+            friend void tag_invoke(Tag<set_value>, FlushReceiver&& receiver) { receiver.self->did_flush(); }
+
+            friend void tag_invoke(Tag<set_error>, FlushReceiver&& receiver, Error error) {
+                receiver.self->did_fail(Optional<Error>(di::move(error)));
+            }
+
+            friend void tag_invoke(Tag<set_stopped>, FlushReceiver&& receiver) { receiver.self->did_fail(nullopt); }
+
+            friend auto tag_invoke(Tag<get_env>, FlushReceiver const& receiver) {
+                return make_env(empty_env, with(get_stop_token, receiver.self->m_stop_token));
+            }
+        };
+
+        using FlushOperation =
+            meta::ConnectResult<decltype(async_write_exactly(di::declval<Write&>(), di::declval<Span<byte const>>())),
+                                FlushReceiver>;
+
+    public:
+        constexpr static usize default_high_watermark = 64 * 1024;
+        constexpr static usize default_low_watermark = 16 * 1024;
+
+        explicit SendQueue(Write& write, sync::InPlaceStopToken stop_token)
+            : m_write(di::addressof(write)), m_stop_token(di::move(stop_token)) {}
+
+        void set_watermarks(usize low_watermark, usize high_watermark) {
+            DI_ASSERT(low_watermark <= high_watermark);
+            m_low_watermark = low_watermark;
+            m_high_watermark = high_watermark;
+        }
+
+        /// The number of bytes which have been serialized but not yet written.
+        auto buffered() const -> usize { return m_pending.size() + m_in_flight.size(); }
+
+        void push(SendWaiter<Alloc>& waiter) {
+            if (m_failed) {
+                return fail(waiter);
+            }
+            if (!m_blocked.empty() || buffered() >= m_high_watermark) {
+                m_blocked.push_back(waiter);
+                waiter.queued_in = di::addressof(m_blocked);
+                return;
+            }
+
+            enqueue(waiter);
+            if (!m_writing && !m_pending.empty()) {
+                flush();
+            }
+        }
+
+        void cancel(SendWaiter<Alloc>& waiter) {
+            if (auto* list = di::exchange(waiter.queued_in, nullptr)) {
+                list->erase(waiter);
+                waiter.stopped();
+            }
+        }
+
+    private:
+        static auto pop(IntrusiveList<SendWaiter<Alloc>>& list) -> SendWaiter<Alloc>* {
+            auto waiter = list.pop_front();
+            if (!waiter) {
+                return nullptr;
+            }
+            waiter->queued_in = nullptr;
+            return di::addressof(*waiter);
+        }
+
+        void enqueue(SendWaiter<Alloc>& waiter) {
+            auto old_size = m_pending.size();
+            auto result = waiter.serialize(m_pending);
+            if (!result) {
+                m_pending.assume_size(old_size);
+                return waiter.complete(di::move(result));
+            }
+
+            m_enqueued += m_pending.size() - old_size;
+            waiter.end_offset = m_enqueued;
+            m_waiters.push_back(waiter);
+            waiter.queued_in = di::addressof(m_waiters);
+        }
+
+        void flush() {
+            m_writing = true;
+
+            // This may be called from the completion of the write in the current slot.
+            m_flush_slot ^= 1;
+            for (;;) {
+                m_flushed_through = m_enqueued;
+                di::swap(m_pending, m_in_flight);
+
+                auto completion = InlineCompletion::Pending;
+                m_inline_completion = di::addressof(completion);
+
+                auto& flush_operation = m_flush_operations[m_flush_slot];
+                flush_operation.emplace(util::DeferConstruct([&] {
+                    return connect(async_write_exactly(*m_write, m_in_flight.span()), FlushReceiver { this });
+                }));
+                start(*flush_operation);
+
+                if (completion == InlineCompletion::Pending) {
+                    m_inline_completion = nullptr;
+                    return;
+                }
+                if (m_pending.empty()) {
+                    m_writing = false;
+                    return;
+                }
+            }
+        }
+
+        // Called once a write finished, after completing the waiters it covered.
+        void did_finish_write() {
+            if (auto* completion = di::exchange(m_inline_completion, nullptr)) {
+                *completion = InlineCompletion::Continue;
+                return;
+            }
+            if (!m_pending.empty()) {
+                return flush();
+            }
+            m_writing = false;
+        }
+
+        void did_flush() {
+            m_in_flight.clear();
+            while (auto waiter = m_waiters.front()) {
+                if (waiter->end_offset > m_flushed_through) {
+                    break;
+                }
+                pop(m_waiters)->complete({});
+            }
+
+            if (buffered() <= m_low_watermark) {
+                while (auto* waiter = pop(m_blocked)) {
+                    enqueue(*waiter);
+                    if (buffered() >= m_high_watermark) {
+                        break;
+                    }
+                }
+            }
+
+            did_finish_write();
+        }
+
+        // Once a write fails, the stream is left in an unknown state, so every buffered message fails as well, and so
+        // does every message sent afterwards. Since errors cannot be copied, only the first waiter receives the actual
+        // error, and the others receive its generic equivalent.
+        void did_fail(Optional<Error> error) {
+            m_pending.clear();
+            m_in_flight.clear();
+
+            m_failed = true;
+            if (error) {
+                m_failure = error->generic_code();
+            }
+
+            auto* waiter = pop(m_waiters);
+            if (waiter && error) {
+                waiter->complete(Unexpected(di::move(*error)));
+                waiter = pop(m_waiters);
+            }
+            for (; waiter; waiter = pop(m_waiters)) {
+                fail(*waiter);
+            }
+            while (auto* blocked = pop(m_blocked)) {
+                fail(*blocked);
+            }
+
+            did_finish_write();
+        }
+
+        // A write which was stopped fails later messages with stopped as well.
+        void fail(SendWaiter<Alloc>& waiter) {
+            if (!m_failure) {
+                return waiter.stopped();
+            }
+            waiter.complete(Unexpected(Error(*m_failure)));
+        }
+
+        Write* m_write;
+        sync::InPlaceStopToken m_stop_token;
+        Vector<byte, Alloc> m_pending;
+        Vector<byte, Alloc> m_in_flight;
+        IntrusiveList<SendWaiter<Alloc>> m_waiters;
+        IntrusiveList<SendWaiter<Alloc>> m_blocked;
+        Array<Optional<FlushOperation>, 2> m_flush_operations;
+        usize m_flush_slot { 0 };
+        InlineCompletion* m_inline_completion { nullptr };
+        u64 m_enqueued { 0 };
+        u64 m_flushed_through { 0 };
+        usize m_low_watermark { default_low_watermark };
+        usize m_high_watermark { default_high_watermark };
+        Optional<GenericCode> m_failure;
+        bool m_writing { false };
+        bool m_failed { false };
+    };
+
     template<typename Proto, typename Read, typename Write, typename Alloc>
     struct ConnectionDataT {
         struct Type {
-            explicit Type(Read&& read, Write&& write, Alloc&& allocator)
-                : read(di::move(read)), write(di::move(write)), allocator(di::move(allocator)) {}
+            explicit Type(Read&& read_, Write&& write_, Alloc&& allocator_)
+                : read(di::move(read_))
+                , write(di::move(write_))
+                , allocator(di::move(allocator_))
+                , send_queue(write, stop_source.get_stop_token()) {}
 
             [[no_unique_address]] Read read;
             [[no_unique_address]] Write write;
             [[no_unique_address]] Alloc allocator;
-            IntrusiveList<ReplyWaiterBase> reply_waiters;
-            Vector<byte, Alloc> send_buffer;
-            Vector<byte, Alloc> receive_buffer;
+            ReplyWaiters<Alloc> reply_waiters;
+            ReceiveBuffer<Alloc> receive_buffer;
             sync::InPlaceStopSource stop_source;
+            SendQueue<Write, Alloc> send_queue;
             u32 message_number { 0 };
         };
     };
@@ -137,139 +565,472 @@ namespace ipc_binary_ns {
     template<typename Proto, typename Read, typename Write, typename Alloc>
     using ConnectionData = meta::Type<ConnectionDataT<Proto, Read, Write, Alloc>>;
 
+    // Messages are deserialized directly out of the receive buffer. So messages may contain borrowed views (like
+    // di::StringView or di::Span<byte const>), which refer to the receive buffer instead of being copied. These are
+    // only valid until the sender returned by the receiving function completes, since the next message is read
+    // afterwards.
     template<typename Proto, typename ClientOrServer>
-    struct MessageDecode {
-        struct Sender : Peer<ClientOrServer> {
+    struct MessageDecode : Peer<ClientOrServer> {
+        using Protocol = Proto;
+        using Messages = meta::MessageTypes<MessageDecode>;
+
+        using MessageSignature =
+            meta::Chain<meta::Quote<meta::List>, meta::BindBack<meta::Quote<meta::PushFront>, MessageHeader>,
+                        meta::BindFront<meta::Quote<meta::AsLanguageFunction>, SetValue>>;
+
+        using CompletionSignatures = meta::AsTemplate<
+            types::CompletionSignatures,
+            meta::PushBack<meta::PushBack<meta::Transform<Messages, MessageSignature>, SetError(Error)>, SetStopped()>>;
+
+        template<typename Rec>
+        void operator()(Rec& receiver, MessageHeader header, Span<byte const> buffer) const {
+            if (header.message_type >= meta::Size<Messages>) {
+                return set_error(di::move(receiver), Error { BasicError::InvalidArgument });
+            }
+
+            return function::index_dispatch<void, meta::Size<Messages>>(
+                header.message_type, [&]<usize index>(Constexpr<index>) {
+                    using Message = meta::At<Messages, index>;
+
+                    auto result = deserialize_binary<Message>(SpanReader(buffer));
+                    if (!result) {
+                        return set_error(di::move(receiver), Error(di::move(result).error()));
+                    }
+                    return set_value(di::move(receiver), header, di::move(result).value());
+                });
+        }
+    };
+
+    template<typename Proto, typename ClientOrServer>
+    constexpr inline auto message_decode = MessageDecode<Proto, ClientOrServer> {};
+
+    template<typename Proto, typename Read, typename Write, typename Alloc, typename ClientOrServer>
+    struct MessageReceive {
+        using Data = ConnectionData<Proto, Read, Write, Alloc>;
+
+        struct Sender {
             using is_sender = void;
 
-            using Protocol = Proto;
+            using CompletionSignatures = MessageDecode<Proto, ClientOrServer>::CompletionSignatures;
 
             template<typename Rec>
             struct OperationStateT {
                 struct Type : util::Immovable {
-                    explicit Type(Rec receiver_, MessageHeader header_, Span<byte const> buffer_)
-                        : receiver(di::move(receiver_)), header(header_), buffer(buffer_) {}
+                private:
+                    struct ReadReceiver {
+                        using is_receiver = void;
+
+                        Type* self;
+
+                        friend void tag_invoke(Tag<set_value>, ReadReceiver&& receiver, usize nread) {
+                            receiver.self->did_read(nread);
+                        }
+
+                        friend void tag_invoke(Tag<set_error>, ReadReceiver&& receiver, Error error) {
+                            receiver.self->did_finish();
+                            set_error(di::move(receiver.self->m_receiver), di::move(error));
+                        }
 
-                    [[no_unique_address]] Rec receiver;
-                    MessageHeader header;
-                    Span<byte const> buffer;
+                        friend void tag_invoke(Tag<set_stopped>, ReadReceiver&& receiver) {
+                            receiver.self->did_finish();
+                            set_stopped(di::move(receiver.self->m_receiver));
+                        }
 
-                    friend void tag_invoke(Tag<start>, Type& self) {
-                        using Messages = meta::MessageTypes<Sender>;
-                        if (self.header.message_type >= meta::Size<Messages>) {
-                            return set_error(di::move(self.receiver), Error { BasicError::InvalidArgument });
+                        friend auto tag_invoke(Tag<get_env>, ReadReceiver const& receiver) {
+                            return get_env(receiver.self->m_receiver);
                         }
+                    };
+
+                    using ReadOperation =
+                        meta::ConnectResult<decltype(async_read_some(di::declval<Read&>(), di::declval<Span<byte>>())),
+                                            ReadReceiver>;
+
+                public:
+                    explicit Type(Data* data, Rec receiver) : m_data(data), m_receiver(di::move(receiver)) {}
+
+                private:
+                    // Decode a message if one is already buffered, and otherwise read as much data as is available.
+                    void advance() {
+                        // This may be called from the completion of the read in the current slot.
+                        m_read_slot ^= 1;
+                        for (;;) {
+                            auto message = m_data->receive_buffer.next_message();
+                            if (!message) {
+                                return set_error(di::move(m_receiver), Error(di::move(message).error()));
+                            }
+                            if (*message) {
+                                auto [header, buffer] = **message;
+                                return message_decode<Proto, ClientOrServer>(m_receiver, header, buffer);
+                            }
+
+                            auto buffer = m_data->receive_buffer.prepare();
+                            if (!buffer) {
+                                return set_error(di::move(m_receiver), Error(di::move(buffer).error()));
+                            }
+
+                            auto completion = InlineCompletion::Pending;
+                            m_inline_completion = di::addressof(completion);
+
+                            auto& read_operation = m_read_operations[m_read_slot];
+                            read_operation.emplace(util::DeferConstruct([&] {
+                                return connect(async_read_some(m_data->read, *buffer), ReadReceiver { this });
+                            }));
+                            start(*read_operation);
+
+                            // If the receiver was completed, this object may have been destroyed already.
+                            if (completion == InlineCompletion::Done) {
+                                return;
+                            }
+                            if (completion == InlineCompletion::Pending) {
+                                m_inline_completion = nullptr;
+                                return;
+                            }
+                        }
+                    }
 
-                        return function::index_dispatch<void, meta::Size<Messages>>(
-                            self.header.message_type, [&]<usize index>(Constexpr<index>) {
-                                using Message = meta::At<Messages, index>;
+                    void did_read(usize nread) {
+                        if (nread == 0) {
+                            did_finish();
+                            return set_error(di::move(m_receiver), Error(BasicError::ResultOutOfRange));
+                        }
+                        m_data->receive_buffer.commit(nread);
+                        if (auto* completion = di::exchange(m_inline_completion, nullptr)) {
+                            *completion = InlineCompletion::Continue;
+                            return;
+                        }
+                        advance();
+                    }
 
-                                auto result = deserialize_binary<Message>(VectorReader(self.buffer));
-                                if (!result) {
-                                    return set_error(di::move(self.receiver), Error(di::move(result).error()));
-                                }
-                                return set_value(di::move(self.receiver), self.header, di::move(result).value());
-                            });
+                    // Must be called before completing the receiver after a read.
+                    void did_finish() {
+                        if (auto* completion = di::exchange(m_inline_completion, nullptr)) {
+                            *completion = InlineCompletion::Done;
+                        }
                     }
+
+                    friend void tag_invoke(Tag<start>, Type& self) { self.advance(); }
+
+                    Data* m_data;
+                    [[no_unique_address]] Rec m_receiver;
+                    Array<Optional<ReadOperation>, 2> m_read_operations;
+                    usize m_read_slot { 0 };
+                    InlineCompletion* m_inline_completion { nullptr };
                 };
             };
 
             template<typename Rec>
             using OperationState = meta::Type<OperationStateT<Rec>>;
 
-            using CompletionSignatures = meta::AsTemplate<
-                types::CompletionSignatures,
-                meta::PushBack<
-                    meta::Transform<meta::MessageTypes<Sender>,
-                                    meta::Chain<meta::Quote<meta::List>,
-                                                meta::BindBack<meta::Quote<meta::PushFront>, MessageHeader>,
-                                                meta::BindFront<meta::Quote<meta::AsLanguageFunction>, SetValue>>>,
-                    SetError(Error)>>;
-
-            explicit Sender(MessageHeader header_, Span<byte const> buffer_) : header(header_), buffer(buffer_) {}
-
             template<concepts::ReceiverOf<CompletionSignatures> Rec>
             friend auto tag_invoke(Tag<connect>, Sender self, Rec receiver) {
-                return OperationState<Rec> { di::move(receiver), self.header, self.buffer };
+                return OperationState<Rec> { self.data, di::move(receiver) };
             }
 
-            MessageHeader header;
-            Span<byte const> buffer;
+            Data* data;
         };
 
-        auto operator()(MessageHeader header, Span<byte const> buffer) const { return Sender(header, buffer); }
+        auto operator()(Data* data) const { return Sender { data }; }
     };
 
-    template<typename Proto, typename ClientOrServer>
-    constexpr inline auto message_decode = MessageDecode<Proto, ClientOrServer> {};
+    template<typename Proto, typename Read, typename Write, typename Alloc, typename ClientOrServer>
+    constexpr inline auto message_receive = MessageReceive<Proto, Read, Write, Alloc, ClientOrServer> {};
 
     template<typename Proto, typename Read, typename Write, typename Alloc, typename ClientOrServer>
     struct MessageSequence {
         auto operator()(ConnectionData<Proto, Read, Write, Alloc>* data) const {
-            return repeat(let_value_with(
-                [data](Array<byte, sizeof(MessageHeader)>& buffer) {
-                    return async_read_exactly(data->read, buffer.span()) | let_value([data, &buffer] {
-                               auto header = util::bit_cast<MessageHeader>(buffer);
-                               auto const total_size = u32(header.message_size);
-                               return just_from([data, total_size] {
-                                          return data->receive_buffer.reserve(total_size);
-                                      }) |
-                                      let_value([data, header] {
-                                          return async_read_exactly(data->read, Span { data->receive_buffer.data(),
-                                                                                       header.message_size.value() -
-                                                                                           sizeof(MessageHeader) }) |
-                                                 let_value([data, header] {
-                                                     return message_decode<Proto, ClientOrServer>(
-                                                         header, Span { data->receive_buffer.data(),
-                                                                        header.message_size.value() });
-                                                 });
-                                      });
-                           });
-                },
-                make_deferred<Array<byte, sizeof(MessageHeader)>>()));
+            return repeat(message_receive<Proto, Read, Write, Alloc, ClientOrServer>(data));
         }
     };
 
     template<typename Proto, typename Read, typename Write, typename Alloc, typename ClientOrServer>
     constexpr inline auto message_sequence = MessageSequence<Proto, Read, Write, Alloc, ClientOrServer> {};
 
+    template<typename Proto, typename Read, typename Write, typename Alloc, typename Message, usize message_index,
+             typename Rec>
+    struct SendOperationT {
+        struct Type
+            : SendWaiter<Alloc>
+            , util::Immovable {
+        private:
+            struct StopFunction {
+                Type* self;
+
+                void operator()() const noexcept { self->m_data->send_queue.cancel(*self); }
+            };
+
+            using StopCallback = meta::StopTokenOf<meta::EnvOf<Rec>>::template CallbackType<StopFunction>;
+
+        public:
+            explicit Type(ConnectionData<Proto, Read, Write, Alloc>* data, Message&& message,
+                          Optional<u32> maybe_message_number, Rec receiver)
+                : m_data(data)
+                , m_message(di::move(message))
+                , m_maybe_message_number(maybe_message_number)
+                , m_receiver(di::move(receiver)) {}
+
+            auto serialize(Vector<byte, Alloc>& buffer) -> Result<> override {
+                auto total_size = sizeof(MessageHeader) + serialize_size(binary_format, m_message);
+                if constexpr (concepts::FallibleAllocator<Alloc>) {
+                    DI_TRY(buffer.reserve(buffer.size() + total_size));
+                } else {
+                    buffer.reserve(buffer.size() + total_size);
+                }
+
+                m_message_number =
+                    m_maybe_message_number.has_value() ? *m_maybe_message_number : m_data->message_number++;
+                auto message_header = MessageHeader {
+                    .message_type = static_cast<u32>(message_index),
+                    .message_number = m_message_number,
+                    .message_size = total_size,
+                };
+                auto as_bytes = di::bit_cast<Array<byte, sizeof(MessageHeader)>>(message_header);
+
+                // Space for the entire message was reserved above, so serialize directly into the spare capacity.
+                auto old_size = buffer.size();
+                auto writer = UncheckedSpanWriter(Span<byte> { buffer.data() + old_size, total_size });
+                writer.write_unchecked(as_bytes.span());
+                DI_TRY(serialize_binary(writer, m_message));
+                DI_ASSERT(writer.written() == total_size);
+                buffer.assume_size(old_size + total_size);
+                return {};
+            }
+
+            void complete(Result<> result) override {
+                m_stop_callback.reset();
+                if (!result) {
+                    return set_error(di::move(m_receiver), Error(di::move(result).error()));
+                }
+                return set_value(di::move(m_receiver), m_message_number);
+            }
+
+            void stopped() override {
+                m_stop_callback.reset();
+                set_stopped(di::move(m_receiver));
+            }
+
+        private:
+            friend void tag_invoke(Tag<start>, Type& self) {
+                auto stop_token = get_stop_token(get_env(self.m_receiver));
+                if (stop_token.stop_requested()) {
+                    return set_stopped(di::move(self.m_receiver));
+                }
+                self.m_stop_callback.emplace(di::move(stop_token), StopFunction { di::addressof(self) });
+                self.m_data->send_queue.push(self);
+            }
+
+            ConnectionData<Proto, Read, Write, Alloc>* m_data;
+            Message m_message;
+            Optional<u32> m_maybe_message_number;
+            u32 m_message_number { 0 };
+            [[no_unique_address]] Rec m_receiver;
+            Optional<StopCallback> m_stop_callback;
+        };
+    };
+
+    template<typename Proto, typename Read, typename Write, typename Alloc, typename Message, usize message_index,
+             typename Rec>
+    using SendOperation = meta::Type<SendOperationT<Proto, Read, Write, Alloc, Message, message_index, Rec>>;
+
+    // Sends a message through the connection's send queue, completing with the message number once it was written.
+    template<typename Proto, typename Read, typename Write, typename Alloc, typename Message, usize message_index>
+    struct SendSenderT {
+        struct Type {
+            using is_sender = void;
+
+            using CompletionSignatures = di::CompletionSignatures<SetValue(u32), SetError(Error), SetStopped()>;
+
+            template<concepts::ReceiverOf<CompletionSignatures> Rec>
+            friend auto tag_invoke(Tag<connect>, Type self, Rec receiver) {
+                return SendOperation<Proto, Read, Write, Alloc, Message, message_index, Rec>(
+                    self.data, di::move(self.message), self.maybe_message_number, di::move(receiver));
+            }
+
+            ConnectionData<Proto, Read, Write, Alloc>* data;
+            Message message;
+            Optional<u32> maybe_message_number;
+        };
+    };
+
+    template<typename Proto, typename Read, typename Write, typename Alloc, typename Message, usize message_index>
+    using SendSender = meta::Type<SendSenderT<Proto, Read, Write, Alloc, Message, message_index>>;
+
+    // Sends a message and waits for its reply. The waiter is registered before sending the message, so that the reply
+    // cannot be missed. Since the reply can be processed before the send completes, the operation only completes once
+    // both have happened.
     template<typename Proto, typename Read, typename Write, typename Alloc, typename ClientOrServer,
              usize message_index_, typename Rec>
     struct WaitForReplyOperationT {
-        struct Type : ReplyWaiterBase {
+        struct Type
+            : ReplyWaiterBase
+            , util::Immovable {
             constexpr static auto message_index = message_index_;
             using Message = MessageAtIndex<Proto, ClientOrServer, message_index>;
             using Reply = meta::MessageReply<Message>;
 
+        private:
+            struct SendReceiver {
+                using is_receiver = void;
+
+                Type* self;
+
+                friend void tag_invoke(Tag<set_value>, SendReceiver&& receiver, u32) { receiver.self->did_send(); }
+
+                friend void tag_invoke(Tag<set_error>, SendReceiver&& receiver, Error error) {
+                    receiver.self->did_fail_send(Variant<Reply, Error, SetStopped>(c_<1ZU>, di::move(error)));
+                }
+
+                friend void tag_invoke(Tag<set_stopped>, SendReceiver&& receiver) {
+                    receiver.self->did_fail_send(Variant<Reply, Error, SetStopped>(c_<2ZU>));
+                }
+
+                friend auto tag_invoke(Tag<get_env>, SendReceiver const& receiver) {
+                    return get_env(receiver.self->m_receiver);
+                }
+            };
+
+            using SendOperation =
+                meta::ConnectResult<SendSender<Proto, Read, Write, Alloc, Message, message_index>, SendReceiver>;
+
+            struct StopFunction {
+                Type* self;
+
+                void operator()() const noexcept { self->did_stop(); }
+            };
+
+            using StopCallback = meta::StopTokenOf<meta::EnvOf<Rec>>::template CallbackType<StopFunction>;
+
         public:
-            explicit Type(ConnectionData<Proto, Read, Write, Alloc>* data, u32 message_number, Rec receiver)
-                : ReplyWaiterBase(message_number, message_index,
+            explicit Type(ConnectionData<Proto, Read, Write, Alloc>* data, Message&& message,
+                          Optional<u32> maybe_message_number, Rec receiver)
+                : ReplyWaiterBase(0, message_index,
                                   [this](Variant<void*, Error, SetStopped> result) {
                                       di::visit(di::overload(
                                                     [this](void* data) {
-                                                        set_value(di::move(m_receiver),
-                                                                  di::move(*static_cast<Reply*>(data)));
+                                                        store_reply(*static_cast<Reply*>(data));
                                                     },
                                                     [this](Error error) {
-                                                        set_error(di::move(m_receiver), di::move(error));
+                                                        m_result.emplace(c_<1ZU>, di::move(error));
                                                     },
                                                     [this](SetStopped) {
-                                                        set_stopped(di::move(m_receiver));
+                                                        m_result.emplace(c_<2ZU>);
                                                     }),
                                                 di::move(result));
+                                      if (m_sent) {
+                                          finish();
+                                      }
                                   })
                 , m_data(data)
+                , m_message(di::move(message))
+                , m_maybe_message_number(maybe_message_number)
                 , m_receiver(di::move(receiver)) {}
 
         private:
+            // If the send already completed, the reply is passed on before the receive buffer is reused. Otherwise,
+            // any borrowed views in the reply would dangle by the time the operation completes. So the reply is
+            // serialized into storage owned by the operation, and decoded again from there.
+            void store_reply(Reply& reply) {
+                if (m_sent) {
+                    m_result.emplace(c_<0ZU>, di::move(reply));
+                    return;
+                }
+
+                auto result = retain_reply(reply);
+                if (!result) {
+                    m_result.emplace(c_<1ZU>, Error(di::move(result).error()));
+                    return;
+                }
+                m_result.emplace(c_<0ZU>, di::move(result).value());
+            }
+
+            auto retain_reply(Reply& reply) -> Result<Reply> {
+                auto size = serialize_size(binary_format, reply);
+                if constexpr (concepts::FallibleAllocator<Alloc>) {
+                    DI_TRY(m_reply_storage.reserve(size));
+                } else {
+                    m_reply_storage.reserve(size);
+                }
+
+                auto writer = UncheckedSpanWriter(Span<byte> { m_reply_storage.data(), size });
+                DI_TRY(serialize_binary(writer, reply));
+                m_reply_storage.assume_size(size);
+                return deserialize_binary<Reply>(SpanReader(Span<byte const> { m_reply_storage.data(), size }));
+            }
+
+            void did_send() {
+                m_sent = true;
+                if (m_result) {
+                    finish();
+                }
+            }
+
+            void did_fail_send(Variant<Reply, Error, SetStopped> result) {
+                if (!m_result) {
+                    m_data->reply_waiters.erase(*this);
+                }
+                m_result = di::move(result);
+                finish();
+            }
+
+            // The send has its own stop callback, so if it is still in progress, it completes shortly after this.
+            void did_stop() {
+                if (m_result) {
+                    return;
+                }
+                m_data->reply_waiters.erase(*this);
+                m_result.emplace(c_<2ZU>);
+                if (m_sent) {
+                    finish();
+                }
+            }
+
+            void finish() {
+                m_stop_callback.reset();
+                di::visit(di::overload(
+                              [this](Reply& reply) {
+                                  set_value(di::move(m_receiver), di::move(reply));
+                              },
+                              [this](Error& error) {
+                                  set_error(di::move(m_receiver), di::move(error));
+                              },
+                              [this](SetStopped) {
+                                  set_stopped(di::move(m_receiver));
+                              }),
+                          *m_result);
+            }
+
             friend void tag_invoke(Tag<start>, Type& self) {
-                // FIXME: we actually need to add ourselves as a waiter before sending the message.
+                auto stop_token = get_stop_token(get_env(self.m_receiver));
+                if (stop_token.stop_requested()) {
+                    return set_stopped(di::move(self.m_receiver));
+                }
+
                 auto* data = self.m_data;
-                data->reply_waiters.push_back(self);
+                self.message_number =
+                    self.m_maybe_message_number.has_value() ? *self.m_maybe_message_number : data->message_number++;
+
+                auto result = data->reply_waiters.insert(self);
+                if (!result) {
+                    return set_error(di::move(self.m_receiver), Error(di::move(result).error()));
+                }
+                self.m_stop_callback.emplace(di::move(stop_token), StopFunction { di::addressof(self) });
+
+                self.m_send_operation.emplace(util::DeferConstruct([&] {
+                    return connect(SendSender<Proto, Read, Write, Alloc, Message, message_index> {
+                                       data, di::move(self.m_message), self.message_number },
+                                   SendReceiver { di::addressof(self) });
+                }));
+                start(*self.m_send_operation);
             }
 
             ConnectionData<Proto, Read, Write, Alloc>* m_data;
-            Rec m_receiver;
+            Message m_message;
+            Optional<u32> m_maybe_message_number;
+            Optional<Variant<Reply, Error, SetStopped>> m_result;
+            Vector<byte, Alloc> m_reply_storage;
+            Optional<SendOperation> m_send_operation;
+            bool m_sent { false };
+            [[no_unique_address]] Rec m_receiver;
+            Optional<StopCallback> m_stop_callback;
         };
     };
 
@@ -292,7 +1053,7 @@ namespace ipc_binary_ns {
             template<concepts::ReceiverOf<CompletionSignatures> Rec>
             friend auto tag_invoke(Tag<connect>, Type self, Rec receiver) {
                 return WaitForReplyOperation<Proto, Read, Write, Alloc, ClientOrServer, message_index, Rec>(
-                    self.data, self.message_number, di::move(receiver));
+                    self.data, di::move(self.message), self.maybe_message_number, di::move(receiver));
             }
 
             friend auto tag_invoke(Tag<get_env>, Type const& self) {
@@ -301,7 +1062,8 @@ namespace ipc_binary_ns {
             }
 
             ConnectionData<Proto, Read, Write, Alloc>* data;
-            u32 message_number;
+            Message message;
+            Optional<u32> maybe_message_number;
         };
     };
 
@@ -328,45 +1090,21 @@ namespace ipc_binary_ns {
                 static_assert(math::representable_as<u32>(message_index),
                               "There can be at most 2^32 messages in a protocol.");
 
-                // FIXME: acquire a async mutex first.
-                return just_from([message = util::forward<T>(message), data = self.data,
-                                  maybe_message_number] -> Result<u32> {
-                           // Serialize the message. We re-use the send buffer to prevent extra allocations.
-                           auto send_buffer = di::move(data->send_buffer);
-                           send_buffer.clear();
-
-                           auto total_size = sizeof(MessageHeader) + serialize_size(binary_format, message);
-                           if constexpr (concepts::FallibleAllocator<Alloc>) {
-                               DI_TRY(send_buffer.reserve(total_size));
-                           } else {
-                               send_buffer.reserve(total_size);
-                           }
-
-                           auto writer = VectorWriter(di::move(send_buffer));
-                           auto message_number =
-                               maybe_message_number.has_value() ? *maybe_message_number : data->message_number++;
-                           auto message_header = MessageHeader {
-                               .message_type = static_cast<u32>(message_index),
-                               .message_number = message_number,
-                               .message_size = total_size,
-                           };
-                           auto as_bytes = di::bit_cast<Array<byte, sizeof(MessageHeader)>>(message_header);
-                           DI_TRY(write_exactly(writer, as_bytes.span()));
-                           DI_TRY(serialize_binary(writer, message));
-                           data->send_buffer = di::move(writer).vector();
-                           return message_number;
-                       }) |
-                       let_value([data = self.data](u32 message_number) {
-                           if constexpr (concepts::MessageWithReply<U>) {
-                               return async_write_exactly(data->write, data->send_buffer.span()) |
-                                      let_value([data, message_number] {
-                                          return WaitForReplySender<Proto, Read, Write, Alloc, ClientOrServer,
-                                                                    message_index>(data, message_number);
-                                      });
-                           } else {
-                               return async_write_exactly(data->write, data->send_buffer.span());
-                           }
-                       });
+                if constexpr (concepts::MessageWithReply<U>) {
+                    return WaitForReplySender<Proto, Read, Write, Alloc, ClientOrServer, message_index> {
+                        self.data, U(util::forward<T>(message)), maybe_message_number
+                    };
+                } else {
+                    return SendSender<Proto, Read, Write, Alloc, U, message_index> {
+                               self.data, U(util::forward<T>(message)), maybe_message_number
+                           } |
+                           then([](u32) {});
+                }
+            }
+
+            /// Configure when sending messages applies backpressure. See SendQueue for details.
+            void set_send_watermarks(usize low_watermark, usize high_watermark) {
+                data->send_queue.set_watermarks(low_watermark, high_watermark);
             }
 
             ConnectionData<Proto, Read, Write, Alloc>* data;
@@ -387,12 +1125,8 @@ namespace ipc_binary_ns {
                 if constexpr (!concepts::Reply<FilterMessagesFunction, T>) {
                     return just(true);
                 } else {
-                    for (auto& waiter : data->reply_waiters) {
-                        if (waiter.message_number == header.message_number) {
-                            waiter.callback(static_cast<void*>(di::addressof(message)));
-                            data->reply_waiters.erase(waiter);
-                            break;
-                        }
+                    if (auto* waiter = data->reply_waiters.take(header.message_number)) {
+                        waiter->callback(static_cast<void*>(di::addressof(message)));
                     }
                     return just(false);
                 }
@@ -0,0 +1,469 @@
+#pragma once
+
+#include "di/bit/operation/bit_ceil.h"
+#include "di/container/algorithm/max.h"
+#include "di/execution/algorithm/let.h"
+#include "di/execution/concepts/receiver_of.h"
+#include "di/execution/context/epoll_context.h"
+#include "di/execution/interface/connect.h"
+#include "di/execution/interface/get_env.h"
+#include "di/execution/interface/schedule.h"
+#include "di/execution/interface/start.h"
+#include "di/execution/io/async_read_some.h"
+#include "di/execution/io/async_write_some.h"
+#include "di/execution/meta/connect_result.h"
+#include "di/execution/meta/env_of.h"
+#include "di/execution/meta/stop_token_of.h"
+#include "di/execution/query/get_stop_token.h"
+#include "di/execution/query/make_env.h"
+#include "di/execution/receiver/set_error.h"
+#include "di/execution/receiver/set_stopped.h"
+#include "di/execution/receiver/set_value.h"
+#include "di/execution/types/completion_signuatures.h"
+#include "di/execution/types/empty_env.h"
+#include "di/function/tag_invoke.h"
+#include "di/io/spsc_byte_ring.h"
+#include "di/meta/util.h"
+#include "di/platform/linux_syscall.h"
+#include "di/platform/prelude.h"
+#include "di/sync/stop_token/in_place_stop_source.h"
+#include "di/sync/stop_token/in_place_stop_token.h"
+#include "di/types/byte.h"
+#include "di/types/integers.h"
+#include "di/util/addressof.h"
+#include "di/util/declval.h"
+#include "di/util/defer_construct.h"
+#include "di/util/exchange.h"
+#include "di/util/immovable.h"
+#include "di/util/move.h"
+#include "di/util/noncopyable.h"
+#include "di/vocab/array/array.h"
+#include "di/vocab/error/result.h"
+#include "di/vocab/expected/prelude.h"
+#include "di/vocab/optional/prelude.h"
+#include "di/vocab/span/prelude.h"
+
+#ifdef __linux__
+namespace di::execution {
+/// @brief A bidirectional byte stream between two processes, over a pair of SpscByteRings in shared memory.
+///
+/// The rings live in a sealed memfd mapping. Each side also owns one end of a socket pair, which serves as its
+/// doorbell. The peer maps the same rings by calling attach() with the memfd, the other end of the socket pair
+/// (inherited across fork(), or sent over a unix socket) and the same capacity. The side which called create() writes
+/// into the first ring and reads from the second one, and the attached side does the opposite. The channel models
+/// async_read_some() and async_write_some(), so it can be used as the transport of an ipc_binary connection.
+///
+/// When its ring is empty (or full), an operation parks itself, and the peer only rings the doorbell when it sees the
+/// parked flag, so transferring data does not involve the kernel while both sides keep up with each other. Parked
+/// operations are resumed once the EpollContext reports the doorbell as readable, so a side can read and write at the
+/// same time, and parked operations complete with stopped when their stop token is triggered. When the peer exits,
+/// its end of the doorbell is closed, so parked reads observe end of file and parked writes make no progress, instead
+/// of waiting forever.
+///
+/// @note Operations must be started, stopped and destroyed on the thread running the context, and the channel must
+///       outlive them.
+///
+/// @see SpscRingChannel
+class SharedRingChannel : util::NonCopyable {
+private:
+    struct WaiterBase {
+        virtual void wake() = 0;
+
+        bool cancelled { false };
+    };
+
+    template<bool is_read, typename Rec>
+    struct OperationStateT {
+        struct Type
+            : WaiterBase
+            , util::Immovable {
+        private:
+            using Buffer = meta::Conditional<is_read, Span<byte>, Span<byte const>>;
+
+            struct StopFunction {
+                Type* self;
+
+                void operator()() const noexcept { self->m_channel->cancel(*self, is_read); }
+            };
+
+            using StopCallback = meta::StopTokenOf<meta::EnvOf<Rec>>::template CallbackType<StopFunction>;
+
+        public:
+            explicit Type(SharedRingChannel* channel, Buffer buffer, Rec receiver)
+                : m_channel(channel), m_buffer(buffer), m_receiver(util::move(receiver)) {}
+
+            void wake() override { attempt(); }
+
+        private:
+            void attempt() {
+                if (cancelled) {
+                    m_stop_callback.reset();
+                    return set_stopped(util::move(m_receiver));
+                }
+
+                auto& channel = *m_channel;
+                if constexpr (is_read) {
+                    auto& ring = channel.m_read_ring;
+                    auto nread = ring.try_read(m_buffer);
+                    if (nread == 0 && !m_buffer.empty() && !ring.closed() && !channel.m_peer_gone) {
+                        if (ring.park_reader()) {
+                            return channel.park(channel.m_parked_reader, *this);
+                        }
+                        return attempt();
+                    }
+                    channel.wake_writer(ring);
+                    m_stop_callback.reset();
+                    set_value(util::move(m_receiver), nread);
+                } else {
+                    auto& ring = channel.m_write_ring;
+                    auto nwritten = ring.try_write(m_buffer);
+                    if (nwritten == 0 && !m_buffer.empty() && !ring.closed() && !channel.m_peer_gone) {
+                        if (ring.park_writer()) {
+                            return channel.park(channel.m_parked_writer, *this);
+                        }
+                        return attempt();
+                    }
+                    channel.wake_reader(ring);
+                    m_stop_callback.reset();
+                    set_value(util::move(m_receiver), nwritten);
+                }
+            }
+
+            friend void tag_invoke(types::Tag<start>, Type& self) {
+                auto stop_token = get_stop_token(get_env(self.m_receiver));
+                if (stop_token.stop_requested()) {
+                    return set_stopped(util::move(self.m_receiver));
+                }
+                self.m_stop_callback.emplace(util::move(stop_token), StopFunction { util::addressof(self) });
+                self.attempt();
+            }
+
+            SharedRingChannel* m_channel;
+            Buffer m_buffer;
+            [[no_unique_address]] Rec m_receiver;
+            Optional<StopCallback> m_stop_callback;
+        };
+    };
+
+    template<bool is_read, typename Rec>
+    using OperationState = meta::Type<OperationStateT<is_read, Rec>>;
+
+    template<bool is_read>
+    struct Sender {
+        using is_sender = void;
+
+        using CompletionSignatures = types::CompletionSignatures<SetValue(usize), SetStopped()>;
+
+        using Buffer = meta::Conditional<is_read, Span<byte>, Span<byte const>>;
+
+        SharedRingChannel* channel;
+        Buffer buffer;
+
+    private:
+        template<concepts::ReceiverOf<CompletionSignatures> Rec>
+        friend auto tag_invoke(types::Tag<connect>, Sender self, Rec receiver) {
+            return OperationState<is_read, Rec> { self.channel, self.buffer, util::move(receiver) };
+        }
+    };
+
+    // The channel is still incomplete here, so these types are spelled out instead of deduced.
+    using DoorbellRead = decltype(async_read_some(di::declval<EpollFile&>(), di::declval<Span<byte>>()));
+    using DoorbellEnv = decltype(make_env(empty_env, with(get_stop_token, di::declval<sync::InPlaceStopToken>())));
+
+    // Reading the doorbell first hops onto the context, so that it never completes inline while a parked operation is
+    // still being started.
+    struct ReadDoorbell {
+        SharedRingChannel* self;
+
+        auto operator()() const -> DoorbellRead {
+            return async_read_some(self->m_doorbell, self->m_doorbell_buffer.span());
+        }
+    };
+
+    struct DoorbellReceiver {
+        using is_receiver = void;
+
+        SharedRingChannel* self;
+        sync::InPlaceStopToken stop_token;
+
+        friend void tag_invoke(types::Tag<set_value>, DoorbellReceiver&& receiver, usize nread) {
+            receiver.self->did_ring(nread == 0);
+        }
+        friend void tag_invoke(types::Tag<set_error>, DoorbellReceiver&& receiver, Error) {
+            receiver.self->did_ring(true);
+        }
+        friend void tag_invoke(types::Tag<set_stopped>, DoorbellReceiver&& receiver) {
+            receiver.self->did_ring(false);
+        }
+
+        friend auto tag_invoke(types::Tag<get_env>, DoorbellReceiver const& receiver) -> DoorbellEnv {
+            return make_env(empty_env, with(get_stop_token, receiver.stop_token));
+        }
+    };
+
+    using DoorbellOperation =
+        meta::ConnectResult<decltype(let_value(schedule(di::declval<EpollContext&>().get_scheduler()),
+                                               di::declval<ReadDoorbell>())),
+                            DoorbellReceiver>;
+
+    // A new read of the doorbell can be started while the previous one is still completing, so they alternate between
+    // two slots.
+    struct DoorbellSlot {
+        Optional<sync::InPlaceStopSource> stop_source;
+        Optional<DoorbellOperation> operation;
+    };
+
+public:
+    /// @brief Create a new pair of rings, each able to hold at least capacity bytes.
+    ///
+    /// The memfd and the peer's end of the doorbell must be passed to the peer. Afterwards, call close_peer_doorbell(),
+    /// as otherwise the peer exiting cannot be detected.
+    static auto create(EpollContext& context, usize capacity) -> Result<SharedRingChannel> {
+        namespace linux_syscall = platform::linux_syscall;
+
+        auto fd = linux_syscall::memfd_create("di-shared-ring-channel",
+                                              linux_syscall::mfd_cloexec | linux_syscall::mfd_allow_sealing);
+        if (linux_syscall::is_error(fd)) {
+            return Unexpected(error_from(fd));
+        }
+
+        int doorbells[2];
+        auto result =
+            linux_syscall::socketpair(linux_syscall::address_family_unix, linux_syscall::socket_stream, 0, doorbells);
+        if (linux_syscall::is_error(result)) {
+            linux_syscall::close(int(fd));
+            return Unexpected(error_from(result));
+        }
+
+        auto channel = SharedRingChannel(context, int(fd), doorbells[0]);
+        channel.m_peer_doorbell = doorbells[1];
+
+        // Sealing the size keeps the peer from truncating the file, which would fault on the next access to the rings.
+        auto const ring_size = ring_size_for(capacity);
+        result = linux_syscall::ftruncate(int(fd), 2 * ring_size);
+        if (!linux_syscall::is_error(result)) {
+            result = linux_syscall::add_seals(int(fd), linux_syscall::f_seal_shrink | linux_syscall::f_seal_grow |
+                                                           linux_syscall::f_seal_seal);
+        }
+        if (linux_syscall::is_error(result)) {
+            return Unexpected(error_from(result));
+        }
+
+        DI_TRY(channel.map(ring_size));
+        channel.m_write_ring = *SpscByteRing::create(channel.ring_memory(0));
+        channel.m_read_ring = *SpscByteRing::create(channel.ring_memory(1));
+        return channel;
+    }
+
+    /// @brief Attach to the rings created by the peer.
+    ///
+    /// Both file descriptors are owned by the returned channel, and capacity must match what the peer passed to
+    /// create(). The memfd must be sealed against shrinking and large enough to hold both rings, as the peer is not
+    /// trusted to provide a valid one.
+    static auto attach(EpollContext& context, int fd, int doorbell, usize capacity) -> Result<SharedRingChannel> {
+        namespace linux_syscall = platform::linux_syscall;
+
+        auto channel = SharedRingChannel(context, fd, doorbell);
+
+        auto seals = linux_syscall::get_seals(fd);
+        if (linux_syscall::is_error(seals)) {
+            return Unexpected(error_from(seals));
+        }
+        auto size = linux_syscall::file_size(fd);
+        if (linux_syscall::is_error(size)) {
+            return Unexpected(error_from(size));
+        }
+
+        auto const ring_size = ring_size_for(capacity);
+        if (!(seals & linux_syscall::f_seal_shrink) || usize(size) < 2 * ring_size) {
+            return Unexpected(BasicError::InvalidArgument);
+        }
+
+        DI_TRY(channel.map(ring_size));
+        channel.m_read_ring = *SpscByteRing::attach(channel.ring_memory(0));
+        channel.m_write_ring = *SpscByteRing::attach(channel.ring_memory(1));
+        return channel;
+    }
+
+    /// @note The channel can only be moved before any operation is started.
+    SharedRingChannel(SharedRingChannel&& other)
+        : m_context(other.m_context)
+        , m_fd(util::exchange(other.m_fd, -1))
+        , m_peer_doorbell(util::exchange(other.m_peer_doorbell, -1))
+        , m_mapping(util::exchange(other.m_mapping, nullptr))
+        , m_ring_size(other.m_ring_size)
+        , m_read_ring(other.m_read_ring)
+        , m_write_ring(other.m_write_ring)
+        , m_doorbell(util::move(other.m_doorbell)) {}
+
+    ~SharedRingChannel() {
+        if (m_mapping) {
+            platform::linux_syscall::munmap(m_mapping, 2 * m_ring_size);
+        }
+        if (m_fd >= 0) {
+            platform::linux_syscall::close(m_fd);
+        }
+        close_peer_doorbell();
+    }
+
+    /// @brief The memfd holding the rings, which must be passed to the peer.
+    auto fd() const -> int { return m_fd; }
+
+    /// @brief The peer's end of the doorbell, which must be passed to the peer, or -1 once closed.
+    auto peer_doorbell() const -> int { return m_peer_doorbell; }
+
+    /// @brief Close this process's copy of the peer's end of the doorbell, once the peer has its own.
+    void close_peer_doorbell() {
+        if (m_peer_doorbell >= 0) {
+            platform::linux_syscall::close(util::exchange(m_peer_doorbell, -1));
+        }
+    }
+
+    /// @brief Stop writing to the channel. The peer observes end of file once the remaining data has been read.
+    void close() {
+        m_write_ring.close();
+        wake_reader(m_write_ring);
+    }
+
+private:
+    explicit SharedRingChannel(EpollContext& context, int fd, int doorbell)
+        : m_context(util::addressof(context)), m_fd(fd), m_doorbell(context, doorbell) {}
+
+    static auto error_from(long result) -> Error {
+        if (-result == platform::linux_syscall::error_no_memory) {
+            return Error(BasicError::NotEnoughMemory);
+        }
+        return Error(BasicError::InvalidArgument);
+    }
+
+    // The mapping is page aligned, and the header's size and the data area are multiples of the header's alignment,
+    // so the second ring is properly aligned as well.
+    static auto ring_size_for(usize capacity) -> usize {
+        return sizeof(SpscByteRingHeader) + bit::bit_ceil(container::max(capacity, alignof(SpscByteRingHeader)));
+    }
+
+    auto map(usize ring_size) -> Result<> {
+        auto address = platform::linux_syscall::mmap_shared(m_fd, 2 * ring_size);
+        if (platform::linux_syscall::is_error(address)) {
+            return Unexpected(error_from(address));
+        }
+        m_mapping = reinterpret_cast<byte*>(address);
+        m_ring_size = ring_size;
+        return {};
+    }
+
+    auto ring_memory(usize index) -> Span<byte> { return { m_mapping + index * m_ring_size, m_ring_size }; }
+
+    // The doorbell is non-blocking, and a full doorbell already has a pending ring, so failures are ignored. If the
+    // peer is gone, reading the doorbell reports it.
+    void ring_doorbell() {
+        auto const bell = byte(1);
+        platform::linux_syscall::send(m_doorbell.fd(), &bell, 1);
+    }
+
+    void wake_reader(SpscByteRing& ring) {
+        if (ring.reader_parked()) {
+            ring.unpark_reader();
+            ring_doorbell();
+        }
+    }
+
+    void wake_writer(SpscByteRing& ring) {
+        if (ring.writer_parked()) {
+            ring.unpark_writer();
+            ring_doorbell();
+        }
+    }
+
+    void park(WaiterBase*& slot, WaiterBase& waiter) {
+        slot = util::addressof(waiter);
+        if (!m_listening) {
+            listen();
+        }
+    }
+
+    void listen() {
+        m_listening = true;
+        m_doorbell_slot ^= 1;
+
+        auto& slot = m_doorbell_slots[m_doorbell_slot];
+        slot.operation.reset();
+        slot.stop_source.emplace();
+        slot.operation.emplace(util::DeferConstruct([&] {
+            return connect(let_value(schedule(m_context->get_scheduler()), ReadDoorbell { this }),
+                           DoorbellReceiver { this, slot.stop_source->get_stop_token() });
+        }));
+        start(*slot.operation);
+    }
+
+    // Any ring of the doorbell may be for either direction, so both parked operations check their ring again.
+    void did_ring(bool peer_gone) {
+        m_listening = false;
+        m_peer_gone |= peer_gone;
+
+        auto* reader = util::exchange(m_parked_reader, nullptr);
+        auto* writer = util::exchange(m_parked_writer, nullptr);
+        if (reader) {
+            m_read_ring.unpark_reader();
+            reader->wake();
+        }
+        if (writer) {
+            m_write_ring.unpark_writer();
+            writer->wake();
+        }
+    }
+
+    // A parked operation can be woken directly while the other direction still needs the doorbell. Otherwise, the
+    // read of the doorbell is stopped first, so that it is never left running once every operation completed.
+    void cancel(WaiterBase& waiter, bool is_read) {
+        waiter.cancelled = true;
+
+        auto& parked = is_read ? m_parked_reader : m_parked_writer;
+        if (parked != util::addressof(waiter)) {
+            return;
+        }
+        if ((is_read ? m_parked_writer : m_parked_reader) == nullptr) {
+            m_doorbell_slots[m_doorbell_slot].stop_source->request_stop();
+            return;
+        }
+
+        parked = nullptr;
+        if (is_read) {
+            m_read_ring.unpark_reader();
+        } else {
+            m_write_ring.unpark_writer();
+        }
+        waiter.wake();
+    }
+
+    friend auto tag_invoke(types::Tag<async_read_some>, SharedRingChannel& self, Span<byte> buffer, Optional<u64>) {
+        return Sender<true> { util::addressof(self), buffer };
+    }
+
+    friend auto tag_invoke(types::Tag<async_write_some>, SharedRingChannel& self, Span<byte const> buffer,
+                           Optional<u64>) {
+        return Sender<false> { util::addressof(self), buffer };
+    }
+
+    EpollContext* m_context;
+    int m_fd { -1 };
+    int m_peer_doorbell { -1 };
+    byte* m_mapping { nullptr };
+    usize m_ring_size { 0 };
+    SpscByteRing m_read_ring;
+    SpscByteRing m_write_ring;
+    EpollFile m_doorbell;
+    Array<byte, 64> m_doorbell_buffer {};
+    Array<DoorbellSlot, 2> m_doorbell_slots {};
+    usize m_doorbell_slot { 0 };
+    WaiterBase* m_parked_reader { nullptr };
+    WaiterBase* m_parked_writer { nullptr };
+    bool m_listening { false };
+    bool m_peer_gone { false };
+};
+}
+
+namespace di {
+using execution::SharedRingChannel;
+}
+#endif
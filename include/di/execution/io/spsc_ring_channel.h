@@ -0,0 +1,182 @@
+#pragma once
+
+#include "di/execution/concepts/receiver_of.h"
+#include "di/execution/context/trampoline_scheduler.h"
+#include "di/execution/interface/connect.h"
+#include "di/execution/interface/get_env.h"
+#include "di/execution/interface/schedule.h"
+#include "di/execution/interface/start.h"
+#include "di/execution/io/async_read_some.h"
+#include "di/execution/io/async_write_some.h"
+#include "di/execution/meta/connect_result.h"
+#include "di/execution/receiver/set_stopped.h"
+#include "di/execution/receiver/set_value.h"
+#include "di/execution/types/completion_signuatures.h"
+#include "di/execution/types/empty_env.h"
+#include "di/function/tag_invoke.h"
+#include "di/io/spsc_byte_ring.h"
+#include "di/meta/util.h"
+#include "di/util/addressof.h"
+#include "di/util/defer_construct.h"
+#include "di/util/exchange.h"
+#include "di/util/immovable.h"
+#include "di/vocab/optional/prelude.h"
+#include "di/vocab/span/prelude.h"
+
+namespace di::execution {
+/// @brief An asynchronous byte stream over a SpscByteRing.
+///
+/// The channel models async_read_some() for the consumer and async_write_some() for the producer, so it can be used
+/// anywhere a socket can, including as the transport of an ipc_binary connection. Use one channel per direction.
+///
+/// When the ring is empty (or full), the operation parks itself and is resumed once the other side makes progress, so
+/// the producer only needs to wake the consumer (and vice versa) when it is actually waiting. Parked operations are
+/// resumed through a TrampolineScheduler, so that repeatedly waking each other does not grow the stack without bound.
+///
+/// @note Waking is done by resuming the parked operation directly, which requires both sides to be in the same
+///       process and on the same execution context. Between processes, use SharedRingChannel, which wakes the peer
+///       through a socket driven by an EpollContext instead.
+///
+/// @see SharedRingChannel
+class SpscRingChannel : util::Immovable {
+private:
+    struct WaiterBase {
+        virtual void wake() = 0;
+    };
+
+    template<bool is_read, typename Rec>
+    struct OperationStateT {
+        struct Type
+            : WaiterBase
+            , util::Immovable {
+        private:
+            using Buffer = meta::Conditional<is_read, Span<byte>, Span<byte const>>;
+
+            struct ResumeReceiver {
+                using is_receiver = void;
+
+                Type* self;
+
+                friend void tag_invoke(types::Tag<set_value>, ResumeReceiver&& receiver) { receiver.self->attempt(); }
+                friend void tag_invoke(types::Tag<set_stopped>, ResumeReceiver&& receiver) {
+                    receiver.self->attempt();
+                }
+                friend auto tag_invoke(types::Tag<get_env>, ResumeReceiver const&) { return empty_env; }
+            };
+
+            using ResumeOperation =
+                meta::ConnectResult<decltype(schedule(di::declval<TrampolineScheduler>())), ResumeReceiver>;
+
+        public:
+            explicit Type(SpscRingChannel* channel, Buffer buffer, Rec receiver)
+                : m_channel(channel), m_buffer(buffer), m_receiver(util::move(receiver)) {}
+
+            void wake() override {
+                m_resume_operation.emplace(util::DeferConstruct([&] {
+                    return connect(schedule(TrampolineScheduler {}), ResumeReceiver { this });
+                }));
+                start(*m_resume_operation);
+            }
+
+        private:
+            void attempt() {
+                auto& ring = m_channel->m_ring;
+                if constexpr (is_read) {
+                    auto nread = ring.try_read(m_buffer);
+                    if (nread == 0 && !m_buffer.empty() && !ring.closed()) {
+                        if (ring.park_reader()) {
+                            m_channel->m_parked_reader = this;
+                            return;
+                        }
+                        return attempt();
+                    }
+                    m_channel->wake_writer();
+                    set_value(util::move(m_receiver), nread);
+                } else {
+                    auto nwritten = ring.try_write(m_buffer);
+                    if (nwritten == 0 && !m_buffer.empty() && !ring.closed()) {
+                        if (ring.park_writer()) {
+                            m_channel->m_parked_writer = this;
+                            return;
+                        }
+                        return attempt();
+                    }
+                    m_channel->wake_reader();
+                    set_value(util::move(m_receiver), nwritten);
+                }
+            }
+
+            friend void tag_invoke(types::Tag<start>, Type& self) { self.attempt(); }
+
+            SpscRingChannel* m_channel;
+            Buffer m_buffer;
+            [[no_unique_address]] Rec m_receiver;
+            Optional<ResumeOperation> m_resume_operation;
+        };
+    };
+
+    template<bool is_read, typename Rec>
+    using OperationState = meta::Type<OperationStateT<is_read, Rec>>;
+
+    template<bool is_read>
+    struct Sender {
+        using is_sender = void;
+
+        using CompletionSignatures = types::CompletionSignatures<SetValue(usize)>;
+
+        using Buffer = meta::Conditional<is_read, Span<byte>, Span<byte const>>;
+
+        SpscRingChannel* channel;
+        Buffer buffer;
+
+    private:
+        template<concepts::ReceiverOf<CompletionSignatures> Rec>
+        friend auto tag_invoke(types::Tag<connect>, Sender self, Rec receiver) {
+            return OperationState<is_read, Rec> { self.channel, self.buffer, util::move(receiver) };
+        }
+    };
+
+public:
+    explicit SpscRingChannel(SpscByteRing ring) : m_ring(ring) {}
+
+    auto ring() -> SpscByteRing& { return m_ring; }
+
+    /// @brief Stop writing to the channel. The reader observes end of file once the remaining data has been read.
+    void close() {
+        m_ring.close();
+        wake_reader();
+    }
+
+private:
+    void wake_reader() {
+        if (m_ring.reader_parked() && m_parked_reader) {
+            m_ring.unpark_reader();
+            util::exchange(m_parked_reader, nullptr)->wake();
+        }
+    }
+
+    void wake_writer() {
+        if (m_ring.writer_parked() && m_parked_writer) {
+            m_ring.unpark_writer();
+            util::exchange(m_parked_writer, nullptr)->wake();
+        }
+    }
+
+    friend auto tag_invoke(types::Tag<async_read_some>, SpscRingChannel& self, Span<byte> buffer, Optional<u64>) {
+        return Sender<true> { util::addressof(self), buffer };
+    }
+
+    friend auto tag_invoke(types::Tag<async_write_some>, SpscRingChannel& self, Span<byte const> buffer,
+                           Optional<u64>) {
+        return Sender<false> { util::addressof(self), buffer };
+    }
+
+    SpscByteRing m_ring;
+    WaiterBase* m_parked_reader { nullptr };
+    WaiterBase* m_parked_writer { nullptr };
+};
+}
+
+namespace di {
+using execution::SpscRingChannel;
+}
@@ -32,6 +32,7 @@
 #include "di/meta/util.h"
 #include "di/platform/compiler.h"
 #include "di/sync/atomic.h"
+#include "di/sync/cache_padded.h"
 #include "di/sync/memory_order.h"
 #include "di/sync/stop_token/in_place_stop_source.h"
 #include "di/sync/stop_token/in_place_stop_token.h"
@@ -50,7 +51,9 @@ namespace counting_scope_ns {
         struct Type {
             [[no_unique_address]] Alloc alloc;
             sync::InPlaceStopSource stop_source;
-            sync::Atomic<usize> count { 1 };
+            // The scope is often stored in an operation state, which may live in a coroutine frame, so the count is
+            // isolated by padding alone.
+            sync::CacheIsolated<sync::Atomic<usize>> count { 1 };
             function::Function<void()> did_complete;
 
             template<typename Env = EmptyEnv>
@@ -58,12 +61,12 @@ namespace counting_scope_ns {
                 return make_env(env, with(get_allocator, alloc), with(get_stop_token, stop_source.get_stop_token()));
             }
 
-            void start_one() { count.fetch_add(1, sync::MemoryOrder::Relaxed); }
+            void start_one() { count->fetch_add(1, sync::MemoryOrder::Relaxed); }
 
             void complete_one() {
                 // The count variable starts at 1, because the cleanup action must start before we call the did_complete
                 // function.
-                auto old_count = count.fetch_sub(1, sync::MemoryOrder::AcquireRelease);
+                auto old_count = count->fetch_sub(1, sync::MemoryOrder::AcquireRelease);
                 if (old_count == 1) {
                     did_complete();
                 }
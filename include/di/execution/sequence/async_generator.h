@@ -2,6 +2,7 @@
 
 #include "di/assert/assert_bool.h"
 #include "di/execution/algorithm/just.h"
+#include "di/execution/coroutine/frame_allocator.h"
 #include "di/execution/coroutine/with_awaitable_senders.h"
 #include "di/execution/sequence/async_range.h"
 #include "di/execution/sequence/sequence_sender.h"
@@ -33,16 +34,15 @@ namespace async_generator_ns {
 
     template<typename Self, typename Ref, typename Value>
     struct PromiseBaseT {
-        struct Type : WithAwaitableSenders<Self> {
+        struct Type
+            : WithAwaitableSenders<Self>
+            , WithFrameAllocator {
             using PromiseBase = Type;
             using Yield = GeneratorYield<Ref>;
 
         public:
             Type() = default;
 
-            auto operator new(usize size) noexcept -> void* { return ::operator new(size, std::nothrow); }
-            void operator delete(void* ptr, usize size) noexcept { ::operator delete(ptr, size); }
-
             auto initial_suspend() noexcept -> SuspendAlways { return {}; }
             auto final_suspend() noexcept { return FinalAwaiter {}; }
 
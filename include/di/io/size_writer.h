@@ -9,7 +9,7 @@ private:
     using Result = vocab::Result<U>;
 
 public:
-    auto written() const { return m_written; }
+    constexpr auto written() const { return m_written; }
 
     constexpr auto write_some(Span<byte const> bytes) -> Result<usize> {
         m_written += bytes.size();
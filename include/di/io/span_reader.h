@@ -0,0 +1,62 @@
+#pragma once
+
+#include "di/container/algorithm/copy.h"
+#include "di/container/algorithm/min.h"
+#include "di/meta/core.h"
+#include "di/platform/prelude.h"
+#include "di/types/byte.h"
+#include "di/types/integers.h"
+#include "di/vocab/error/prelude.h"
+#include "di/vocab/span/prelude.h"
+
+namespace di::io {
+/// @brief A reader which reads directly from a span of bytes.
+///
+/// Besides the normal reader interface, this allows borrowing bytes directly out of the underlying span. Deserializers
+/// use this to produce views which refer to the original data instead of copying it.
+class SpanReader {
+public:
+    SpanReader() = default;
+
+    constexpr explicit SpanReader(vocab::Span<byte const> data) : m_data(data) {}
+
+    constexpr auto read_some(vocab::Span<byte> bytes) -> vocab::Result<usize> {
+        auto to_read = container::min(bytes.size(), m_data.size());
+        container::copy(*m_data.first(to_read), bytes.data());
+        m_data = *m_data.subspan(to_read);
+        return to_read;
+    }
+
+    /// @brief Borrow the next `count` bytes, which remain valid for as long as the underlying data.
+    constexpr auto borrow(usize count) -> vocab::Result<vocab::Span<byte const>> {
+        auto result = m_data.first(count);
+        if (!result) {
+            return vocab::Unexpected(BasicError::ResultOutOfRange);
+        }
+        m_data = *m_data.subspan(count);
+        return *result;
+    }
+
+    constexpr auto remaining() const -> vocab::Span<byte const> { return m_data; }
+
+private:
+    vocab::Span<byte const> m_data;
+};
+}
+
+namespace di::concepts {
+template<typename T>
+concept BorrowingReader = requires(meta::RemoveReference<T>& reader, usize count) {
+    { reader.borrow(count) } -> SameAs<vocab::Result<vocab::Span<byte const>>>;
+};
+
+/// A borrowing reader which can also expose all of its remaining data, so that it can be parsed in place.
+template<typename T>
+concept SpanBackedReader = BorrowingReader<T> && requires(meta::RemoveReference<T> const& reader) {
+    { reader.remaining() } -> SameAs<vocab::Span<byte const>>;
+};
+}
+
+namespace di {
+using io::SpanReader;
+}
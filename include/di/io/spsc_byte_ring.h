@@ -0,0 +1,203 @@
+#pragma once
+
+#include "di/bit/operation/bit_floor.h"
+#include "di/container/algorithm/copy.h"
+#include "di/container/algorithm/min.h"
+#include "di/platform/interference_size.h"
+#include "di/sync/atomic.h"
+#include "di/sync/memory_order.h"
+#include "di/types/byte.h"
+#include "di/types/integers.h"
+#include "di/util/construct_at.h"
+#include "di/vocab/optional/prelude.h"
+#include "di/vocab/span/prelude.h"
+
+namespace di::io {
+/// @brief The shared state of a SpscByteRing.
+///
+/// This lives at the start of the ring's memory, which may be shared between processes. So it only contains lock-free
+/// atomics, and positions are stored as offsets rather than pointers. The read and write positions are placed on
+/// separate cache lines, so that the producer and consumer do not contend with each other.
+struct SpscByteRingHeader {
+    alignas(platform::hardware_destructive_interference_size) sync::Atomic<u64> read_position { 0 };
+    alignas(platform::hardware_destructive_interference_size) sync::Atomic<u64> write_position { 0 };
+
+    // These are 32 bit so that they can be used directly as futex words.
+    alignas(platform::hardware_destructive_interference_size) sync::Atomic<u32> reader_parked { 0 };
+    sync::Atomic<u32> writer_parked { 0 };
+    sync::Atomic<u32> closed { 0 };
+};
+
+static_assert(sizeof(sync::Atomic<u32>) == sizeof(u32));
+
+/// @brief A single-producer single-consumer ring of bytes.
+///
+/// The ring is stored in caller provided memory, starting with a SpscByteRingHeader, followed by the data. Since it
+/// contains no pointers, the memory can be a shared mapping, with the producer and consumer in different processes.
+///
+/// Neither side ever blocks. Instead, when the ring is empty (or full), a side can park itself, which records that it
+/// must be woken up once the other side makes progress. This way, the (potentially expensive) wake up is only needed
+/// when the peer is actually parked. How to sleep and wake up is left to the user, for instance using a futex on the
+/// parked flag, or a socket which the peer writes to (see SharedRingChannel).
+///
+/// @note The positions are updated using sequentially consistent stores, which ensures that a side which parks itself
+/// either observes the other side's progress, or the other side observes that it is parked.
+///
+/// @note Each side trusts only its own position. If the positions are ever more than the capacity apart, the header
+/// was corrupted (or the peer is misbehaving), so the ring is treated as closed and no more data is transferred.
+class SpscByteRing {
+public:
+    SpscByteRing() = default;
+
+    /// @brief Initialize a new ring in the given memory.
+    ///
+    /// The memory must be aligned to alignof(SpscByteRingHeader). The capacity is the largest power of 2 which fits
+    /// after the header. Returns nullopt if the memory is too small.
+    static auto create(Span<byte> memory) -> Optional<SpscByteRing> {
+        auto ring = attach(memory);
+        if (ring) {
+            util::construct_at(ring->m_header);
+        }
+        return ring;
+    }
+
+    /// @brief Attach to a ring previously initialized by create(), possibly from another process.
+    static auto attach(Span<byte> memory) -> Optional<SpscByteRing> {
+        if (memory.size() <= sizeof(SpscByteRingHeader)) {
+            return nullopt;
+        }
+        auto capacity = bit::bit_floor(memory.size() - sizeof(SpscByteRingHeader));
+        return SpscByteRing(reinterpret_cast<SpscByteRingHeader*>(memory.data()),
+                            memory.data() + sizeof(SpscByteRingHeader), capacity);
+    }
+
+    auto capacity() const -> usize { return m_capacity; }
+
+    /// @name Producer
+    /// @{
+    auto writable() const -> usize {
+        auto write = m_header->write_position.load(sync::MemoryOrder::Relaxed);
+        auto read = m_header->read_position.load(sync::MemoryOrder::SequentialConsistency);
+        auto used = in_use(read, write);
+        return used ? m_capacity - *used : 0;
+    }
+
+    /// @brief Write as much of data as fits, returning the number of bytes written.
+    auto try_write(Span<byte const> data) -> usize {
+        auto write = m_header->write_position.load(sync::MemoryOrder::Relaxed);
+        auto count = container::min(data.size(), writable());
+
+        auto offset = usize(write) & (m_capacity - 1);
+        auto first = container::min(count, m_capacity - offset);
+        container::copy(data.data(), data.data() + first, m_data + offset);
+        container::copy(data.data() + first, data.data() + count, m_data);
+
+        m_header->write_position.store(write + count, sync::MemoryOrder::SequentialConsistency);
+        return count;
+    }
+
+    /// @brief Whether the consumer must be woken up after writing.
+    auto reader_parked() const -> bool {
+        return m_header->reader_parked.load(sync::MemoryOrder::SequentialConsistency) != 0;
+    }
+
+    /// @brief Record that the producer is about to wait for space.
+    ///
+    /// Returns false if space became available (or the ring was closed) in the mean time, in which case the producer
+    /// must not wait.
+    auto park_writer() -> bool {
+        m_header->writer_parked.store(1, sync::MemoryOrder::SequentialConsistency);
+        if (writable() > 0 || closed()) {
+            m_header->writer_parked.store(0, sync::MemoryOrder::Relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    void unpark_writer() { m_header->writer_parked.store(0, sync::MemoryOrder::Relaxed); }
+
+    /// @brief The producer's parked flag, which is 1 while parked, as a 32 bit word to sleep on.
+    auto writer_parked_word() const -> u32 const* { return reinterpret_cast<u32 const*>(&m_header->writer_parked); }
+
+    /// @brief Indicate that no more data will be written. Once the ring is drained, the consumer observes end of file.
+    void close() { m_header->closed.store(1, sync::MemoryOrder::SequentialConsistency); }
+    /// @}
+
+    /// @name Consumer
+    /// @{
+    auto readable() const -> usize {
+        auto read = m_header->read_position.load(sync::MemoryOrder::Relaxed);
+        auto write = m_header->write_position.load(sync::MemoryOrder::SequentialConsistency);
+        return in_use(read, write).value_or(0);
+    }
+
+    /// @brief Read as much data as is available, returning the number of bytes read.
+    auto try_read(Span<byte> data) -> usize {
+        auto read = m_header->read_position.load(sync::MemoryOrder::Relaxed);
+        auto count = container::min(data.size(), readable());
+
+        auto offset = usize(read) & (m_capacity - 1);
+        auto first = container::min(count, m_capacity - offset);
+        container::copy(m_data + offset, m_data + offset + first, data.data());
+        container::copy(m_data, m_data + (count - first), data.data() + first);
+
+        m_header->read_position.store(read + count, sync::MemoryOrder::SequentialConsistency);
+        return count;
+    }
+
+    /// @brief Whether the producer must be woken up after reading.
+    auto writer_parked() const -> bool {
+        return m_header->writer_parked.load(sync::MemoryOrder::SequentialConsistency) != 0;
+    }
+
+    /// @brief Record that the consumer is about to wait for data.
+    ///
+    /// Returns false if data became available (or the ring was closed) in the mean time, in which case the consumer
+    /// must not wait.
+    auto park_reader() -> bool {
+        m_header->reader_parked.store(1, sync::MemoryOrder::SequentialConsistency);
+        if (readable() > 0 || closed()) {
+            m_header->reader_parked.store(0, sync::MemoryOrder::Relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    void unpark_reader() { m_header->reader_parked.store(0, sync::MemoryOrder::Relaxed); }
+
+    /// @brief The consumer's parked flag, which is 1 while parked, as a 32 bit word to sleep on.
+    auto reader_parked_word() const -> u32 const* { return reinterpret_cast<u32 const*>(&m_header->reader_parked); }
+
+    /// @brief Whether the producer closed the ring, or the ring's positions are out of range.
+    auto closed() const -> bool {
+        if (m_header->closed.load(sync::MemoryOrder::SequentialConsistency) != 0) {
+            return true;
+        }
+        auto read = m_header->read_position.load(sync::MemoryOrder::SequentialConsistency);
+        auto write = m_header->write_position.load(sync::MemoryOrder::SequentialConsistency);
+        return !in_use(read, write);
+    }
+    /// @}
+
+private:
+    explicit SpscByteRing(SpscByteRingHeader* header, byte* data, usize capacity)
+        : m_header(header), m_data(data), m_capacity(capacity) {}
+
+    // The number of bytes written but not yet read, or nullopt if the positions are out of range.
+    auto in_use(u64 read, u64 write) const -> Optional<usize> {
+        if (write - read > m_capacity) {
+            return nullopt;
+        }
+        return usize(write - read);
+    }
+
+    SpscByteRingHeader* m_header { nullptr };
+    byte* m_data { nullptr };
+    usize m_capacity { 0 };
+};
+}
+
+namespace di {
+using io::SpscByteRing;
+using io::SpscByteRingHeader;
+}
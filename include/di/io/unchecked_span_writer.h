@@ -0,0 +1,56 @@
+#pragma once
+
+#include "di/assert/assert_bool.h"
+#include "di/container/algorithm/copy.h"
+#include "di/meta/core.h"
+#include "di/types/byte.h"
+#include "di/types/integers.h"
+#include "di/vocab/error/result.h"
+#include "di/vocab/span/prelude.h"
+
+namespace di::io {
+/// @brief A writer which copies directly into a span of bytes, without checking for space.
+///
+/// This is meant for serializing into storage which was already sized using `serialize_size()`. Writes never fail, and
+/// writing past the end of the span is a precondition violation rather than an error. Serializers detect this writer
+/// using the `UncheckedWriter` concept, and then copy each value directly instead of going through `write_exactly()`.
+class UncheckedSpanWriter {
+public:
+    UncheckedSpanWriter() = default;
+
+    constexpr explicit UncheckedSpanWriter(vocab::Span<byte> data) : m_data(data) {}
+
+    constexpr void write_unchecked(vocab::Span<byte const> bytes) {
+        DI_ASSERT(bytes.size() <= m_data.size() - m_written);
+        if consteval {
+            container::copy(bytes, m_data.data() + m_written);
+        } else {
+            __builtin_memcpy(m_data.data() + m_written, bytes.data(), bytes.size());
+        }
+        m_written += bytes.size();
+    }
+
+    constexpr auto write_some(vocab::Span<byte const> bytes) -> vocab::Result<usize> {
+        write_unchecked(bytes);
+        return bytes.size();
+    }
+    constexpr static auto flush() -> vocab::Result<> { return {}; }
+
+    constexpr auto written() const -> usize { return m_written; }
+
+private:
+    vocab::Span<byte> m_data;
+    usize m_written { 0 };
+};
+}
+
+namespace di::concepts {
+template<typename T>
+concept UncheckedWriter = requires(meta::RemoveReference<T>& writer, vocab::Span<byte const> bytes) {
+    { writer.write_unchecked(bytes) } -> SameAs<void>;
+};
+}
+
+namespace di {
+using io::UncheckedSpanWriter;
+}
@@ -6,6 +6,7 @@
 #include "di/container/allocator/forward_declaration.h"
 #include "di/platform/default_generic_domain.h"
 #include "di/sync/dumb_spinlock.h"
+#include "di/sync/mutex.h"
 
 namespace di::platform {
 using ThreadId = int;
@@ -14,7 +15,13 @@ inline auto get_current_thread_id() -> ThreadId {
     return 0;
 }
 
+// Mutex sleeps using the atomic wait primitive, which freestanding builds only have on Linux, or when it is provided
+// by the environment.
+#if defined(__linux__) || defined(DI_CUSTOM_ATOMIC_WAIT)
+using DefaultLock = di::sync::Mutex;
+#else
 using DefaultLock = di::sync::DumbSpinlock;
+#endif
 using DefaultAllocator = container::InfallibleAllocator;
 using DefaultFallibleAllocator = container::FallibleAllocator;
 }
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "di/platform/architecture.h"
+#include "di/types/integers.h"
+
+namespace di::platform {
+// The minimum offset between two objects to avoid false sharing. On x86_64, the spatial prefetcher pulls in cache lines
+// in pairs, and many arm64 cores have 128 byte cache lines, so both use twice the usual 64 byte cache line size.
+#if defined(DI_X86_64) || defined(DI_ARM64)
+constexpr inline usize hardware_destructive_interference_size = 128;
+#else
+constexpr inline usize hardware_destructive_interference_size = 64;
+#endif
+
+// The maximum size of contiguous memory which is guaranteed to share a cache line.
+constexpr inline usize hardware_constructive_interference_size = 64;
+}
+
+namespace di {
+using platform::hardware_constructive_interference_size;
+using platform::hardware_destructive_interference_size;
+}
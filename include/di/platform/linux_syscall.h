@@ -0,0 +1,296 @@
+#pragma once
+
+#include "di/platform/architecture.h"
+#include "di/types/byte.h"
+#include "di/types/integers.h"
+
+// NOTE: this header provides the minimal system call support needed to implement di's platform
+//       dependent functionality (like clocks) in DI_NO_USE_STD builds running on Linux. A
+//       real user space library built on top of di will provide far richer platform support.
+#ifdef __linux__
+namespace di::platform::linux_syscall {
+enum class Number : long {
+#ifdef DI_X86_64
+    Accept4 = 288,
+    Bind = 49,
+    ClockGettime = 228,
+    Close = 3,
+    Connect = 42,
+    EpollCreate1 = 291,
+    EpollCtl = 233,
+    EpollPwait = 281,
+    Eventfd2 = 290,
+    Fcntl = 72,
+    Fstat = 5,
+    Ftruncate = 77,
+    Futex = 202,
+    Listen = 50,
+    MemfdCreate = 319,
+    Mmap = 9,
+    Munmap = 11,
+    Read = 0,
+    Sendto = 44,
+    Socket = 41,
+    Socketpair = 53,
+    Write = 1,
+#elifdef DI_ARM64
+    Accept4 = 242,
+    Bind = 200,
+    ClockGettime = 113,
+    Close = 57,
+    Connect = 203,
+    EpollCreate1 = 20,
+    EpollCtl = 21,
+    EpollPwait = 22,
+    Eventfd2 = 19,
+    Fcntl = 25,
+    Fstat = 80,
+    Ftruncate = 46,
+    Futex = 98,
+    Listen = 201,
+    MemfdCreate = 279,
+    Mmap = 222,
+    Munmap = 215,
+    Read = 63,
+    Sendto = 206,
+    Socket = 198,
+    Socketpair = 199,
+    Write = 64,
+#endif
+};
+
+struct Timespec {
+    i64 seconds;
+    long nanoseconds;
+};
+
+constexpr inline int clock_realtime = 0;
+constexpr inline int clock_monotonic = 1;
+
+constexpr inline int futex_wait_shared = 0;
+constexpr inline int futex_wake_shared = 1;
+constexpr inline int futex_wait_private = 128;
+constexpr inline int futex_wake_private = 129;
+
+constexpr inline unsigned mfd_cloexec = 1;
+constexpr inline unsigned mfd_allow_sealing = 2;
+
+constexpr inline int prot_read = 1;
+constexpr inline int prot_write = 2;
+constexpr inline int map_shared = 1;
+
+constexpr inline int epoll_ctl_add = 1;
+constexpr inline int epoll_ctl_delete = 2;
+constexpr inline u32 epoll_in = 0x1;
+constexpr inline u32 epoll_out = 0x4;
+constexpr inline u32 epoll_error = 0x8;
+constexpr inline u32 epoll_hang_up = 0x10;
+constexpr inline u32 epoll_read_hang_up = 0x2000;
+constexpr inline u32 epoll_edge_triggered = u32(1) << 31;
+
+// The kernel packs this structure on x86_64 only.
+#ifdef DI_X86_64
+struct [[gnu::packed]] EpollEvent {
+#else
+struct EpollEvent {
+#endif
+    u32 events;
+    u64 data;
+};
+
+constexpr inline int o_nonblock = 0x800;
+constexpr inline int o_cloexec = 0x80000;
+constexpr inline int f_getfl = 3;
+constexpr inline int f_setfl = 4;
+constexpr inline int f_add_seals = 1033;
+constexpr inline int f_get_seals = 1034;
+constexpr inline int f_seal_seal = 1;
+constexpr inline int f_seal_shrink = 2;
+constexpr inline int f_seal_grow = 4;
+
+constexpr inline int address_family_unix = 1;
+constexpr inline int address_family_ipv4 = 2;
+constexpr inline int socket_stream = 1;
+constexpr inline int msg_no_signal = 0x4000;
+
+constexpr inline long error_interrupted = 4;
+constexpr inline long error_try_again = 11;
+constexpr inline long error_no_memory = 12;
+constexpr inline long error_range = 34;
+constexpr inline long error_overflow = 75;
+constexpr inline long error_not_socket = 88;
+constexpr inline long error_is_connected = 106;
+constexpr inline long error_already = 114;
+constexpr inline long error_in_progress = 115;
+constexpr inline long error_cancelled = 125;
+
+// System calls report failure by returning a negated errno value.
+constexpr inline auto is_error(long result) -> bool {
+    return result < 0 && result > -4096;
+}
+
+inline auto raw_syscall(Number number, long a1 = 0, long a2 = 0, long a3 = 0, long a4 = 0, long a5 = 0, long a6 = 0)
+    -> long {
+#ifdef DI_X86_64
+    register long r10 asm("r10") = a4;
+    register long r8 asm("r8") = a5;
+    register long r9 asm("r9") = a6;
+
+    long result;
+    asm volatile("syscall"
+                 : "=a"(result)
+                 : "a"(static_cast<long>(number)), "D"(a1), "S"(a2), "d"(a3), "r"(r10), "r"(r8), "r"(r9)
+                 : "rcx", "r11", "memory");
+    return result;
+#elifdef DI_ARM64
+    register long x8 asm("x8") = static_cast<long>(number);
+    register long x0 asm("x0") = a1;
+    register long x1 asm("x1") = a2;
+    register long x2 asm("x2") = a3;
+    register long x3 asm("x3") = a4;
+    register long x4 asm("x4") = a5;
+    register long x5 asm("x5") = a6;
+
+    asm volatile("svc 0" : "+r"(x0) : "r"(x8), "r"(x1), "r"(x2), "r"(x3), "r"(x4), "r"(x5) : "memory");
+    return x0;
+#else
+#error "Unsupported architecture for raw Linux system calls"
+#endif
+}
+
+inline auto clock_gettime(int clock) -> Timespec {
+    auto result = Timespec {};
+    raw_syscall(Number::ClockGettime, clock, reinterpret_cast<long>(&result));
+    return result;
+}
+
+// Sleep until woken, provided *address still equals expected. Spurious wake ups are possible, so callers must recheck
+// their condition after this returns.
+inline void futex_wait(u32 const* address, u32 expected) {
+    raw_syscall(Number::Futex, reinterpret_cast<long>(address), futex_wait_private, long(expected));
+}
+
+inline void futex_wake(u32 const* address, int count) {
+    raw_syscall(Number::Futex, reinterpret_cast<long>(address), futex_wake_private, count);
+}
+
+// The same as futex_wait() and futex_wake(), except the address may be in memory shared with other processes.
+inline void futex_wait_across_processes(u32 const* address, u32 expected) {
+    raw_syscall(Number::Futex, reinterpret_cast<long>(address), futex_wait_shared, long(expected));
+}
+
+inline void futex_wake_across_processes(u32 const* address, int count) {
+    raw_syscall(Number::Futex, reinterpret_cast<long>(address), futex_wake_shared, count);
+}
+
+inline auto memfd_create(char const* name, unsigned flags) -> long {
+    return raw_syscall(Number::MemfdCreate, reinterpret_cast<long>(name), long(flags));
+}
+
+inline auto ftruncate(int fd, usize length) -> long {
+    return raw_syscall(Number::Ftruncate, fd, long(length));
+}
+
+// Returns the address of the mapping, or a negated errno value.
+inline auto mmap_shared(int fd, usize length) -> long {
+    return raw_syscall(Number::Mmap, 0, long(length), prot_read | prot_write, map_shared, fd, 0);
+}
+
+inline auto munmap(void* address, usize length) -> long {
+    return raw_syscall(Number::Munmap, reinterpret_cast<long>(address), long(length));
+}
+
+// Returns the size of the file, or a negated errno value. The size is at the same offset in struct stat on every
+// supported architecture, so the rest of the structure is left uninterpreted.
+inline auto file_size(int fd) -> long {
+    i64 words[18] {};
+    auto result = raw_syscall(Number::Fstat, fd, reinterpret_cast<long>(words));
+    return is_error(result) ? result : long(words[6]);
+}
+
+// Seals only apply to memfds created with mfd_allow_sealing.
+inline auto add_seals(int fd, int seals) -> long {
+    return raw_syscall(Number::Fcntl, fd, f_add_seals, seals);
+}
+
+// Returns the seals applied to the file, or a negated errno value.
+inline auto get_seals(int fd) -> long {
+    return raw_syscall(Number::Fcntl, fd, f_get_seals);
+}
+
+inline auto close(int fd) -> long {
+    return raw_syscall(Number::Close, fd);
+}
+
+inline auto read(int fd, byte* data, usize size) -> long {
+    return raw_syscall(Number::Read, fd, reinterpret_cast<long>(data), long(size));
+}
+
+inline auto write(int fd, byte const* data, usize size) -> long {
+    return raw_syscall(Number::Write, fd, reinterpret_cast<long>(data), long(size));
+}
+
+// Writes to a socket, without raising SIGPIPE if the peer has gone away.
+inline auto send(int fd, byte const* data, usize size) -> long {
+    return raw_syscall(Number::Sendto, fd, reinterpret_cast<long>(data), long(size), msg_no_signal, 0, 0);
+}
+
+inline auto set_nonblocking(int fd) -> long {
+    auto flags = raw_syscall(Number::Fcntl, fd, f_getfl);
+    if (is_error(flags)) {
+        return flags;
+    }
+    return raw_syscall(Number::Fcntl, fd, f_setfl, flags | o_nonblock);
+}
+
+inline auto eventfd(unsigned initial_value) -> long {
+    return raw_syscall(Number::Eventfd2, long(initial_value), o_cloexec | o_nonblock);
+}
+
+inline auto epoll_create() -> long {
+    return raw_syscall(Number::EpollCreate1, o_cloexec);
+}
+
+inline auto epoll_add(int epoll_fd, int fd, EpollEvent event) -> long {
+    return raw_syscall(Number::EpollCtl, epoll_fd, epoll_ctl_add, fd, reinterpret_cast<long>(&event));
+}
+
+inline auto epoll_delete(int epoll_fd, int fd) -> long {
+    auto event = EpollEvent {};
+    return raw_syscall(Number::EpollCtl, epoll_fd, epoll_ctl_delete, fd, reinterpret_cast<long>(&event));
+}
+
+// Returns the number of events, or a negated errno value. A negative timeout waits forever.
+inline auto epoll_wait(int epoll_fd, EpollEvent* events, int count, int timeout_milliseconds) -> long {
+    return raw_syscall(Number::EpollPwait, epoll_fd, reinterpret_cast<long>(events), count, timeout_milliseconds, 0);
+}
+
+inline auto socket(int domain, int type, int protocol) -> long {
+    return raw_syscall(Number::Socket, domain, type | o_nonblock | o_cloexec, protocol);
+}
+
+// Creates a pair of connected, non-blocking sockets, storing their file descriptors in fds.
+inline auto socketpair(int domain, int type, int protocol, int (&fds)[2]) -> long {
+    auto const flags = type | o_nonblock | o_cloexec;
+    return raw_syscall(Number::Socketpair, domain, flags, protocol, reinterpret_cast<long>(fds));
+}
+
+// The address is a struct sockaddr of the given length.
+inline auto bind(int fd, byte const* address, u32 length) -> long {
+    return raw_syscall(Number::Bind, fd, reinterpret_cast<long>(address), long(length));
+}
+
+inline auto listen(int fd, int backlog) -> long {
+    return raw_syscall(Number::Listen, fd, backlog);
+}
+
+inline auto accept(int fd) -> long {
+    return raw_syscall(Number::Accept4, fd, 0, 0, o_nonblock | o_cloexec);
+}
+
+inline auto connect(int fd, byte const* address, u32 length) -> long {
+    return raw_syscall(Number::Connect, fd, reinterpret_cast<long>(address), long(length));
+}
+
+}
+#endif
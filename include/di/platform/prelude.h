@@ -1,6 +1,7 @@
 #pragma once
 
 #include "di/platform/custom.h"
+#include "di/platform/interference_size.h"
 
 namespace di {
 using platform::BasicError;
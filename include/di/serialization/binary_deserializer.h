@@ -2,15 +2,24 @@
 
 #include "di/container/action/sequence_to.h"
 #include "di/container/action/to.h"
+#include "di/container/algorithm/max.h"
+#include "di/container/algorithm/min.h"
 #include "di/container/concepts/container.h"
+#include "di/container/interface/data.h"
+#include "di/container/interface/size.h"
 #include "di/container/meta/container_value.h"
+#include "di/container/string/encoding.h"
 #include "di/container/string/string_impl_forward_declaration.h"
+#include "di/container/string/string_view_impl_forward_declaration.h"
+#include "di/container/vector/mutable_vector.h"
 #include "di/container/view/range.h"
 #include "di/container/view/transform.h"
 #include "di/function/index_dispatch.h"
 #include "di/function/monad/monad_try.h"
 #include "di/io/interface/reader.h"
 #include "di/io/read_exactly.h"
+#include "di/io/span_reader.h"
+#include "di/math/numeric_limits.h"
 #include "di/meta/constexpr.h"
 #include "di/meta/core.h"
 #include "di/meta/language.h"
@@ -19,18 +28,87 @@
 #include "di/serialization/binary_serializer.h"
 #include "di/serialization/deserialize.h"
 #include "di/types/byte.h"
+#include "di/types/char.h"
 #include "di/types/in_place_type.h"
 #include "di/types/integers.h"
 #include "di/util/create.h"
 #include "di/util/declval.h"
 #include "di/util/reference_wrapper.h"
+#include "di/util/unwrap_reference.h"
 #include "di/vocab/array/array.h"
 #include "di/vocab/expected/expected_forward_declaration.h"
+#include "di/vocab/expected/invoke_as_fallible.h"
+#include "di/vocab/span/span_forward_declaration.h"
 #include "di/vocab/tuple/tuple_like.h"
 #include "di/vocab/variant/variant_alternative.h"
 #include "di/vocab/variant/variant_like.h"
 
 namespace di::serialization {
+namespace detail {
+    template<typename T>
+    constexpr inline bool borrowed_span = false;
+
+    // Only types for which any byte is a valid value can be viewed in place. A bool or an enum read from untrusted data
+    // may hold a value which is not valid for its type.
+    template<typename T>
+    requires(concepts::OneOf<T, byte, char, c8, u8, i8>)
+    constexpr inline bool borrowed_span<Span<T const>> = true;
+
+    template<typename T>
+    concept BorrowedView = borrowed_span<T> || (concepts::InstanceOf<T, container::string::StringViewImpl> &&
+                                                sizeof(meta::EncodingCodeUnit<meta::Encoding<T>>) == 1);
+
+    // read_exactly() treats a reader which runs out of data as broken. But data read from a span may just be truncated,
+    // so check that enough of it is left first.
+    template<typename Reader>
+    constexpr auto read_all(Reader& reader, Span<byte> data) -> meta::ReaderResult<void, Reader> {
+        if constexpr (concepts::SpanBackedReader<meta::UnwrapReference<Reader>>) {
+            if (util::unwrap_reference(reader).remaining().size() < data.size()) {
+                return di::Unexpected(BasicError::ResultOutOfRange);
+            }
+        }
+        return read_exactly(reader, data);
+    }
+
+    // Reads a vector of bulk copyable values directly into its storage. Since the size was read from untrusted input,
+    // the vector's storage is grown as data actually arrives rather than all at once. Any reasonably sized container is
+    // still read using a single call to read_exactly().
+    template<typename T, typename Reader>
+    auto deserialize_bulk(Reader& reader, u64 size) -> meta::ReaderResult<T, Reader> {
+        using Value = meta::ContainerValue<T>;
+        constexpr auto max_chunk_size = usize(1024 * 1024);
+        constexpr auto max_chunk_count = container::max(max_chunk_size / sizeof(Value), usize(1));
+
+        if (size > math::NumericLimits<usize>::max / sizeof(Value)) {
+            return di::Unexpected(BasicError::ValueTooLarge);
+        }
+        if constexpr (concepts::SpanBackedReader<meta::UnwrapReference<Reader>>) {
+            if (util::unwrap_reference(reader).remaining().size() / sizeof(Value) < size) {
+                return di::Unexpected(BasicError::ResultOutOfRange);
+            }
+        }
+
+        auto result = T();
+        auto remaining = usize(size);
+        while (remaining > 0) {
+            auto const old_size = container::size(result);
+            auto const count = container::min(remaining, max_chunk_count);
+            auto const capacity = old_size == 0 ? count : result.grow_capacity(old_size + count);
+            if (!invoke_as_fallible([&] {
+                    return result.reserve(capacity);
+                })) {
+                return di::Unexpected(BasicError::NotEnoughMemory);
+            }
+
+            auto* data = reinterpret_cast<byte*>(container::data(result) + old_size);
+            DI_TRY(read_all(reader, Span<byte> { data, count * sizeof(Value) }));
+            result.assume_size(old_size + count);
+            remaining -= count;
+        }
+        return result;
+    }
+}
+
 /// @brief A deserializer for a simple binary format.
 ///
 /// @tparam Reader The type of the reader to read from.
@@ -40,6 +118,10 @@ namespace di::serialization {
 /// serialize, which includes containers, string, tuples, variants, integers,
 /// and enumerators.
 ///
+/// When the reader can borrow its underlying data (like io::SpanReader), string views and spans of bytes can be
+/// deserialized as well. These refer directly to the data being deserialized instead of copying it, and so are only
+/// valid for as long as that data.
+///
 /// @see BinarySerializer
 template<Impl<io::Reader> Reader>
 class BinaryDeserializer {
@@ -57,7 +139,7 @@ public:
     template<concepts::IntegralOrEnum T>
     constexpr auto deserialize(InPlaceType<T>) -> Result<T> {
         auto bytes = Array<byte, sizeof(T)> {};
-        DI_TRY(read_exactly(reader(), bytes.span()));
+        DI_TRY(detail::read_all(reader(), bytes.span()));
         auto const little_endian_value = di::bit_cast<LittleEndian<T>>(bytes);
         return T(little_endian_value);
     }
@@ -111,11 +193,46 @@ public:
         return util::create<Str>(di::move(vector));
     }
 
+    template<detail::BorrowedView T>
+    requires(concepts::BorrowingReader<meta::UnwrapReference<Reader>>)
+    constexpr auto deserialize(InPlaceType<T>) -> Result<T> {
+        using SizeType = u64;
+        auto const size = DI_TRY(di::deserialize<SizeType>(*this));
+        if (size > math::NumericLimits<usize>::max) {
+            return di::Unexpected(BasicError::ValueTooLarge);
+        }
+        auto const bytes = DI_TRY(util::unwrap_reference(reader()).borrow(usize(size)));
+
+        if constexpr (detail::borrowed_span<T>) {
+            using Value = meta::RemoveConst<meta::ContainerValue<T>>;
+            return T(reinterpret_cast<Value const*>(bytes.data()), bytes.size());
+        } else {
+            using Enc = meta::Encoding<T>;
+            using CodeUnit = meta::EncodingCodeUnit<Enc>;
+            auto const code_units =
+                Span<CodeUnit const> { reinterpret_cast<CodeUnit const*>(bytes.data()), bytes.size() };
+            if (!container::string::encoding::validate(Enc(), code_units)) {
+                return di::Unexpected(BasicError::InvalidArgument);
+            }
+            return T(container::string::encoding::assume_valid, code_units.data(), code_units.size());
+        }
+    }
+
     template<concepts::Container T>
-    requires(!concepts::InstanceOf<T, container::string::StringImpl>)
+    requires(!concepts::InstanceOf<T, container::string::StringImpl> && !detail::BorrowedView<T>)
     constexpr auto deserialize(InPlaceType<T>) -> Result<T> {
         using SizeType = u64;
         auto const size = DI_TRY(di::deserialize<SizeType>(*this));
+
+        // When the elements are laid out in memory exactly as they are serialized, read them directly into the vector.
+        using Value = meta::ContainerValue<T>;
+        if constexpr (concepts::detail::MutableVector<T> && detail::binary_bulk_copyable(in_place_type<Value>)) {
+            if !consteval {
+                if (detail::binary_layout_matches(in_place_type<Value>)) {
+                    return detail::deserialize_bulk<T>(reader(), size);
+                }
+            }
+        }
         return range(size) | transform([&](auto) {
                    return di::deserialize<meta::ContainerValue<T>>(*this);
                }) |
@@ -1,28 +1,49 @@
 #pragma once
 
+#include "di/bit/endian/endian.h"
 #include "di/bit/endian/little_endian.h"
 #include "di/container/action/sequence.h"
+#include "di/container/concepts/contiguous_container.h"
 #include "di/container/concepts/input_container.h"
 #include "di/container/concepts/sized_container.h"
+#include "di/container/interface/data.h"
 #include "di/container/interface/size.h"
+#include "di/container/meta/container_value.h"
 #include "di/function/monad/monad_try.h"
 #include "di/io/interface/reader.h"
 #include "di/io/interface/writer.h"
+#include "di/io/size_writer.h"
+#include "di/io/unchecked_span_writer.h"
 #include "di/io/write_exactly.h"
 #include "di/meta/language.h"
+#include "di/meta/list.h"
 #include "di/meta/operations.h"
 #include "di/meta/util.h"
+#include "di/meta/vocab.h"
 #include "di/serialization/serialize.h"
+#include "di/types/in_place_type.h"
 #include "di/types/integers.h"
+#include "di/util/addressof.h"
 #include "di/util/bit_cast.h"
 #include "di/util/to_underlying.h"
+#include "di/util/unwrap_reference.h"
 #include "di/vocab/array/array.h"
+#include "di/vocab/optional/prelude.h"
+#include "di/vocab/tuple/tuple_elements.h"
 #include "di/vocab/tuple/tuple_like.h"
 #include "di/vocab/variant/variant_like.h"
 
 namespace di::serialization {
 struct BinaryFormat;
 
+namespace detail {
+    template<typename T>
+    constexpr auto binary_bulk_copyable(InPlaceType<T>) -> bool;
+
+    template<typename T>
+    auto binary_layout_matches(InPlaceType<T>) -> bool;
+}
+
 /// @brief A serializer for a simple binary format.
 ///
 /// @tparam Writer The type of the writer to write to.
@@ -77,10 +98,16 @@ public:
     }
 
     template<concepts::IntegralOrEnum T>
-    constexpr auto serialize(T value) {
+    constexpr auto serialize(T value) -> meta::WriterResult<void, Writer> {
         auto const little_endian = LittleEndian<T>(value);
         auto const as_bytes = di::bit_cast<Array<byte, sizeof(T)>>(little_endian);
-        return io::write_exactly(writer(), as_bytes);
+        if constexpr (concepts::UncheckedWriter<meta::UnwrapReference<Writer>>) {
+            // The caller already made room for the whole value, so skip the write_exactly() loop entirely.
+            util::unwrap_reference(writer()).write_unchecked(as_bytes.span());
+            return {};
+        } else {
+            return io::write_exactly(writer(), as_bytes);
+        }
     }
 
     template<typename T, concepts::InstanceOf<reflection::Atom> M>
@@ -96,6 +123,17 @@ public:
         // NOTE: Explicitly casting to u64 allows interoperability with 32 bit systems.
         auto const size = u64(container::size(value));
         DI_TRY(di::serialize(*this, size));
+
+        // When the elements are already laid out in memory exactly as they would be serialized, write them all at once.
+        using Value = meta::RemoveCV<meta::ContainerValue<T>>;
+        if constexpr (concepts::ContiguousContainer<T> && detail::binary_bulk_copyable(in_place_type<Value>)) {
+            if !consteval {
+                if (detail::binary_layout_matches(in_place_type<Value>)) {
+                    auto const* data = reinterpret_cast<byte const*>(container::data(value));
+                    return io::write_exactly(writer(), Span<byte const> { data, usize(size) * sizeof(Value) });
+                }
+            }
+        }
         return container::sequence(value, [&](auto&& element) {
             return di::serialize(*this, element);
         });
@@ -115,6 +153,127 @@ BinarySerializer(T&&) -> BinarySerializer<T>;
 template<Impl<io::Reader> Reader>
 class BinaryDeserializer;
 
+namespace detail {
+    template<typename T>
+    constexpr auto binary_fixed_size(InPlaceType<T>) -> Optional<usize>;
+
+    template<typename... Ts>
+    constexpr auto binary_fixed_size_sum(meta::List<Ts...>) -> Optional<usize> {
+        auto total = usize(0);
+        auto fixed = true;
+        auto add = [&](Optional<usize> size) {
+            if (size) {
+                total += *size;
+            } else {
+                fixed = false;
+            }
+        };
+        (add(binary_fixed_size(in_place_type<meta::RemoveCVRef<Ts>>)), ...);
+        if (!fixed) {
+            return nullopt;
+        }
+        return total;
+    }
+
+    template<typename ClassName, typename Description, typename... Fs>
+    constexpr auto binary_fixed_size_of_fields(reflection::Fields<ClassName, Description, Fs...>) -> Optional<usize> {
+        return binary_fixed_size_sum(meta::List<typename Fs::Type...> {});
+    }
+
+    /// Computes the serialized size of a type which always serializes to the same number of bytes, which is the case
+    /// for integers, enums, and any tuple or reflected structure made up only of those. This mirrors the dispatch order
+    /// of BinarySerializer, and returns nullopt for anything else (containers, variants, strings, or custom
+    /// serializers).
+    template<typename T>
+    constexpr auto binary_fixed_size(InPlaceType<T>) -> Optional<usize> {
+        using Probe = BinarySerializer<SizeWriter>;
+        if constexpr (concepts::TagInvocable<types::Tag<serialize>, BinaryFormat, Probe&, T&>) {
+            return nullopt;
+        } else if constexpr (concepts::IntegralOrEnum<T>) {
+            return sizeof(T);
+        } else if constexpr (concepts::VariantLike<T> || concepts::SizedContainer<T>) {
+            return nullopt;
+        } else if constexpr (concepts::TupleLike<T>) {
+            return binary_fixed_size_sum(meta::TupleElements<T> {});
+        } else if constexpr (requires { typename meta::SerializeMetadata<BinaryFormat, T>; }) {
+            using M = meta::SerializeMetadata<BinaryFormat, T>;
+            if constexpr (concepts::InstanceOf<M, reflection::Fields>) {
+                return binary_fixed_size_of_fields(M {});
+            } else {
+                return nullopt;
+            }
+        } else {
+            return nullopt;
+        }
+    }
+}
+
+namespace detail {
+    template<typename ClassName, typename Description, typename... Fs>
+    constexpr auto binary_bulk_copyable_fields(reflection::Fields<ClassName, Description, Fs...>) -> bool {
+        return (binary_bulk_copyable(in_place_type<typename Fs::Type>) && ...);
+    }
+
+    /// Determines whether the in-memory representation of a type is exactly its binary encoding, so that arrays of it
+    /// can be copied as raw bytes. This holds for integers and enums on little endian hosts, as well as for reflected
+    /// structures with no padding whose fields all hold this property. Since the reflected field order need not match
+    /// the declaration order, the field offsets of structures must additionally be checked with
+    /// binary_layout_matches().
+    template<typename T>
+    constexpr auto binary_bulk_copyable(InPlaceType<T>) -> bool {
+        using Probe = BinarySerializer<SizeWriter>;
+        if constexpr (Endian::Native != Endian::Little ||
+                      concepts::TagInvocable<types::Tag<serialize>, BinaryFormat, Probe&, T&>) {
+            return false;
+        } else if constexpr (concepts::SameAs<T, bool>) {
+            // NOTE: reading arbitrary bytes into a bool is undefined behavior, so these must be converted one by one.
+            return false;
+        } else if constexpr (concepts::IntegralOrEnum<T>) {
+            return true;
+        } else if constexpr (!concepts::TriviallyCopyable<T> || !concepts::TriviallyDefaultConstructible<T> ||
+                             concepts::TupleLike<T> || concepts::VariantLike<T> || concepts::SizedContainer<T>) {
+            return false;
+        } else if constexpr (requires { typename meta::SerializeMetadata<BinaryFormat, T>; }) {
+            using M = meta::SerializeMetadata<BinaryFormat, T>;
+            if constexpr (concepts::InstanceOf<M, reflection::Fields>) {
+                auto const size = binary_fixed_size(in_place_type<T>);
+                return size && *size == sizeof(T) && binary_bulk_copyable_fields(M {});
+            } else {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+
+    template<typename T, typename ClassName, typename Description, typename... Fs>
+    auto binary_layout_matches_fields(reflection::Fields<ClassName, Description, Fs...>) -> bool {
+        // NOTE: the offsets are constants, so the optimizer folds this away entirely.
+        T object;
+        auto const* base = reinterpret_cast<byte const*>(util::addressof(object));
+        auto offset = usize(0);
+        auto matches = true;
+        auto check = [&]<typename F>(InPlaceType<F>) {
+            using Value = typename F::Type;
+            auto const* field = reinterpret_cast<byte const*>(util::addressof(F::get(object)));
+            matches = matches && usize(field - base) == offset && binary_layout_matches(in_place_type<Value>);
+            offset += sizeof(Value);
+        };
+        (check(in_place_type<Fs>), ...);
+        return matches;
+    }
+
+    /// Checks that the fields of a bulk copyable type are stored in the same order they are serialized in.
+    template<typename T>
+    auto binary_layout_matches(InPlaceType<T>) -> bool {
+        if constexpr (concepts::IntegralOrEnum<T>) {
+            return true;
+        } else {
+            return binary_layout_matches_fields<T>(meta::SerializeMetadata<BinaryFormat, T> {});
+        }
+    }
+}
+
 struct BinaryFormat {
     template<concepts::Impl<io::Writer> Writer, typename... Args>
     requires(ConstructibleFrom<BinarySerializer<meta::RemoveCVRef<Writer>>, Writer, Args...>)
@@ -127,6 +286,13 @@ struct BinaryFormat {
     constexpr static auto deserializer(Reader&& reader, Args&&... args) {
         return BinaryDeserializer<meta::RemoveCVRef<Reader>>(di::forward<Reader>(reader), di::forward<Args>(args)...);
     }
+
+    // Fixed size types don't need a dry run through a SizeWriter to compute their size.
+    template<typename T>
+    requires(detail::binary_fixed_size(in_place_type<meta::RemoveCVRef<T>>).has_value())
+    constexpr friend auto tag_invoke(types::Tag<serialize_size>, BinaryFormat, T const&) -> usize {
+        return *detail::binary_fixed_size(in_place_type<meta::RemoveCVRef<T>>);
+    }
 };
 
 constexpr inline auto binary_format = BinaryFormat {};
@@ -0,0 +1,225 @@
+#pragma once
+
+#include "di/container/action/sequence_to.h"
+#include "di/container/concepts/container.h"
+#include "di/container/interface/data.h"
+#include "di/container/meta/container_value.h"
+#include "di/container/string/string_impl_forward_declaration.h"
+#include "di/container/vector/mutable_vector.h"
+#include "di/container/view/range.h"
+#include "di/container/view/transform.h"
+#include "di/function/index_dispatch.h"
+#include "di/function/monad/monad_try.h"
+#include "di/io/interface/reader.h"
+#include "di/io/span_reader.h"
+#include "di/meta/constexpr.h"
+#include "di/meta/core.h"
+#include "di/meta/language.h"
+#include "di/meta/operations.h"
+#include "di/platform/prelude.h"
+#include "di/serialization/binary_deserializer.h"
+#include "di/serialization/compact_binary_serializer.h"
+#include "di/serialization/deserialize.h"
+#include "di/serialization/varint.h"
+#include "di/types/byte.h"
+#include "di/types/in_place_type.h"
+#include "di/types/integers.h"
+#include "di/util/create.h"
+#include "di/util/declval.h"
+#include "di/util/reference_wrapper.h"
+#include "di/util/unwrap_reference.h"
+#include "di/vocab/array/array.h"
+#include "di/vocab/expected/invoke_as_fallible.h"
+#include "di/vocab/span/span_forward_declaration.h"
+#include "di/vocab/tuple/tuple_like.h"
+#include "di/vocab/variant/variant_alternative.h"
+#include "di/vocab/variant/variant_like.h"
+
+namespace di::serialization {
+/// @brief A deserializer for the compact binary format.
+///
+/// @tparam Reader The type of the reader to read from.
+///
+/// When the reader exposes its remaining data directly (like io::SpanReader), arrays of integers are decoded in bulk
+/// with decode_varints() instead of one varint at a time.
+///
+/// @see CompactBinarySerializer
+template<Impl<io::Reader> Reader>
+class CompactBinaryDeserializer {
+public:
+    template<typename T = void>
+    using Result = meta::ReaderResult<T, Reader>;
+
+    using DeserializationFormat = CompactBinaryFormat;
+
+    template<concepts::NotDecaysTo<CompactBinaryDeserializer> T>
+    requires(ConstructibleFrom<Reader, T>)
+    // NOLINTNEXTLINE(bugprone-forwarding-reference-overload)
+    constexpr explicit CompactBinaryDeserializer(T&& reader) : m_reader(di::forward<T>(reader)) {}
+
+    template<concepts::IntegralOrEnum T>
+    constexpr auto deserialize(InPlaceType<T>) -> Result<T> {
+        if constexpr (concepts::Enum<T>) {
+            return T(DI_TRY(deserialize(in_place_type<meta::UnderlyingType<T>>)));
+        } else if constexpr (sizeof(T) == 1) {
+            auto bytes = Array<byte, 1> {};
+            DI_TRY(detail::read_all(reader(), bytes.span()));
+            if constexpr (concepts::SameAs<T, bool>) {
+                if (u8(bytes[0]) > 1) {
+                    return di::Unexpected(BasicError::InvalidArgument);
+                }
+                return u8(bytes[0]) == 1;
+            } else {
+                return T(u8(bytes[0]));
+            }
+        } else {
+            return read_varint<T>();
+        }
+    }
+
+    template<concepts::TupleLike T>
+    requires(concepts::DefaultConstructible<T>)
+    constexpr auto deserialize(InPlaceType<T>) -> Result<T> {
+        auto result = T();
+        DI_TRY(tuple_sequence<Result<void>>(
+            [&]<typename U>(U&& element) -> Result<void> {
+                element = DI_TRY(di::deserialize<meta::RemoveCVRef<U>>(*this));
+                return {};
+            },
+            result));
+        return result;
+    }
+
+    template<concepts::VariantLike T>
+    constexpr auto deserialize(InPlaceType<T>) -> Result<T> {
+        auto const index = DI_TRY(read_varint<u64>());
+        if (index >= meta::VariantSize<T>) {
+            return di::Unexpected(BasicError::InvalidArgument);
+        }
+        return function::index_dispatch<Result<T>, meta::VariantSize<T>>(
+            index, [&]<usize index>(Constexpr<index>) -> Result<T> {
+                return T(c_<index>, DI_TRY(di::deserialize<meta::VariantAlternative<T, index>>(*this)));
+            });
+    }
+
+    template<concepts::DefaultConstructible T, concepts::InstanceOf<reflection::Fields> M>
+    constexpr auto deserialize(InPlaceType<T>, M fields) -> Result<T> {
+        // NOTE: for now, this requires T be default constructible.
+        auto result = T {};
+        DI_TRY(tuple_sequence<Result<void>>(
+            [&](auto field) -> Result<void> {
+                using Value = meta::Type<decltype(field)>;
+                field.get(result) = DI_TRY(di::deserialize<Value>(*this));
+                return {};
+            },
+            fields));
+        return result;
+    }
+
+    template<concepts::InstanceOf<container::string::StringImpl> Str>
+    constexpr auto deserialize(InPlaceType<Str>) -> Result<Str> {
+        using Vec = decltype(di::declval<Str>().take_underlying_vector());
+        auto vector = DI_TRY(di::deserialize<Vec>(*this));
+
+        // NOTE: this can be fallible because the vector may contain invalid data for the encoding.
+        return util::create<Str>(di::move(vector));
+    }
+
+    template<concepts::Container T>
+    requires(!concepts::InstanceOf<T, container::string::StringImpl>)
+    constexpr auto deserialize(InPlaceType<T>) -> Result<T> {
+        auto const size = DI_TRY(read_varint<u64>());
+
+        using Value = meta::ContainerValue<T>;
+        if constexpr (concepts::detail::MutableVector<T> && concepts::Integral<Value> &&
+                      !concepts::SameAs<Value, bool>) {
+            if !consteval {
+                if constexpr (sizeof(Value) == 1) {
+                    return detail::deserialize_bulk<T>(reader(), size);
+                } else if constexpr (concepts::SpanBackedReader<meta::UnwrapReference<Reader>>) {
+                    return read_varints<T>(size);
+                }
+            }
+        }
+        return range(size) | transform([&](auto) {
+                   return di::deserialize<meta::ContainerValue<T>>(*this);
+               }) |
+               container::sequence_to<T>();
+    }
+
+    constexpr auto reader() & -> Reader& { return m_reader; }
+    constexpr auto reader() const& -> Reader const& { return m_reader; }
+    constexpr auto reader() && -> Reader&& { return util::move(*this).m_reader; }
+
+private:
+    template<concepts::Integral T>
+    constexpr auto read_varint() -> Result<T> {
+        auto buffer = Array<byte, max_varint_size<T>> {};
+        for (auto i = usize(0); i < buffer.size(); i++) {
+            DI_TRY(detail::read_all(reader(), *buffer.span().subspan(i, 1)));
+            if ((u8(buffer[i]) & 0x80) == 0) {
+                auto result = decode_varint<T>(*buffer.span().first(i + 1));
+                if (!result) {
+                    return di::Unexpected(BasicError::ValueTooLarge);
+                }
+                return di::get<0>(*result);
+            }
+        }
+        return di::Unexpected(BasicError::ValueTooLarge);
+    }
+
+    // Decodes an array of integers straight out of the reader's underlying data.
+    template<typename T>
+    auto read_varints(u64 size) -> Result<T> {
+        using Value = meta::ContainerValue<T>;
+
+        // Every varint takes at least one byte, which bounds the untrusted size by the amount of data available.
+        auto& source = util::unwrap_reference(reader());
+        auto const input = source.remaining();
+        if (size > input.size()) {
+            return di::Unexpected(BasicError::ResultOutOfRange);
+        }
+
+        auto result = T();
+        if (!invoke_as_fallible([&] {
+                return result.reserve(usize(size));
+            })) {
+            return di::Unexpected(BasicError::NotEnoughMemory);
+        }
+
+        auto const consumed = decode_varints(input, Span<Value> { container::data(result), usize(size) });
+        if (!consumed) {
+            return di::Unexpected(BasicError::InvalidArgument);
+        }
+        result.assume_size(usize(size));
+        DI_TRY(source.borrow(*consumed));
+        return result;
+    }
+
+    Reader m_reader;
+};
+
+template<typename T>
+CompactBinaryDeserializer(T&&) -> CompactBinaryDeserializer<T>;
+
+namespace detail {
+    template<typename T>
+    struct DeserializeCompactBinaryFunction {
+        template<concepts::Impl<io::Reader> Reader, typename... Args>
+        requires(concepts::ConstructibleFrom<CompactBinaryDeserializer<ReferenceWrapper<meta::RemoveCVRef<Reader>>>,
+                                             Reader&, Args...> &&
+                 concepts::Deserializable<T, CompactBinaryDeserializer<ReferenceWrapper<meta::RemoveCVRef<Reader>>>>)
+        constexpr auto operator()(Reader&& reader, Args&&... args) const {
+            return serialization::deserialize<T>(compact_binary_format, ref(reader), util::forward<Args>(args)...);
+        }
+    };
+}
+
+template<typename T>
+constexpr inline auto deserialize_compact_binary = detail::DeserializeCompactBinaryFunction<T> {};
+}
+
+namespace di {
+using serialization::CompactBinaryDeserializer;
+using serialization::deserialize_compact_binary;
+}
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "di/container/action/sequence.h"
+#include "di/container/concepts/contiguous_container.h"
+#include "di/container/concepts/sized_container.h"
+#include "di/container/interface/data.h"
+#include "di/container/interface/size.h"
+#include "di/container/meta/container_value.h"
+#include "di/function/monad/monad_try.h"
+#include "di/io/interface/reader.h"
+#include "di/io/interface/writer.h"
+#include "di/io/unchecked_span_writer.h"
+#include "di/io/write_exactly.h"
+#include "di/meta/language.h"
+#include "di/meta/operations.h"
+#include "di/meta/util.h"
+#include "di/meta/vocab.h"
+#include "di/serialization/serialize.h"
+#include "di/serialization/varint.h"
+#include "di/types/integers.h"
+#include "di/util/to_underlying.h"
+#include "di/util/unwrap_reference.h"
+#include "di/vocab/array/array.h"
+#include "di/vocab/tuple/tuple_like.h"
+#include "di/vocab/variant/variant_like.h"
+
+namespace di::serialization {
+struct CompactBinaryFormat;
+
+/// @brief A serializer for a compact variant of the simple binary format.
+///
+/// @tparam Writer The type of the writer to write to.
+///
+/// This format is laid out exactly like the one written by BinarySerializer, except that integers wider than a single
+/// byte are written as LEB128 varints instead of at their native width. Signed integers are zigzag encoded first, so
+/// that small negative values stay small. Enums are written as their underlying type, and container sizes and variant
+/// indices are written as varints as well. This makes messages consisting mostly of small counts and identifiers
+/// considerably smaller, at the cost of slightly more expensive encoding and decoding.
+///
+/// Like the simple binary format, this format is not self-describing.
+///
+/// @see BinarySerializer
+template<Impl<io::Writer> Writer>
+class CompactBinarySerializer {
+public:
+    using SerializationFormat = CompactBinaryFormat;
+
+    template<concepts::NotDecaysTo<CompactBinarySerializer> T>
+    requires(ConstructibleFrom<Writer, T>)
+    // NOLINTNEXTLINE(bugprone-forwarding-reference-overload)
+    constexpr explicit CompactBinarySerializer(T&& writer) : m_writer(di::forward<T>(writer)) {}
+
+    template<typename T, concepts::InstanceOf<reflection::Fields> M>
+    constexpr auto serialize(T&& value, M) {
+        return tuple_sequence<meta::WriterResult<void, Writer>>(
+            [&](auto field) {
+                return di::serialize(*this, field.get(value));
+            },
+            M {});
+    }
+
+    constexpr auto serialize(concepts::TupleLike auto&& value) {
+        return tuple_sequence<meta::WriterResult<void, Writer>>(
+            [&](auto&& element) {
+                return di::serialize(*this, element);
+            },
+            value);
+    }
+
+    constexpr auto serialize(concepts::VariantLike auto&& value) -> meta::WriterResult<void, Writer> {
+        DI_TRY(write_varint(u64(value.index())));
+        return visit(
+            [&](auto&& alternative) {
+                return di::serialize(*this, alternative);
+            },
+            value);
+    }
+
+    template<concepts::IntegralOrEnum T>
+    constexpr auto serialize(T value) -> meta::WriterResult<void, Writer> {
+        if constexpr (concepts::Enum<T>) {
+            return serialize(util::to_underlying(value));
+        } else if constexpr (sizeof(T) == 1) {
+            // Single bytes can't get any smaller, so write them as-is.
+            auto const as_bytes = Array { byte(value) };
+            return write(as_bytes.span());
+        } else {
+            return write_varint(value);
+        }
+    }
+
+    template<typename T, concepts::InstanceOf<reflection::Atom> M>
+    requires(M::is_string())
+    constexpr auto serialize(T&& value, M) {
+        // Serialize the underlying data, in terms of code units.
+        return di::serialize(*this, value.span());
+    }
+
+    template<concepts::SizedContainer T>
+    requires(concepts::Serializable<meta::ContainerReference<T>, CompactBinarySerializer>)
+    constexpr auto serialize(T&& value) -> meta::WriterResult<void, Writer> {
+        auto const size = u64(container::size(value));
+        DI_TRY(write_varint(size));
+
+        // Arrays of bytes (including strings) are written exactly as they are stored in memory.
+        using Value = meta::RemoveCV<meta::ContainerValue<T>>;
+        if constexpr (concepts::ContiguousContainer<T> && concepts::Integral<Value> && !concepts::SameAs<Value, bool> &&
+                      sizeof(Value) == 1) {
+            if !consteval {
+                auto const* data = reinterpret_cast<byte const*>(container::data(value));
+                return write(Span<byte const> { data, usize(size) });
+            }
+        }
+        return container::sequence(value, [&](auto&& element) {
+            return di::serialize(*this, element);
+        });
+    }
+
+    constexpr auto writer() & -> Writer& { return m_writer; }
+    constexpr auto writer() const& -> Writer const& { return m_writer; }
+    constexpr auto writer() && -> Writer&& { return util::move(*this).m_writer; }
+
+private:
+    constexpr auto write(Span<byte const> bytes) -> meta::WriterResult<void, Writer> {
+        if constexpr (concepts::UncheckedWriter<meta::UnwrapReference<Writer>>) {
+            util::unwrap_reference(writer()).write_unchecked(bytes);
+            return {};
+        } else {
+            return io::write_exactly(writer(), bytes);
+        }
+    }
+
+    template<concepts::Integral T>
+    constexpr auto write_varint(T value) -> meta::WriterResult<void, Writer> {
+        auto buffer = Array<byte, max_varint_size<T>> {};
+        auto const size = encode_varint(value, buffer.span());
+        return write(*buffer.span().first(size));
+    }
+
+    Writer m_writer;
+};
+
+template<typename T>
+CompactBinarySerializer(T&&) -> CompactBinarySerializer<T>;
+
+template<Impl<io::Reader> Reader>
+class CompactBinaryDeserializer;
+
+struct CompactBinaryFormat {
+    template<concepts::Impl<io::Writer> Writer, typename... Args>
+    requires(ConstructibleFrom<CompactBinarySerializer<meta::RemoveCVRef<Writer>>, Writer, Args...>)
+    constexpr static auto serializer(Writer&& writer, Args&&... args) {
+        return CompactBinarySerializer<meta::RemoveCVRef<Writer>>(di::forward<Writer>(writer),
+                                                                  di::forward<Args>(args)...);
+    }
+
+    template<concepts::Impl<io::Reader> Reader, typename... Args>
+    requires(ConstructibleFrom<CompactBinaryDeserializer<meta::RemoveCVRef<Reader>>, Reader, Args...>)
+    constexpr static auto deserializer(Reader&& reader, Args&&... args) {
+        return CompactBinaryDeserializer<meta::RemoveCVRef<Reader>>(di::forward<Reader>(reader),
+                                                                    di::forward<Args>(args)...);
+    }
+};
+
+constexpr inline auto compact_binary_format = CompactBinaryFormat {};
+
+namespace detail {
+    struct SerializeCompactBinaryFunction {
+        template<Impl<io::Writer> Writer, Serializable<CompactBinarySerializer<Writer>> T, typename... Args>
+        requires(ConstructibleFrom<CompactBinarySerializer<ReferenceWrapper<meta::RemoveReference<Writer>>>,
+                                   ReferenceWrapper<meta::RemoveReference<Writer>>, Args...>)
+        constexpr auto operator()(Writer&& writer, T&& value, Args&&... args) const {
+            return serialize(compact_binary_format, di::ref(writer), value, di::forward<Args>(args)...);
+        }
+    };
+}
+
+constexpr inline auto serialize_compact_binary = detail::SerializeCompactBinaryFunction {};
+}
+
+namespace di {
+using serialization::compact_binary_format;
+using serialization::CompactBinaryFormat;
+using serialization::CompactBinarySerializer;
+using serialization::serialize_compact_binary;
+}
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "di/any/concepts/impl.h"
+#include "di/container/allocator/allocator.h"
 #include "di/container/string/encoding.h"
 #include "di/container/string/fixed_string.h"
 #include "di/container/string/fixed_string_to_utf8_string_view.h"
 #include "di/container/string/string_view.h"
 #include "di/container/string/utf8_strict_stream_decoder.h"
+#include "di/container/vector/vector.h"
 #include "di/format/format.h"
 #include "di/function/index_dispatch.h"
 #include "di/io/interface/reader.h"
@@ -24,6 +26,7 @@
 #include "di/serialization/json_value.h"
 #include "di/types/in_place_type.h"
 #include "di/types/prelude.h"
+#include "di/util/create.h"
 #include "di/util/exchange.h"
 #include "di/util/reference_wrapper.h"
 #include "di/util/to_underlying.h"
@@ -80,8 +83,16 @@ public:
     requires(concepts::ConstructibleFrom<Reader, T>)
     constexpr explicit JsonDeserializer(T&& reader) : m_reader(util::forward<T>(reader)) {}
 
-    constexpr auto deserialize(InPlaceType<json::Value>) -> Result<json::Value> {
-        auto result = DI_TRY(deserialize_value());
+    template<concepts::Allocator Alloc>
+    constexpr auto deserialize(InPlaceType<json::BasicValue<Alloc>>) -> Result<json::BasicValue<Alloc>> {
+        return deserialize(in_place_type<json::BasicValue<Alloc>>, Alloc {});
+    }
+
+    /// @brief Deserialize a JSON value, allocating every string, array, and object in it with @p allocator.
+    template<concepts::Allocator Alloc>
+    constexpr auto deserialize(InPlaceType<json::BasicValue<Alloc>>, Alloc const& allocator)
+        -> Result<json::BasicValue<Alloc>> {
+        auto result = DI_TRY(deserialize_value(allocator));
         DI_TRY(skip_whitespace());
         return result;
     }
@@ -464,7 +475,8 @@ private:
         }
     }
 
-    constexpr auto deserialize_value() -> Result<json::Value> {
+    template<concepts::Allocator Alloc>
+    constexpr auto deserialize_value(Alloc const& allocator) -> Result<json::BasicValue<Alloc>> {
         DI_TRY(skip_whitespace());
 
         auto code_point = DI_TRY(peek_next_code_point());
@@ -480,7 +492,7 @@ private:
             case U'f':
                 return deserialize_false();
             case U'"':
-                return deserialize_string();
+                return deserialize_string(allocator);
             case U'-':
             case U'0':
             case U'1':
@@ -494,9 +506,9 @@ private:
             case U'9':
                 return deserialize_number(in_place_type<json::Number>);
             case U'{':
-                return deserialize_object();
+                return deserialize_object(allocator);
             case U'[':
-                return deserialize_array();
+                return deserialize_array(allocator);
             default:
                 return vocab::Unexpected(
                     json_deserializer::Error(json_deserializer::UnexpectedCharacterError { *code_point }, "."_s));
@@ -579,11 +591,12 @@ private:
     constexpr static auto is_high_surrogate(u16 code_unit) -> bool { return (code_unit >> 10) == 0b110110u; }
     constexpr static auto is_low_surrogate(u16 code_unit) -> bool { return (code_unit >> 10) == 0b110111u; }
 
-    constexpr auto deserialize_string() -> Result<json::String> {
+    template<concepts::Allocator Alloc = platform::DefaultAllocator>
+    constexpr auto deserialize_string(Alloc const& allocator = {}) -> Result<json::BasicString<Alloc>> {
         DI_TRY(skip_whitespace());
         DI_TRY(expect(U'"'));
 
-        auto string = json::String {};
+        auto string = util::create<json::BasicString<Alloc>>(container::Vector<c8, Alloc>(allocator));
         for (;;) {
             auto code_point = DI_TRY(require_next_code_point());
             if (code_point < 0x20) {
@@ -699,11 +712,12 @@ private:
         return *result;
     }
 
-    constexpr auto deserialize_array() -> Result<json::Array> {
+    template<concepts::Allocator Alloc>
+    constexpr auto deserialize_array(Alloc const& allocator) -> Result<json::BasicArray<Alloc>> {
         DI_TRY(skip_whitespace());
         DI_TRY(expect(U'['));
 
-        auto array = json::Array {};
+        auto array = json::BasicArray<Alloc>(allocator);
         for (;;) {
             DI_TRY(skip_whitespace());
             auto code_point = DI_TRY(peek_next_code_point());
@@ -717,18 +731,19 @@ private:
             if (!array.empty()) {
                 DI_TRY(expect(U','));
             }
-            array.push_back(DI_TRY(deserialize_value()));
+            array.push_back(DI_TRY(deserialize_value(allocator)));
         }
 
         DI_TRY(expect(U']'));
         return array;
     }
 
-    constexpr auto deserialize_object() -> Result<json::Object> {
+    template<concepts::Allocator Alloc>
+    constexpr auto deserialize_object(Alloc const& allocator) -> Result<json::BasicObject<Alloc>> {
         DI_TRY(skip_whitespace());
         DI_TRY(expect(U'{'));
 
-        auto object = json::Object {};
+        auto object = json::BasicObject<Alloc>(allocator);
         for (;;) {
             DI_TRY(skip_whitespace());
             auto code_point = DI_TRY(peek_next_code_point());
@@ -743,10 +758,10 @@ private:
                 DI_TRY(expect(U','));
                 DI_TRY(skip_whitespace());
             }
-            auto key = DI_TRY(deserialize_string());
+            auto key = DI_TRY(deserialize_string(allocator));
             DI_TRY(skip_whitespace());
             DI_TRY(expect(U':'));
-            auto value = DI_TRY(deserialize_value());
+            auto value = DI_TRY(deserialize_value(allocator));
             object.insert_or_assign(util::move(key), util::move(value));
         }
 
@@ -772,6 +787,13 @@ namespace detail {
         constexpr auto operator()(container::StringView view, Args&&... args) const {
             return serialization::deserialize_string<T>(json_format, view, util::forward<Args>(args)...);
         }
+
+        template<concepts::Allocator Alloc>
+        requires(concepts::SameAs<T, json::BasicValue<Alloc>>)
+        constexpr auto operator()(container::StringView view, Alloc const& allocator) const {
+            auto deserializer = JsonDeserializer(StringReader<container::StringView> { view });
+            return deserializer.deserialize(in_place_type<T>, allocator);
+        }
     };
 }
 
@@ -75,9 +75,16 @@ struct InvalidUtf8Error {
     auto operator==(InvalidUtf8Error const&) const -> bool = default;
 };
 
+struct KeyTooLongError {
+    usize max_size { 0 };
+
+    auto operator==(KeyTooLongError const&) const -> bool = default;
+};
+
 using ErrorVariant =
     Variant<ReadError, ParseBoolError, ParseEnumError, ParseValueError, ParseNumberError, UnexpectedKeyError,
-            UnexpectedCharacterError, MissingArrayElementsError, UnexpectedEndOfInputError, InvalidUtf8Error>;
+            UnexpectedCharacterError, MissingArrayElementsError, UnexpectedEndOfInputError, InvalidUtf8Error,
+            KeyTooLongError>;
 
 struct ConcreteError {
     ErrorVariant error;
@@ -211,6 +218,10 @@ protected:
                 },
                 [&](InvalidUtf8Error) {
                     writer_print<Enc>(writer, "Invalid UTF-8 byte detected while parsing '{}'"_sv, value.key);
+                },
+                [&](KeyTooLongError const& error) {
+                    writer_print<Enc>(writer, "Key longer than {} bytes while parsing '{}'"_sv, error.max_size,
+                                      value.key);
                 }),
             value.error);
         return di::move(writer).output();
@@ -0,0 +1,761 @@
+#pragma once
+
+#include "di/any/concepts/impl.h"
+#include "di/container/algorithm/max.h"
+#include "di/container/string/encoding.h"
+#include "di/container/string/string_view.h"
+#include "di/container/string/utf8_encoding.h"
+#include "di/container/vector/vector.h"
+#include "di/function/monad/monad_try.h"
+#include "di/io/interface/reader.h"
+#include "di/io/prelude.h"
+#include "di/io/span_reader.h"
+#include "di/meta/core.h"
+#include "di/meta/operations.h"
+#include "di/meta/util.h"
+#include "di/parser/parse.h"
+#include "di/parser/prelude.h"
+#include "di/platform/prelude.h"
+#include "di/serialization/json_deserializer_error.h"
+#include "di/serialization/json_value.h"
+#include "di/types/byte.h"
+#include "di/types/in_place_type.h"
+#include "di/types/integers.h"
+#include "di/util/exchange.h"
+#include "di/util/unwrap_reference.h"
+#include "di/vocab/error/prelude.h"
+#include "di/vocab/expected/invoke_as_fallible.h"
+#include "di/vocab/optional/prelude.h"
+#include "di/vocab/span/prelude.h"
+#include "di/vocab/variant/variant.h"
+
+namespace di::serialization::json {
+/// @brief Marks the start of an object, which is followed by alternating Key events and values, and then EndObject.
+struct BeginObject {
+    auto operator==(BeginObject const&) const -> bool = default;
+};
+
+struct EndObject {
+    auto operator==(EndObject const&) const -> bool = default;
+};
+
+/// @brief Marks the start of an array, which is followed by its values, and then EndArray.
+struct BeginArray {
+    auto operator==(BeginArray const&) const -> bool = default;
+};
+
+struct EndArray {
+    auto operator==(EndArray const&) const -> bool = default;
+};
+
+/// @brief The key of an object member. Keys are always delivered in one piece, and so are limited to
+/// JsonEventReader::max_key_size bytes.
+struct Key {
+    container::StringView name;
+
+    auto operator==(Key const&) const -> bool = default;
+};
+
+/// @brief A piece of a string value which is too long to be buffered at once.
+///
+/// The remainder of the string follows as more StringChunk events, and the final piece is delivered as a normal string
+/// value.
+struct StringChunk {
+    container::StringView data;
+
+    auto operator==(StringChunk const&) const -> bool = default;
+};
+
+/// @brief An event produced by JsonEventReader.
+///
+/// Strings (including keys and chunks) refer either directly to the input or to a buffer owned by the reader, and so
+/// are only valid until the next event is read.
+using Event = vocab::Variant<BeginObject, EndObject, BeginArray, EndArray, Key, StringChunk, container::StringView,
+                             Number, Bool, Null>;
+}
+
+namespace di::serialization::detail {
+// The incremental parser behind JsonEventReader. Each call is given all of the unconsumed input, and either produces
+// an event or asks for more input. Tokens are only consumed once they have been read completely, so the caller is free
+// to move the unconsumed input around between calls.
+class JsonEventParser {
+public:
+    template<typename T = void>
+    using Result = Expected<T, json_deserializer::ErrorCode>;
+
+    // Strings which are not terminated within the available input are split once they reach this size.
+    constexpr static auto string_chunk_size = usize(16 * 1024);
+
+    // Keys are never split, so longer keys are rejected instead of being buffered without bound.
+    constexpr static auto max_key_size = string_chunk_size;
+
+    // The number of input bytes consumed by the last call.
+    constexpr auto consumed() const -> usize { return m_consumed; }
+
+    // Produce the next event, or nullopt if more input is needed (or at the end of the input).
+    constexpr auto next(Span<byte const> input, bool at_end) -> Result<Optional<json::Event>> {
+        m_consumed = 0;
+        if (m_in_string) {
+            return parse_string(input, 0, at_end, false);
+        }
+
+        auto position = usize(0);
+        for (;;) {
+            position = skip_whitespace(input, position);
+            m_consumed = position;
+            if (position == input.size()) {
+                if (at_end && (m_state != State::Value || !m_scopes.empty())) {
+                    return unexpected_end_of_input();
+                }
+                return nullopt;
+            }
+
+            auto const code_unit = u8(input[position]);
+            switch (m_state) {
+                case State::FirstValueOrEnd:
+                    if (code_unit == ']') {
+                        return end_scope(position);
+                    }
+                    return parse_value(input, position, at_end);
+                case State::Value:
+                    return parse_value(input, position, at_end);
+                case State::FirstKeyOrEnd:
+                    if (code_unit == '}') {
+                        return end_scope(position);
+                    }
+                    [[fallthrough]];
+                case State::Key:
+                    if (code_unit != '"') {
+                        return unexpected_character(code_unit, U'"');
+                    }
+                    return parse_string(input, position + 1, at_end, true);
+                case State::Colon:
+                    if (code_unit != ':') {
+                        return unexpected_character(code_unit, U':');
+                    }
+                    m_state = State::Value;
+                    position++;
+                    continue;
+                case State::CommaOrEnd: {
+                    auto const scope = *m_scopes.back();
+                    if (code_unit == ',') {
+                        m_state = scope == Scope::Object ? State::Key : State::Value;
+                        position++;
+                        continue;
+                    }
+                    if (code_unit == (scope == Scope::Object ? '}' : ']')) {
+                        return end_scope(position);
+                    }
+                    return unexpected_character(code_unit);
+                }
+            }
+        }
+    }
+
+    // Prepare to skip the rest of the current subtree. After a key, this skips its value. Inside of an object or array,
+    // this skips the remainder of the innermost one, including its end. Otherwise, this skips the next value.
+    constexpr void begin_skip() {
+        m_skip = Skip {};
+        if (util::exchange(m_in_string, false)) {
+            m_skip.started = true;
+            m_skip.in_string = true;
+        } else if (m_state == State::Colon || m_scopes.empty()) {
+            m_skip.expect_colon = m_state == State::Colon;
+        } else {
+            m_skip.started = true;
+            m_skip.depth = 1;
+            m_skip.end_scope = true;
+        }
+    }
+
+    // Skip more of the subtree, returning true once it has been skipped completely.
+    //
+    // NOTE: to keep this fast, skipped content is only checked for balanced nesting, and is not otherwise validated.
+    constexpr auto skip(Span<byte const> input, bool at_end) -> Result<bool> {
+        auto position = usize(0);
+        m_consumed = 0;
+        if (m_skip.expect_colon) {
+            position = skip_whitespace(input, position);
+            if (position == input.size()) {
+                return need_more(position, at_end);
+            }
+            if (u8(input[position]) != ':') {
+                return unexpected_character(u8(input[position]), U':');
+            }
+            m_skip.expect_colon = false;
+            position++;
+        }
+        if (!m_skip.started) {
+            position = skip_whitespace(input, position);
+            if (position == input.size()) {
+                return need_more(position, at_end);
+            }
+            auto const code_unit = u8(input[position]);
+            m_skip.started = true;
+            if (code_unit == '{' || code_unit == '[') {
+                m_skip.depth = 1;
+                position++;
+            } else if (code_unit == '"') {
+                m_skip.in_string = true;
+                position++;
+            } else {
+                m_skip.in_scalar = true;
+            }
+        }
+
+        for (; position < input.size(); position++) {
+            auto const code_unit = u8(input[position]);
+            if (m_skip.in_scalar) {
+                if (code_unit == ',' || code_unit == '}' || code_unit == ']' || is_whitespace(code_unit)) {
+                    return finish_skip(position);
+                }
+            } else if (m_skip.in_string) {
+                if (m_skip.escaped) {
+                    m_skip.escaped = false;
+                } else if (code_unit == '\\') {
+                    m_skip.escaped = true;
+                } else if (code_unit == '"') {
+                    m_skip.in_string = false;
+                    if (m_skip.depth == 0) {
+                        return finish_skip(position + 1);
+                    }
+                }
+            } else if (code_unit == '"') {
+                m_skip.in_string = true;
+            } else if (code_unit == '{' || code_unit == '[') {
+                m_skip.depth++;
+            } else if (code_unit == '}' || code_unit == ']') {
+                if (--m_skip.depth == 0) {
+                    return finish_skip(position + 1);
+                }
+            }
+        }
+        if (m_skip.in_scalar && at_end) {
+            return finish_skip(position);
+        }
+        return need_more(position, at_end);
+    }
+
+private:
+    enum class State : u8 { Value, FirstValueOrEnd, FirstKeyOrEnd, Key, Colon, CommaOrEnd };
+    enum class Scope : u8 { Object, Array };
+
+    struct Skip {
+        usize depth { 0 };
+        bool expect_colon { false };
+        bool started { false };
+        bool in_scalar { false };
+        bool in_string { false };
+        bool escaped { false };
+        bool end_scope { false };
+    };
+
+    constexpr static auto is_whitespace(u8 code_unit) -> bool {
+        return code_unit == ' ' || code_unit == '\t' || code_unit == '\n' || code_unit == '\r';
+    }
+
+    constexpr static auto skip_whitespace(Span<byte const> input, usize position) -> usize {
+        while (position < input.size() && is_whitespace(u8(input[position]))) {
+            position++;
+        }
+        return position;
+    }
+
+    constexpr static auto error(json_deserializer::ErrorVariant error) -> vocab::Unexpected<json_deserializer::Error> {
+        return vocab::Unexpected(json_deserializer::Error(di::move(error), "."_s));
+    }
+
+    constexpr static auto unexpected_end_of_input() {
+        return error(json_deserializer::UnexpectedEndOfInputError {});
+    }
+
+    constexpr static auto unexpected_character(u8 code_unit, Optional<c32> expected = {}) {
+        return error(json_deserializer::UnexpectedCharacterError { c32(code_unit), expected });
+    }
+
+    constexpr auto need_more(usize position, bool at_end) -> Result<bool> {
+        if (at_end) {
+            return unexpected_end_of_input();
+        }
+        m_consumed = position;
+        return false;
+    }
+
+    constexpr auto finish_skip(usize position) -> Result<bool> {
+        m_consumed = position;
+        if (m_skip.end_scope) {
+            m_scopes.pop_back();
+        }
+        finish_value();
+        return true;
+    }
+
+    // Update the state after a complete value, which either ends a top-level value or is followed by a comma.
+    constexpr void finish_value() { m_state = m_scopes.empty() ? State::Value : State::CommaOrEnd; }
+
+    constexpr auto end_scope(usize position) -> Result<Optional<json::Event>> {
+        auto const scope = *m_scopes.pop_back();
+        m_consumed = position + 1;
+        finish_value();
+        if (scope == Scope::Object) {
+            return json::Event(in_place_type<json::EndObject>);
+        }
+        return json::Event(in_place_type<json::EndArray>);
+    }
+
+    constexpr auto begin_scope(usize position, Scope scope) -> Result<Optional<json::Event>> {
+        if (!invoke_as_fallible([&] {
+                return m_scopes.push_back(scope);
+            })) {
+            return error(json_deserializer::ReadError { BasicError::NotEnoughMemory });
+        }
+        m_consumed = position + 1;
+        if (scope == Scope::Object) {
+            m_state = State::FirstKeyOrEnd;
+            return json::Event(in_place_type<json::BeginObject>);
+        }
+        m_state = State::FirstValueOrEnd;
+        return json::Event(in_place_type<json::BeginArray>);
+    }
+
+    constexpr auto parse_value(Span<byte const> input, usize position, bool at_end) -> Result<Optional<json::Event>> {
+        switch (u8(input[position])) {
+            case '{':
+                return begin_scope(position, Scope::Object);
+            case '[':
+                return begin_scope(position, Scope::Array);
+            case '"':
+                return parse_string(input, position + 1, at_end, false);
+            case 'n':
+                return parse_literal(input, position, at_end, "null"_sv, json::Event(in_place_type<json::Null>));
+            case 't':
+                return parse_literal(input, position, at_end, "true"_sv, json::Event(in_place_type<json::Bool>, true));
+            case 'f':
+                return parse_literal(input, position, at_end, "false"_sv,
+                                     json::Event(in_place_type<json::Bool>, false));
+            case '-':
+            case '0':
+            case '1':
+            case '2':
+            case '3':
+            case '4':
+            case '5':
+            case '6':
+            case '7':
+            case '8':
+            case '9':
+                return parse_number(input, position, at_end);
+            default:
+                return unexpected_character(u8(input[position]));
+        }
+    }
+
+    constexpr auto parse_literal(Span<byte const> input, usize position, bool at_end, container::StringView literal,
+                                 json::Event event) -> Result<Optional<json::Event>> {
+        auto const expected = literal.span();
+        for (auto i = usize(0); i < expected.size(); i++) {
+            if (position + i == input.size()) {
+                if (at_end) {
+                    return unexpected_end_of_input();
+                }
+                return nullopt;
+            }
+            if (u8(input[position + i]) != u8(expected[i])) {
+                return unexpected_character(u8(input[position + i]), c32(expected[i]));
+            }
+        }
+        m_consumed = position + expected.size();
+        finish_value();
+        return event;
+    }
+
+    constexpr static auto is_number_code_unit(u8 code_unit) -> bool {
+        return (code_unit >= '0' && code_unit <= '9') || code_unit == '-' || code_unit == '+' || code_unit == '.' ||
+               code_unit == 'e' || code_unit == 'E';
+    }
+
+    constexpr auto parse_number(Span<byte const> input, usize position, bool at_end) -> Result<Optional<json::Event>> {
+        auto end = position;
+        while (end < input.size() && is_number_code_unit(u8(input[end]))) {
+            end++;
+        }
+        if (end == input.size() && !at_end) {
+            return nullopt;
+        }
+
+        auto const text = container::StringView(container::string::encoding::assume_valid,
+                                                reinterpret_cast<c8 const*>(input.data() + position), end - position);
+
+        // NOTE: like JsonDeserializer, this only supports integers, which must not have leading zeros.
+        auto const digits = text.span().subspan(text.span()[0] == '-' ? 1 : 0).value_or(Span<c8 const> {});
+        auto valid = !digits.empty() && (digits[0] != '0' || digits.size() == 1);
+        for (auto code_unit : digits) {
+            valid &= code_unit >= '0' && code_unit <= '9';
+        }
+        if (!valid) {
+            return error(json_deserializer::ParseNumberError { text.to_owned() });
+        }
+        auto result = parser::parse<json::Number>(text);
+        if (!result) {
+            return error(json_deserializer::ParseNumberError { text.to_owned() });
+        }
+
+        m_consumed = end;
+        finish_value();
+        return json::Event(in_place_type<json::Number>, *result);
+    }
+
+    // Parse a string (or the remainder of a partially consumed string), whose contents start at `start`.
+    constexpr auto parse_string(Span<byte const> input, usize start, bool at_end, bool is_key)
+        -> Result<Optional<json::Event>> {
+        auto end = start;
+        while (end < input.size()) {
+            auto const code_unit = u8(input[end]);
+            if (code_unit == '"') {
+                break;
+            }
+            if (code_unit < 0x20) {
+                return unexpected_character(code_unit);
+            }
+            // The escaped character is skipped, since it may be a quote.
+            end += code_unit == '\\' ? 2 : 1;
+        }
+
+        if (is_key && end - start > max_key_size) {
+            return error(json_deserializer::KeyTooLongError { max_key_size });
+        }
+        if (end >= input.size()) {
+            if (at_end) {
+                return unexpected_end_of_input();
+            }
+            if (!is_key && input.size() - start >= string_chunk_size) {
+                auto const split = string_split_point(input, start);
+                auto const chunk = DI_TRY(decode_string(*input.subspan(start, split - start)));
+                m_in_string = true;
+                m_consumed = split;
+                return json::Event(in_place_type<json::StringChunk>, chunk);
+            }
+            return nullopt;
+        }
+
+        auto const string = DI_TRY(decode_string(*input.subspan(start, end - start)));
+        m_in_string = false;
+        m_consumed = end + 1;
+        if (is_key) {
+            m_state = State::Colon;
+            return json::Event(in_place_type<json::Key>, string);
+        }
+        finish_value();
+        return json::Event(in_place_type<container::StringView>, string);
+    }
+
+    constexpr static auto is_high_surrogate(u16 code_unit) -> bool { return (code_unit >> 10) == 0b110110u; }
+    constexpr static auto is_low_surrogate(u16 code_unit) -> bool { return (code_unit >> 10) == 0b110111u; }
+
+    // Find where to split an unterminated string, such that neither an escape sequence (including a surrogate pair)
+    // nor a UTF-8 sequence is cut in half.
+    constexpr static auto string_split_point(Span<byte const> input, usize start) -> usize {
+        constexpr auto max_escape_size = usize(12);
+
+        auto const limit = input.size() - max_escape_size;
+        auto split = start;
+        while (split < limit) {
+            if (u8(input[split]) != '\\') {
+                split++;
+            } else if (u8(input[split + 1]) != 'u') {
+                split += 2;
+            } else {
+                auto const first = u8(input[split + 2]);
+                auto const second = u8(input[split + 3]);
+                auto const high_surrogate = (first == 'd' || first == 'D') &&
+                                            ((second >= '8' && second <= '9') || (second >= 'a' && second <= 'b') ||
+                                             (second >= 'A' && second <= 'B'));
+                split += high_surrogate ? 12 : 6;
+            }
+        }
+        while (split > start && (u8(input[split]) & 0b11000000) == 0b10000000) {
+            split--;
+        }
+        return split;
+    }
+
+    constexpr static auto from_hex_digit(u8 code_unit) -> Optional<u16> {
+        if (code_unit >= '0' && code_unit <= '9') {
+            return u16(code_unit - '0');
+        }
+        if (code_unit >= 'A' && code_unit <= 'F') {
+            return u16(10u + (code_unit - 'A'));
+        }
+        if (code_unit >= 'a' && code_unit <= 'f') {
+            return u16(10u + (code_unit - 'a'));
+        }
+        return nullopt;
+    }
+
+    constexpr static auto parse_four_hex_digits(Span<byte const> raw, usize position) -> Result<u16> {
+        auto result = u16(0);
+        for (auto i = usize(0); i < 4; i++) {
+            if (position + i >= raw.size()) {
+                return unexpected_character('"');
+            }
+            auto const digit = from_hex_digit(u8(raw[position + i]));
+            if (!digit) {
+                return unexpected_character(u8(raw[position + i]));
+            }
+            result = u16((result << 4) | *digit);
+        }
+        return result;
+    }
+
+    constexpr auto append_code_unit(c8 code_unit) -> Result<void> {
+        if (!invoke_as_fallible([&] {
+                return m_scratch.push_back(code_unit);
+            })) {
+            return error(json_deserializer::ReadError { BasicError::NotEnoughMemory });
+        }
+        return {};
+    }
+
+    constexpr auto append_code_point(c32 code_point) -> Result<void> {
+        for (auto code_unit : container::string::encoding::convert_to_code_units(container::string::Utf8Encoding(),
+                                                                                  code_point)) {
+            DI_TRY(append_code_unit(code_unit));
+        }
+        return {};
+    }
+
+    // Convert the raw contents of a string into a view. When there are no escape sequences, the view refers directly
+    // to the input, and otherwise the string is decoded into the scratch buffer.
+    constexpr auto decode_string(Span<byte const> raw) -> Result<container::StringView> {
+        auto escaped = false;
+        for (auto code_unit : raw) {
+            escaped |= u8(code_unit) == '\\';
+        }
+
+        auto code_units = Span<c8 const> { reinterpret_cast<c8 const*>(raw.data()), raw.size() };
+        if (escaped) {
+            m_scratch.clear();
+            for (auto i = usize(0); i < raw.size();) {
+                auto const code_unit = u8(raw[i]);
+                if (code_unit != '\\') {
+                    // Unescaped data is copied as-is, and validated below.
+                    DI_TRY(append_code_unit(c8(code_unit)));
+                    i++;
+                    continue;
+                }
+
+                auto const escape = u8(raw[i + 1]);
+                i += 2;
+                switch (escape) {
+                    case '"':
+                    case '\\':
+                    case '/':
+                        DI_TRY(append_code_point(c32(escape)));
+                        break;
+                    case 'b':
+                        DI_TRY(append_code_point(U'\b'));
+                        break;
+                    case 'f':
+                        DI_TRY(append_code_point(U'\f'));
+                        break;
+                    case 'n':
+                        DI_TRY(append_code_point(U'\n'));
+                        break;
+                    case 'r':
+                        DI_TRY(append_code_point(U'\r'));
+                        break;
+                    case 't':
+                        DI_TRY(append_code_point(U'\t'));
+                        break;
+                    case 'u': {
+                        // Escaped unicode sequences are encoded via UTF-16, despite the underlying data being
+                        // encoded in UTF-8.
+                        auto const high = DI_TRY(parse_four_hex_digits(raw, i));
+                        i += 4;
+                        if (is_low_surrogate(high)) {
+                            return unexpected_character('u');
+                        }
+                        if (!is_high_surrogate(high)) {
+                            DI_TRY(append_code_point(c32(high)));
+                            break;
+                        }
+
+                        // Require a corresponding escaped low surrogate.
+                        if (i + 2 > raw.size() || u8(raw[i]) != '\\' || u8(raw[i + 1]) != 'u') {
+                            return unexpected_character(i < raw.size() ? u8(raw[i]) : u8('"'), U'\\');
+                        }
+                        auto const low = DI_TRY(parse_four_hex_digits(raw, i + 2));
+                        i += 6;
+                        if (!is_low_surrogate(low)) {
+                            return unexpected_character('u');
+                        }
+                        DI_TRY(append_code_point(c32((high - 0xD800u) << 10) + c32(low - 0xDC00u) + c32(0x10000)));
+                        break;
+                    }
+                    default:
+                        return unexpected_character(escape);
+                }
+            }
+            code_units = m_scratch.span();
+        }
+
+        if (!container::string::encoding::validate(container::string::Utf8Encoding(), code_units)) {
+            return error(json_deserializer::InvalidUtf8Error {});
+        }
+        return container::StringView(container::string::encoding::assume_valid, code_units.data(), code_units.size());
+    }
+
+    container::Vector<Scope> m_scopes;
+    container::Vector<c8> m_scratch;
+    Skip m_skip;
+    usize m_consumed { 0 };
+    State m_state { State::Value };
+    bool m_in_string { false };
+};
+
+// The input buffer of JsonEventReader, when the underlying reader can't be parsed in place.
+class JsonEventBuffer {
+public:
+    constexpr static auto read_size = usize(64 * 1024);
+
+    constexpr auto input() const -> Span<byte const> { return *m_data.span().subspan(m_position); }
+    constexpr void advance(usize count) { m_position += count; }
+
+    // Discard the consumed input, and return space to read more input into.
+    constexpr auto prepare() -> Optional<Span<byte>> {
+        if (m_position > 0) {
+            m_data.erase(m_data.begin(), m_data.begin() + m_position);
+            m_position = 0;
+        }
+
+        // Grow geometrically, in case a single token doesn't fit in the buffer.
+        auto const size = m_data.size();
+        auto const count = container::max(size, read_size);
+        if (!invoke_as_fallible([&] {
+                return m_data.reserve(size + count);
+            })) {
+            return nullopt;
+        }
+        return Span<byte> { m_data.data() + size, count };
+    }
+
+    constexpr void commit(usize count) { m_data.assume_size(m_data.size() + count); }
+
+private:
+    container::Vector<byte> m_data;
+    usize m_position { 0 };
+};
+}
+
+namespace di::serialization {
+/// @brief A pull-based reader which produces a stream of events from JSON input.
+///
+/// @tparam Reader The type of the reader to read from.
+///
+/// Unlike JsonDeserializer, this never materializes the document, which makes it possible to scan very large inputs
+/// for a few interesting fields in constant memory. Strings refer directly to the input whenever they contain no escape
+/// sequences. When the reader exposes its data directly (like io::SpanReader), the input is parsed in place, and
+/// strings are always delivered in one piece. Otherwise, the input is buffered, and long strings are delivered as a
+/// series of json::StringChunk events.
+///
+/// Uninteresting parts of the input can be skipped with skip(), which is much cheaper than reading their events. The
+/// input can consist of multiple top-level values (for instance, one per line), which are read one after another.
+///
+/// @see execution::async_json_events
+template<concepts::Impl<io::Reader> Reader>
+class JsonEventReader {
+public:
+    template<typename T = void>
+    using Result = Expected<T, json_deserializer::ErrorCode>;
+
+    /// @brief The longest key which can be read. Keys are never split, so longer keys are rejected.
+    constexpr static auto max_key_size = detail::JsonEventParser::max_key_size;
+
+    template<typename T>
+    requires(concepts::ConstructibleFrom<Reader, T>)
+    constexpr explicit JsonEventReader(T&& reader) : m_reader(util::forward<T>(reader)) {}
+
+    /// @brief Read the next event, or nullopt once the input has been read completely.
+    constexpr auto next() -> Result<Optional<json::Event>> {
+        for (;;) {
+            auto event = DI_TRY(m_parser.next(input(), at_end()));
+            DI_TRY(advance(m_parser.consumed()));
+            if (event || at_end()) {
+                return event;
+            }
+            DI_TRY(fill());
+        }
+    }
+
+    /// @brief Skip the rest of the current subtree.
+    ///
+    /// After a json::Key event, this skips the key's value. After json::BeginObject or json::BeginArray, or anywhere
+    /// else inside of an object or array, this skips the rest of the innermost one, including its end event. Otherwise,
+    /// this skips the next top-level value.
+    constexpr auto skip() -> Result<void> {
+        m_parser.begin_skip();
+        for (;;) {
+            auto done = DI_TRY(m_parser.skip(input(), at_end()));
+            DI_TRY(advance(m_parser.consumed()));
+            if (done) {
+                return {};
+            }
+            DI_TRY(fill());
+        }
+    }
+
+    constexpr auto reader() & -> Reader& { return m_reader; }
+    constexpr auto reader() const& -> Reader const& { return m_reader; }
+    constexpr auto reader() && -> Reader&& { return util::move(*this).m_reader; }
+
+private:
+    constexpr static auto parse_in_place = concepts::SpanBackedReader<meta::UnwrapReference<Reader>>;
+
+    constexpr auto input() const -> Span<byte const> {
+        if constexpr (parse_in_place) {
+            return util::unwrap_reference(m_reader).remaining();
+        } else {
+            return m_buffer.input();
+        }
+    }
+
+    constexpr auto at_end() const -> bool { return parse_in_place || m_at_end; }
+
+    constexpr auto advance(usize count) -> Result<void> {
+        if constexpr (parse_in_place) {
+            DI_TRY(util::unwrap_reference(m_reader).borrow(count).transform_error([](di::Error error) {
+                return json_deserializer::Error(json_deserializer::ReadError(di::move(error)), "."_s);
+            }));
+        } else {
+            m_buffer.advance(count);
+        }
+        return {};
+    }
+
+    constexpr auto fill() -> Result<void> {
+        auto buffer = m_buffer.prepare();
+        if (!buffer) {
+            return vocab::Unexpected(
+                json_deserializer::Error(json_deserializer::ReadError(BasicError::NotEnoughMemory), "."_s));
+        }
+        auto nread = DI_TRY(io::read_some(m_reader, *buffer).transform_error([](di::Error error) {
+            return json_deserializer::Error(json_deserializer::ReadError(di::move(error)), "."_s);
+        }));
+        m_buffer.commit(nread);
+        m_at_end = nread == 0;
+        return {};
+    }
+
+    Reader m_reader;
+    detail::JsonEventParser m_parser;
+    detail::JsonEventBuffer m_buffer;
+    bool m_at_end { false };
+};
+
+template<typename T>
+JsonEventReader(T&&) -> JsonEventReader<T>;
+}
+
+namespace di {
+using serialization::JsonEventReader;
+}
@@ -0,0 +1,283 @@
+#pragma once
+
+#include "di/bit/operation/bit_ceil.h"
+#include "di/container/algorithm/compare.h"
+#include "di/container/algorithm/equal.h"
+#include "di/container/allocator/allocator.h"
+#include "di/container/associative/map_interface.h"
+#include "di/container/string/string.h"
+#include "di/container/string/string_view.h"
+#include "di/container/vector/vector.h"
+#include "di/function/invoke.h"
+#include "di/meta/compare.h"
+#include "di/meta/core.h"
+#include "di/meta/operations.h"
+#include "di/platform/prelude.h"
+#include "di/types/prelude.h"
+#include "di/util/move.h"
+#include "di/vocab/expected/invoke_as_fallible.h"
+#include "di/vocab/expected/prelude.h"
+#include "di/vocab/tuple/tuple.h"
+
+namespace di::serialization::json {
+namespace detail {
+    template<concepts::Allocator Alloc>
+    using ObjectKey = container::string::StringImpl<container::string::Utf8Encoding, container::Vector<c8, Alloc>>;
+
+    struct ObjectValidForLookup {
+        template<typename U>
+        struct Type {
+            constexpr static bool value = concepts::ConvertibleTo<U const&, container::StringView>;
+        };
+    };
+
+    // 64 bit FNV-1a, computed over the key's code units.
+    constexpr auto object_key_hash(container::StringView key) -> u64 {
+        auto hash = u64(0xcbf29ce484222325);
+        for (auto code_unit : key.span()) {
+            hash ^= u64(code_unit);
+            hash *= u64(0x100000001b3);
+        }
+        return hash;
+    }
+}
+
+/// @brief The representation of a JSON object.
+///
+/// @tparam Value The JSON value type.
+/// @tparam Alloc The allocator used for the member list and keys.
+///
+/// Members are stored contiguously in insertion order, which is also the order they are serialized in. Small objects
+/// are searched linearly, which is faster than hashing for the handful of keys most objects have. Once an object grows
+/// past #index_threshold members, an open-addressed hash index over the member list is built and kept up to date on
+/// insertion, so that lookups stay constant time.
+///
+/// Erasing a member is linear in the size of the object, since later members are shifted down to preserve order.
+/// Comparison ignores the member order: objects with the same members are equal, regardless of the order they were
+/// inserted in, and objects are ordered as if their members were sorted by key.
+///
+/// @warning Keys must not be modified through iterators, as this would invalidate the hash index.
+template<typename Value, concepts::Allocator Alloc = platform::DefaultAllocator>
+class ObjectImpl
+    : public container::MapInterface<
+          ObjectImpl<Value, Alloc>, Tuple<detail::ObjectKey<Alloc>, Value>, detail::ObjectKey<Alloc>, Value,
+          Tuple<detail::ObjectKey<Alloc>, Value>*, Tuple<detail::ObjectKey<Alloc>, Value> const*,
+          detail::ObjectValidForLookup::Type, false> {
+private:
+    using Entry = Tuple<detail::ObjectKey<Alloc>, Value>;
+    using Iterator = Entry*;
+    using ConstIterator = Entry const*;
+
+    template<typename T>
+    using Result = meta::LikeExpected<meta::detail::VectorAllocResult<container::Vector<Entry, Alloc>>, T>;
+
+public:
+    /// The number of members above which a hash index is maintained.
+    constexpr static auto index_threshold = 8ZU;
+
+    ObjectImpl() = default;
+
+    constexpr explicit ObjectImpl(Alloc const& allocator) : m_entries(allocator), m_index(allocator) {}
+
+    constexpr auto size() const -> usize { return m_entries.size(); }
+    constexpr auto empty() const -> bool { return m_entries.empty(); }
+
+    constexpr auto begin() -> Iterator { return m_entries.begin(); }
+    constexpr auto begin() const -> ConstIterator { return m_entries.begin(); }
+    constexpr auto end() -> Iterator { return m_entries.end(); }
+    constexpr auto end() const -> ConstIterator { return m_entries.end(); }
+
+    constexpr void clear() {
+        m_entries.clear();
+        m_index.clear();
+    }
+
+    constexpr auto allocator() const -> Alloc const& { return m_entries.allocator(); }
+
+    constexpr auto unconst_iterator(ConstIterator it) -> Iterator { return const_cast<Iterator>(it); }
+
+    template<typename U, concepts::Invocable F>
+    requires(concepts::MaybeFallible<meta::InvokeResult<F>, Entry>)
+    constexpr auto insert_with_factory(U&& needle, F&& factory) {
+        if (auto it = find_impl(needle); it != end()) {
+            return Result<Tuple<Iterator, bool>>(Tuple(unconst_iterator(it), false));
+        }
+
+        if constexpr (concepts::FallibleAllocator<Alloc>) {
+            auto result = m_entries.emplace_back(function::invoke(util::forward<F>(factory)));
+            if (!result) {
+                return Result<Tuple<Iterator, bool>>(vocab::Unexpected(util::move(result).error()));
+            }
+            if (!did_append()) {
+                // There is no memory to grow the index, so undo the insertion to report the failure.
+                m_entries.pop_back();
+                return Result<Tuple<Iterator, bool>>(vocab::Unexpected(BasicError::NotEnoughMemory));
+            }
+            return Result<Tuple<Iterator, bool>>(Tuple(&*result, true));
+        } else {
+            auto& entry = m_entries.emplace_back(function::invoke(util::forward<F>(factory)));
+            did_append();
+            return Tuple(&entry, true);
+        }
+    }
+
+    template<typename U, concepts::Invocable F>
+    requires(concepts::MaybeFallible<meta::InvokeResult<F>, Entry>)
+    constexpr auto insert_with_factory(ConstIterator, U&& needle, F&& factory) {
+        return as_fallible(insert_with_factory(needle, util::forward<F>(factory))) % [](Tuple<Iterator, bool> result) {
+            return util::get<0>(result);
+        } | try_infallible;
+    }
+
+    template<typename U>
+    constexpr auto find_impl(U&& needle) const -> ConstIterator {
+        auto const key = as_key(needle);
+        if (m_index.empty()) {
+            for (auto const& entry : m_entries) {
+                if (key_equal(util::get<0>(entry).view(), key)) {
+                    return &entry;
+                }
+            }
+            return end();
+        }
+
+        auto const mask = m_index.size() - 1;
+        for (auto slot = usize(detail::object_key_hash(key)) & mask;; slot = (slot + 1) & mask) {
+            auto const index = m_index[slot];
+            if (index == 0) {
+                return end();
+            }
+            auto const& entry = m_entries[index - 1];
+            if (key_equal(util::get<0>(entry).view(), key)) {
+                return &entry;
+            }
+        }
+    }
+
+    constexpr auto erase_impl(ConstIterator position) -> Iterator {
+        auto result = m_entries.erase(position);
+        if (!m_index.empty()) {
+            // Every later member has shifted down, so the index must be rebuilt from scratch.
+            m_index.clear();
+            if (size() > index_threshold) {
+                // If this fails, lookups fall back to a linear search, which is still correct.
+                rebuild_index();
+            }
+        }
+        return result;
+    }
+
+    constexpr void merge_impl(ObjectImpl&& other) {
+        for (auto& entry : other.m_entries) {
+            this->try_emplace(util::move(util::get<0>(entry)), util::move(util::get<1>(entry)));
+        }
+        other.clear();
+    }
+
+private:
+    template<typename U>
+    constexpr static auto as_key(U const& needle) -> container::StringView {
+        if constexpr (concepts::SameAs<U, Entry>) {
+            return util::get<0>(needle).view();
+        } else {
+            return needle;
+        }
+    }
+
+    constexpr static auto key_equal(container::StringView a, container::StringView b) -> bool {
+        // Equal UTF-8 strings have equal code units, so there is no need to decode anything here.
+        return container::equal(a.span(), b.span());
+    }
+
+    // Returns false if the index could not be allocated.
+    constexpr auto did_append() -> bool {
+        if (m_index.empty()) {
+            return size() <= index_threshold || rebuild_index();
+        }
+
+        // Keep the load factor at or below 1/2, so that probe sequences stay short.
+        if (2 * size() > m_index.size()) {
+            m_index.clear();
+            return rebuild_index();
+        }
+        insert_into_index(size() - 1);
+        return true;
+    }
+
+    // On failure, the index is left empty, which makes lookups fall back to a linear search.
+    constexpr auto rebuild_index() -> bool {
+        if (!invoke_as_fallible([&] {
+                return m_index.resize(bit::bit_ceil(4 * size()));
+            })) {
+            m_index.clear();
+            return false;
+        }
+        for (auto i = usize(0); i < size(); i++) {
+            insert_into_index(i);
+        }
+        return true;
+    }
+
+    constexpr void insert_into_index(usize index) {
+        auto const mask = m_index.size() - 1;
+        auto slot = usize(detail::object_key_hash(util::get<0>(m_entries[index]).view())) & mask;
+        while (m_index[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        m_index[slot] = u32(index + 1);
+    }
+
+    // The member with the smallest key which is greater than the key of previous, or the smallest key overall if
+    // previous is null. Keys are compared by code unit, which for UTF-8 matches comparing by code point.
+    constexpr auto next_in_key_order(ConstIterator previous) const -> ConstIterator {
+        auto result = end();
+        for (auto const& entry : m_entries) {
+            auto const key = util::get<0>(entry).view().span();
+            if (previous && container::compare(key, util::get<0>(*previous).view().span()) <= 0) {
+                continue;
+            }
+            if (result == end() || container::compare(key, util::get<0>(*result).view().span()) < 0) {
+                result = &entry;
+            }
+        }
+        return result;
+    }
+
+    // Keys are unique, so objects of the same size are equal if every member of one is found in the other.
+    constexpr friend auto operator==(ObjectImpl const& a, ObjectImpl const& b) -> bool
+    requires(concepts::EqualityComparable<Value>)
+    {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (auto const& entry : a.m_entries) {
+            auto it = b.find_impl(util::get<0>(entry).view());
+            if (it == b.end() || !(util::get<1>(*it) == util::get<1>(entry))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // NOTE: this walks both objects in key order without allocating, which is quadratic in the size of the objects.
+    // Unlike equality, ordering objects is rare enough that this is preferable to sorting copies of them.
+    constexpr friend auto operator<=>(ObjectImpl const& a, ObjectImpl const& b) -> meta::CompareThreeWayResult<Entry>
+    requires(concepts::ThreeWayComparable<Entry>)
+    {
+        auto a_it = a.next_in_key_order(nullptr);
+        auto b_it = b.next_in_key_order(nullptr);
+        for (; a_it != a.end() && b_it != b.end(); a_it = a.next_in_key_order(a_it), b_it = b.next_in_key_order(b_it)) {
+            if (auto result = *a_it <=> *b_it; result != 0) {
+                return result;
+            }
+        }
+        return (a_it != a.end()) <=> (b_it != b.end());
+    }
+
+    container::Vector<Entry, Alloc> m_entries;
+
+    // Open-addressed table of 1-based indices into m_entries, where 0 marks an empty slot. This is empty while the
+    // object is at or below the index threshold.
+    container::Vector<u32, Alloc> m_index;
+};
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "di/bit/endian/endian.h"
+#include "di/bit/operation/countr_zero.h"
 #include "di/container/action/sequence.h"
 #include "di/container/interface/access.h"
 #include "di/container/string/fixed_string_to_utf8_string_view.h"
@@ -12,6 +14,7 @@
 #include "di/io/prelude.h"
 #include "di/io/string_writer.h"
 #include "di/io/write_exactly.h"
+#include "di/math/numeric_limits.h"
 #include "di/meta/core.h"
 #include "di/meta/language.h"
 #include "di/meta/operations.h"
@@ -27,6 +30,7 @@
 #include "di/util/exchange.h"
 #include "di/util/reference_wrapper.h"
 #include "di/util/scope_value_change.h"
+#include "di/vocab/array/array.h"
 #include "di/vocab/error/result.h"
 #include "di/vocab/tuple/tuple.h"
 #include "di/vocab/tuple/tuple_element.h"
@@ -51,6 +55,80 @@ namespace detail {
 
     template<typename S, concepts::TypeList T>
     constexpr static auto all_serializable = AllSerializable<S, T>::value;
+
+    constexpr auto json_needs_escape(c8 code_unit) -> bool {
+        return code_unit == '"' || code_unit == '\\' || code_unit < 0x20;
+    }
+
+    // Returns the offset of the first code unit at or after `position` which must be escaped in a JSON string, or the
+    // size of the string if there is none.
+    constexpr auto json_find_escape(Span<c8 const> code_units, usize position) -> usize {
+        if !consteval {
+            if constexpr (bit::Endian::Native == bit::Endian::Little) {
+                // Classify 8 bytes at a time. A byte is flagged when it is a quote, a backslash, or a control
+                // character, using the usual trick for finding zero bytes in a word. That trick can produce false
+                // positives, but only in bytes after a true positive, so the lowest flagged byte is always correct.
+                constexpr auto ones = u64(0x0101010101010101);
+                constexpr auto high_bits = u64(0x8080808080808080);
+                while (code_units.size() - position >= sizeof(u64)) {
+                    auto word = u64(0);
+                    __builtin_memcpy(&word, code_units.data() + position, sizeof(u64));
+
+                    auto const quotes = word ^ (ones * u8('"'));
+                    auto const backslashes = word ^ (ones * u8('\\'));
+                    auto const mask =
+                        ((word - ones * 0x20) | (quotes - ones) | (backslashes - ones)) & ~word & high_bits;
+                    if (mask != 0) {
+                        return position + usize(bit::countr_zero(mask) / 8);
+                    }
+                    position += sizeof(u64);
+                }
+            }
+        }
+        for (; position < code_units.size(); position++) {
+            if (json_needs_escape(code_units[position])) {
+                return position;
+            }
+        }
+        return code_units.size();
+    }
+
+    // Writes the decimal digits of an integer to the end of the buffer, two at a time, and returns the number of code
+    // units written.
+    template<concepts::Integral T, usize N>
+    constexpr auto json_format_integer(T value, Span<c8, N> buffer) -> usize {
+        constexpr auto digit_pairs = [] {
+            auto result = Array<c8, 200> {};
+            for (auto i = usize(0); i < 100; i++) {
+                result[2 * i] = c8('0' + i / 10);
+                result[2 * i + 1] = c8('0' + i % 10);
+            }
+            return result;
+        }();
+
+        using U = meta::MakeUnsigned<T>;
+        auto const negative = value < 0;
+        auto magnitude = negative ? U(U(0) - U(value)) : U(value);
+
+        auto position = buffer.size();
+        while (magnitude >= 100) {
+            auto const pair = usize(magnitude % 100) * 2;
+            magnitude /= 100;
+            buffer[--position] = digit_pairs[pair + 1];
+            buffer[--position] = digit_pairs[pair];
+        }
+        if (magnitude >= 10) {
+            auto const pair = usize(magnitude) * 2;
+            buffer[--position] = digit_pairs[pair + 1];
+            buffer[--position] = digit_pairs[pair];
+        } else {
+            buffer[--position] = c8('0' + magnitude);
+        }
+        if (negative) {
+            buffer[--position] = c8('-');
+        }
+        return buffer.size() - position;
+    }
 }
 
 class JsonSerializerConfig {
@@ -160,8 +238,7 @@ public:
     constexpr auto serialize_null() -> meta::WriterResult<void, Writer> {
         DI_TRY(serialize_comma());
 
-        DI_TRY(io::write_exactly(m_writer, "null"_sv));
-        return {};
+        return write("null"_sv);
     }
 
     constexpr auto serialize_bool(bool value) -> meta::WriterResult<void, Writer> {
@@ -174,59 +251,31 @@ public:
     constexpr auto serialize_string(container::StringView view) -> meta::WriterResult<void, Writer> {
         DI_TRY(serialize_comma());
 
+        // Write everything between code units which need escaping as a single run.
         DI_TRY(io::write_exactly(m_writer, '"'));
-        for (auto code_point_view : slide(view, 1)) {
-            auto code_point = *front(code_point_view);
-            // Check if we need to escape the code point
-            if (code_point == U'"' || code_point == U'\\' || code_point <= 0x1Fu) {
-                switch (code_point) {
-                    case U'"':
-                        DI_TRY(io::write_exactly(m_writer, "\\\""_sv));
-                        continue;
-                    case U'\\':
-                        DI_TRY(io::write_exactly(m_writer, "\\\\"_sv));
-                        continue;
-                    case U'\b':
-                        DI_TRY(io::write_exactly(m_writer, "\\b"_sv));
-                        continue;
-                    case U'\f':
-                        DI_TRY(io::write_exactly(m_writer, "\\f"_sv));
-                        continue;
-                    case U'\n':
-                        DI_TRY(io::write_exactly(m_writer, "\\n"_sv));
-                        continue;
-                    case U'\r':
-                        DI_TRY(io::write_exactly(m_writer, "\\r"_sv));
-                        continue;
-                    case U'\t':
-                        DI_TRY(io::write_exactly(m_writer, "\\t"_sv));
-                        continue;
-                    default:
-                        auto text = di::Array { c8('\\'), c8('u'), c8('0'), c8('0'), c8('0'), c8('0') };
-                        text[4] = to_hex_digit((code_point >> 4) & 0xF);
-                        text[5] = to_hex_digit(code_point & 0xF);
-                        DI_TRY(io::write_exactly(m_writer, StringView(encoding::assume_valid, text)));
-                        continue;
-                }
+        auto const code_units = view.span();
+        auto position = usize(0);
+        for (;;) {
+            auto const next = detail::json_find_escape(code_units, position);
+            DI_TRY(write(*code_units.subspan(position, next - position)));
+            if (next == code_units.size()) {
+                break;
             }
-            DI_TRY(io::write_exactly(m_writer, code_point_view));
+            DI_TRY(write_escaped(code_units[next]));
+            position = next + 1;
         }
         DI_TRY(io::write_exactly(m_writer, '"'));
         return {};
     }
 
-    constexpr auto serialize_number(concepts::Integral auto number) -> meta::WriterResult<void, Writer> {
+    template<concepts::Integral T>
+    constexpr auto serialize_number(T number) -> meta::WriterResult<void, Writer> {
         DI_TRY(serialize_comma());
 
-        using Enc = container::string::Utf8Encoding;
-        using TargetContext = fmt::BoundedFormatContext<Enc, meta::Constexpr<256ZU>>;
-        auto context = TargetContext {};
-        DI_TRY(di::fmt::vformat_encoded_context<Enc>(
-            di::container::string::StringViewImpl<Enc>(encoding::assume_valid, u8"{}", 2),
-            di::fmt::make_format_args<TargetContext>(number), context));
-
-        DI_TRY(io::write_exactly(m_writer, context.output()));
-        return {};
+        // NOTE: this is large enough for the digits and sign of any integer.
+        auto buffer = Array<c8, math::NumericLimits<meta::MakeUnsigned<T>>::bits * 3 / 10 + 2> {};
+        auto const size = detail::json_format_integer(number, buffer.span());
+        return write(*buffer.span().last(size));
     }
 
     template<concepts::InvocableTo<meta::WriterResult<void, Writer>, JsonSerializer&> F>
@@ -353,18 +402,54 @@ public:
     constexpr auto writer() && -> Writer&& { return util::move(*this).m_writer; }
 
 private:
+    constexpr auto write(Span<c8 const> code_units) -> meta::WriterResult<void, Writer> {
+        if consteval {
+            for (auto code_unit : code_units) {
+                DI_TRY(io::write_exactly(m_writer, char(code_unit)));
+            }
+            return {};
+        }
+        auto const* data = reinterpret_cast<byte const*>(code_units.data());
+        return io::write_exactly(m_writer, Span<byte const> { data, code_units.size() });
+    }
+
+    constexpr auto write(container::StringView view) -> meta::WriterResult<void, Writer> { return write(view.span()); }
+
+    constexpr auto write_escaped(c8 code_unit) -> meta::WriterResult<void, Writer> {
+        switch (code_unit) {
+            case '"':
+                return write("\\\""_sv);
+            case '\\':
+                return write("\\\\"_sv);
+            case '\b':
+                return write("\\b"_sv);
+            case '\f':
+                return write("\\f"_sv);
+            case '\n':
+                return write("\\n"_sv);
+            case '\r':
+                return write("\\r"_sv);
+            case '\t':
+                return write("\\t"_sv);
+            default: {
+                auto text = di::Array { c8('\\'), c8('u'), c8('0'), c8('0'), c8('0'), c8('0') };
+                text[4] = to_hex_digit((code_unit >> 4) & 0xF);
+                text[5] = to_hex_digit(code_unit & 0xF);
+                return write(text.span());
+            }
+        }
+    }
+
     constexpr auto serialize_true() -> meta::WriterResult<void, Writer> {
         DI_TRY(serialize_comma());
 
-        DI_TRY(io::write_exactly(m_writer, "true"_sv));
-        return {};
+        return write("true"_sv);
     }
 
     constexpr auto serialize_false() -> meta::WriterResult<void, Writer> {
         DI_TRY(serialize_comma());
 
-        DI_TRY(io::write_exactly(m_writer, "false"_sv));
-        return {};
+        return write("false"_sv);
     }
 
     constexpr auto serialize_comma() -> meta::WriterResult<void, Writer> {
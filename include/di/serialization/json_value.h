@@ -1,16 +1,18 @@
 #pragma once
 
 #include "di/container/algorithm/all_of.h"
+#include "di/container/allocator/allocator.h"
 #include "di/container/meta/container_value.h"
 #include "di/container/string/string.h"
 #include "di/container/string/string_view.h"
-#include "di/container/tree/tree_map.h"
 #include "di/container/vector/vector.h"
 #include "di/format/formatter.h"
 #include "di/function/tag_invoke.h"
 #include "di/io/interface/writer.h"
 #include "di/meta/compare.h"
 #include "di/meta/operations.h"
+#include "di/platform/prelude.h"
+#include "di/serialization/json_object.h"
 #include "di/serialization/json_serializer.h"
 #include "di/serialization/serialize.h"
 #include "di/types/prelude.h"
@@ -24,7 +26,8 @@
 #include "di/vocab/variant/variant.h"
 
 namespace di::serialization::json {
-class Value;
+template<concepts::Allocator Alloc>
+class BasicValue;
 
 struct Null {
     explicit Null() = default;
@@ -55,57 +58,95 @@ using Bool = bool;
 // NOTE: this should support floating point in the future.
 using Number = i64;
 
+template<concepts::Allocator Alloc>
+using BasicString = container::string::StringImpl<container::string::Utf8Encoding, container::Vector<c8, Alloc>>;
+
+template<concepts::Allocator Alloc>
+using BasicArray = container::Vector<BasicValue<Alloc>, Alloc>;
+
+template<concepts::Allocator Alloc>
+using BasicObject = ObjectImpl<BasicValue<Alloc>, Alloc>;
+
+template<concepts::Allocator Alloc>
+using BasicKeyValue = vocab::Tuple<BasicString<Alloc>, BasicValue<Alloc>>;
+
+using Value = BasicValue<platform::DefaultAllocator>;
 using String = container::String;
-using Array = container::Vector<Value>;
-using Object = container::TreeMap<container::String, Value>;
-using KeyValue = vocab::Tuple<String, Value>;
+using Array = BasicArray<platform::DefaultAllocator>;
+using Object = BasicObject<platform::DefaultAllocator>;
+using KeyValue = BasicKeyValue<platform::DefaultAllocator>;
 }
 
 namespace di::concepts::detail {
-template<>
-struct DefinitelyEqualityComparableWith<serialization::json::Value, serialization::json::Value> {
+template<concepts::Allocator Alloc>
+struct DefinitelyEqualityComparableWith<serialization::json::BasicValue<Alloc>,
+                                        serialization::json::BasicValue<Alloc>> {
     constexpr static bool value = true;
 };
 
-template<>
-struct DefinitelyEqualityComparableWith<serialization::json::Array, serialization::json::Array> {
+template<concepts::Allocator Alloc>
+struct DefinitelyEqualityComparableWith<serialization::json::BasicArray<Alloc>,
+                                        serialization::json::BasicArray<Alloc>> {
     constexpr static bool value = true;
 };
 
-template<>
-struct DefinitelyEqualityComparableWith<serialization::json::Object, serialization::json::Object> {
+template<concepts::Allocator Alloc>
+struct DefinitelyEqualityComparableWith<serialization::json::BasicObject<Alloc>,
+                                        serialization::json::BasicObject<Alloc>> {
     constexpr static bool value = true;
 };
 
-template<>
-struct DefinitelyEqualityComparableWith<serialization::json::KeyValue, serialization::json::KeyValue> {
+template<concepts::Allocator Alloc>
+struct DefinitelyEqualityComparableWith<serialization::json::BasicKeyValue<Alloc>,
+                                        serialization::json::BasicKeyValue<Alloc>> {
     constexpr static bool value = true;
 };
 
-template<>
-struct DefinitelyThreeWayComparableWith<serialization::json::Value, serialization::json::Value> {
+template<concepts::Allocator Alloc>
+struct DefinitelyThreeWayComparableWith<serialization::json::BasicValue<Alloc>,
+                                        serialization::json::BasicValue<Alloc>> {
     using Type = di::strong_ordering;
 };
 
-template<>
-struct DefinitelyThreeWayComparableWith<serialization::json::Array, serialization::json::Array> {
+template<concepts::Allocator Alloc>
+struct DefinitelyThreeWayComparableWith<serialization::json::BasicArray<Alloc>,
+                                        serialization::json::BasicArray<Alloc>> {
     using Type = di::strong_ordering;
 };
 
-template<>
-struct DefinitelyThreeWayComparableWith<serialization::json::Object, serialization::json::Object> {
+template<concepts::Allocator Alloc>
+struct DefinitelyThreeWayComparableWith<serialization::json::BasicObject<Alloc>,
+                                        serialization::json::BasicObject<Alloc>> {
     using Type = di::strong_ordering;
 };
 
-template<>
-struct DefinitelyThreeWayComparableWith<serialization::json::KeyValue, serialization::json::KeyValue> {
+template<concepts::Allocator Alloc>
+struct DefinitelyThreeWayComparableWith<serialization::json::BasicKeyValue<Alloc>,
+                                        serialization::json::BasicKeyValue<Alloc>> {
     using Type = di::strong_ordering;
 };
 }
 
 namespace di::serialization::json {
-class Value : public vocab::Variant<Null, Bool, Number, String, Array, Object> {
-    using Base = vocab::Variant<Null, Bool, Number, String, Array, Object>;
+/// @brief A dynamically typed JSON value.
+///
+/// @tparam Alloc The allocator used for strings, arrays, and objects.
+///
+/// Every container nested inside a value uses the same allocator type. When deserializing with a stateful allocator,
+/// like ArenaAllocator, the allocator is propagated to every container in the document, so that the whole document can
+/// be freed at once. Containers created afterwards by mutating the value (for instance, through operator[]) use a
+/// default constructed allocator.
+///
+/// @see from_json_string
+template<concepts::Allocator Alloc>
+class BasicValue
+    : public vocab::Variant<Null, Bool, Number, BasicString<Alloc>, BasicArray<Alloc>, BasicObject<Alloc>> {
+    using Base = vocab::Variant<Null, Bool, Number, BasicString<Alloc>, BasicArray<Alloc>, BasicObject<Alloc>>;
+
+    using String = BasicString<Alloc>;
+    using Array = BasicArray<Alloc>;
+    using Object = BasicObject<Alloc>;
+    using Value = BasicValue;
 
     constexpr static usize alternatives = 6;
 
@@ -0,0 +1,695 @@
+#pragma once
+
+#include "di/assert/assert_bool.h"
+#include "di/bit/endian/little_endian.h"
+#include "di/container/action/sequence_to.h"
+#include "di/container/concepts/contiguous_container.h"
+#include "di/container/concepts/sized_container.h"
+#include "di/container/interface/data.h"
+#include "di/container/interface/size.h"
+#include "di/container/meta/container_value.h"
+#include "di/container/string/constant_string.h"
+#include "di/container/string/encoding.h"
+#include "di/container/string/string_impl_forward_declaration.h"
+#include "di/container/string/string_view_impl_forward_declaration.h"
+#include "di/container/view/range.h"
+#include "di/container/view/transform.h"
+#include "di/function/monad/monad_try.h"
+#include "di/io/interface/reader.h"
+#include "di/io/interface/writer.h"
+#include "di/io/span_reader.h"
+#include "di/io/unchecked_span_writer.h"
+#include "di/io/write_exactly.h"
+#include "di/math/numeric_limits.h"
+#include "di/meta/constexpr.h"
+#include "di/meta/core.h"
+#include "di/meta/language.h"
+#include "di/meta/operations.h"
+#include "di/meta/util.h"
+#include "di/meta/vocab.h"
+#include "di/platform/prelude.h"
+#include "di/reflect/field.h"
+#include "di/reflect/valid_enum_value.h"
+#include "di/serialization/deserialize.h"
+#include "di/serialization/serialize.h"
+#include "di/types/byte.h"
+#include "di/types/in_place_type.h"
+#include "di/types/integers.h"
+#include "di/util/bit_cast.h"
+#include "di/util/create.h"
+#include "di/util/declval.h"
+#include "di/util/reference_wrapper.h"
+#include "di/util/unwrap_reference.h"
+#include "di/vocab/array/array.h"
+#include "di/vocab/error/result.h"
+#include "di/vocab/expected/invoke_as_fallible.h"
+#include "di/vocab/optional/prelude.h"
+#include "di/vocab/span/prelude.h"
+#include "di/vocab/tuple/tuple_element.h"
+#include "di/vocab/tuple/tuple_for_each.h"
+#include "di/vocab/tuple/tuple_sequence.h"
+#include "di/vocab/tuple/tuple_size.h"
+
+namespace di::serialization {
+struct TableFormat;
+
+namespace detail {
+    // Any bit pattern is a valid value of these types, so they can be used directly from untrusted data.
+    template<typename T>
+    concept TableRawScalar = (concepts::Integral<T> && !concepts::SameAs<meta::RemoveCV<T>, bool>) ||
+                             concepts::SameAs<meta::RemoveCV<T>, byte>;
+
+    // A bool must be 0 or 1 when read, and an enum must be one of its enumerators. So enums are only supported if they
+    // are reflected, which is what allows checking that.
+    template<typename T>
+    concept TableScalar = TableRawScalar<T> || concepts::SameAs<meta::RemoveCV<T>, bool> ||
+                          (concepts::Enum<T> && concepts::ReflectableToEnumerators<T>);
+
+    template<typename T>
+    concept TableString = concepts::detail::ConstantString<T>;
+
+    template<typename T>
+    concept TableBytes = !TableString<T> && !concepts::Optional<T> && concepts::ContiguousContainer<T> &&
+                         concepts::SizedContainer<T> && TableRawScalar<meta::RemoveCV<meta::ContainerValue<T>>> &&
+                         sizeof(meta::ContainerValue<T>) == 1;
+
+    template<typename T>
+    concept TableStruct = requires { typename meta::SerializeMetadata<TableFormat, T>; } &&
+                          concepts::InstanceOf<meta::SerializeMetadata<TableFormat, T>, reflection::Fields>;
+
+    template<typename T>
+    concept TableVector =
+        !TableString<T> && !TableBytes<T> && !concepts::Optional<T> && concepts::SizedContainer<T>;
+
+    template<typename T>
+    concept TableValue = TableScalar<T> || TableString<T> || TableBytes<T> || TableStruct<T> || TableVector<T>;
+
+    template<typename T>
+    concept TableField = TableValue<T> || (concepts::Optional<T> && TableValue<meta::OptionalValue<T>>);
+
+    // Tables and vectors use 32 bit sizes and offsets, so that offset tables stay small.
+    constexpr inline usize table_header_size = 2 * sizeof(u32);
+
+    constexpr auto table_load_u32(Span<byte const> data, usize offset) -> Optional<u32> {
+        if (offset > data.size() || data.size() - offset < sizeof(u32)) {
+            return nullopt;
+        }
+        auto bytes = Array<byte, sizeof(u32)> {};
+        for (auto i = usize(0); i < sizeof(u32); i++) {
+            bytes[i] = data[offset + i];
+        }
+        return u32(di::bit_cast<LittleEndian<u32>>(bytes));
+    }
+}
+
+template<typename T>
+class TableView;
+
+template<typename T>
+class TableVectorView;
+
+namespace detail {
+    template<typename T>
+    struct TableAccessHelper;
+
+    template<TableScalar T>
+    struct TableAccessHelper<T> : meta::TypeConstant<T> {};
+
+    template<TableString T>
+    struct TableAccessHelper<T> : meta::TypeConstant<container::string::StringViewImpl<meta::Encoding<T>>> {};
+
+    template<TableBytes T>
+    struct TableAccessHelper<T> : meta::TypeConstant<Span<meta::RemoveCV<meta::ContainerValue<T>> const>> {};
+
+    template<TableStruct T>
+    requires(!TableScalar<T> && !TableString<T> && !TableBytes<T>)
+    struct TableAccessHelper<T> : meta::TypeConstant<TableView<T>> {};
+
+    template<TableVector T>
+    requires(!TableStruct<T>)
+    struct TableAccessHelper<T> : meta::TypeConstant<TableVectorView<meta::RemoveCV<meta::ContainerValue<T>>>> {};
+
+    template<concepts::Optional T>
+    struct TableAccessHelper<T> : meta::TypeConstant<Optional<meta::Type<TableAccessHelper<meta::OptionalValue<T>>>>> {
+    };
+}
+
+}
+
+namespace di::meta {
+/// @brief The type used to access a value of type T stored in the table format, without deserializing it.
+template<typename T>
+using TableAccess = meta::Type<serialization::detail::TableAccessHelper<meta::RemoveCVRef<T>>>;
+}
+
+namespace di::serialization {
+namespace detail {
+    template<typename T>
+    constexpr auto table_read(Span<byte const> data, usize offset) -> Result<meta::TableAccess<T>>;
+
+    // Returns the index of the reflected field referring to the given member, or the number of fields if there is none.
+    template<typename M, auto member, usize index = 0>
+    constexpr auto table_field_index() -> usize {
+        if constexpr (index == meta::TupleSize<M>) {
+            return index;
+        } else {
+            using Field = meta::TupleElement<M, index>;
+            using Pointer = meta::RemoveCV<decltype(Field::pointer)>;
+            if constexpr (concepts::SameAs<Pointer, meta::RemoveCV<decltype(member)>>) {
+                if (Field::pointer == member) {
+                    return index;
+                }
+            }
+            return table_field_index<M, member, index + 1>();
+        }
+    }
+}
+
+/// @brief A view of a structure serialized in the table format, which reads fields in place.
+///
+/// Accessing a field only bounds checks and decodes that field, so large records can be queried without deserializing
+/// the whole thing. Fields which are absent (because the data was written by an older version of the structure, or
+/// because the field is an empty optional) read as their default value, and fields unknown to this version of the
+/// structure are ignored.
+///
+/// @see TableFormat
+template<typename T>
+class TableView {
+private:
+    using Fields = meta::SerializeMetadata<TableFormat, T>;
+
+public:
+    /// @brief Create a view of the table at the start of `data`, validating its header.
+    constexpr static auto create(Span<byte const> data) -> Result<TableView> {
+        auto const size = detail::table_load_u32(data, 0);
+        auto const field_count = detail::table_load_u32(data, sizeof(u32));
+        if (!size || !field_count || *size > data.size() || *size < detail::table_header_size ||
+            (*size - detail::table_header_size) / sizeof(u32) < *field_count) {
+            return di::Unexpected(BasicError::InvalidArgument);
+        }
+        return TableView(*data.first(*size), *field_count);
+    }
+
+    /// @brief Create an empty view, where every field is absent.
+    TableView() = default;
+
+    /// @brief The serialized bytes of this table.
+    constexpr auto data() const -> Span<byte const> { return m_data; }
+
+    /// @brief The number of fields written, which can differ from the number of fields T has.
+    constexpr auto field_count() const -> usize { return m_field_count; }
+
+    template<usize index>
+    requires(index < meta::TupleSize<Fields>)
+    constexpr auto has() const -> bool {
+        return field_offset(index) != 0;
+    }
+
+    template<usize index>
+    requires(index < meta::TupleSize<Fields>)
+    constexpr auto get() const -> Result<meta::TableAccess<typename meta::TupleElement<Fields, index>::Type>> {
+        using Value = meta::TupleElement<Fields, index>::Type;
+        auto const offset = field_offset(index);
+        if (offset == 0) {
+            return meta::TableAccess<Value> {};
+        }
+        // Fields must come after the offsets, so that reading nested values always moves forward in the data.
+        if (offset < detail::table_header_size + m_field_count * sizeof(u32)) {
+            return di::Unexpected(BasicError::InvalidArgument);
+        }
+        return detail::table_read<Value>(m_data, offset);
+    }
+
+    template<auto member>
+    requires(concepts::MemberObjectPointer<decltype(member)> &&
+             detail::table_field_index<Fields, member>() < meta::TupleSize<Fields>)
+    constexpr auto get() const {
+        return get<detail::table_field_index<Fields, member>()>();
+    }
+
+private:
+    constexpr explicit TableView(Span<byte const> data, usize field_count)
+        : m_data(data), m_field_count(field_count) {}
+
+    constexpr auto field_offset(usize index) const -> usize {
+        if (index >= m_field_count) {
+            return 0;
+        }
+        return *detail::table_load_u32(m_data, detail::table_header_size + index * sizeof(u32));
+    }
+
+    Span<byte const> m_data;
+    usize m_field_count { 0 };
+};
+
+/// @brief A view of a vector serialized in the table format, which reads elements in place.
+template<typename T>
+class TableVectorView {
+public:
+    constexpr static auto create(Span<byte const> data) -> Result<TableVectorView> {
+        auto const size = detail::table_load_u32(data, 0);
+        if (!size || (data.size() - sizeof(u32)) / element_stride < *size) {
+            return di::Unexpected(BasicError::InvalidArgument);
+        }
+        return TableVectorView(data, *size);
+    }
+
+    TableVectorView() = default;
+
+    constexpr auto size() const -> usize { return m_size; }
+    constexpr auto empty() const -> bool { return m_size == 0; }
+
+    constexpr auto operator[](usize index) const -> Result<meta::TableAccess<T>> {
+        DI_ASSERT(index < m_size);
+        auto const position = sizeof(u32) + index * element_stride;
+        if constexpr (detail::TableScalar<T>) {
+            return detail::table_read<T>(m_data, position);
+        } else {
+            // Elements must come after the offsets, so that reading nested values always moves forward in the data.
+            auto const offset = *detail::table_load_u32(m_data, position);
+            if (offset < sizeof(u32) + m_size * sizeof(u32)) {
+                return di::Unexpected(BasicError::InvalidArgument);
+            }
+            return detail::table_read<T>(m_data, offset);
+        }
+    }
+
+private:
+    // Scalars are stored inline, and everything else is stored through an offset relative to the vector.
+    constexpr static auto element_stride = detail::TableScalar<T> ? sizeof(T) : sizeof(u32);
+
+    constexpr explicit TableVectorView(Span<byte const> data, usize size) : m_data(data), m_size(size) {}
+
+    Span<byte const> m_data;
+    usize m_size { 0 };
+};
+
+namespace detail {
+    template<typename T>
+    constexpr auto table_read(Span<byte const> data, usize offset) -> Result<meta::TableAccess<T>> {
+        if constexpr (concepts::Optional<T>) {
+            return DI_TRY(table_read<meta::OptionalValue<T>>(data, offset));
+        } else if constexpr (TableScalar<T>) {
+            if (offset > data.size() || data.size() - offset < sizeof(T)) {
+                return di::Unexpected(BasicError::InvalidArgument);
+            }
+            auto bytes = Array<byte, sizeof(T)> {};
+            for (auto i = usize(0); i < sizeof(T); i++) {
+                bytes[i] = data[offset + i];
+            }
+            if constexpr (TableRawScalar<T>) {
+                return T(di::bit_cast<LittleEndian<T>>(bytes));
+            } else if constexpr (concepts::SameAs<T, bool>) {
+                auto const value = u8(di::bit_cast<LittleEndian<u8>>(bytes));
+                if (value > 1) {
+                    return di::Unexpected(BasicError::InvalidArgument);
+                }
+                return value != 0;
+            } else {
+                using Underlying = meta::UnderlyingType<T>;
+                auto const value = T(Underlying(di::bit_cast<LittleEndian<Underlying>>(bytes)));
+                if (!reflection::valid_enum_value(value)) {
+                    return di::Unexpected(BasicError::InvalidArgument);
+                }
+                return value;
+            }
+        } else if constexpr (TableString<T> || TableBytes<T>) {
+            auto const size = table_load_u32(data, offset);
+            if (!size || data.size() - offset - sizeof(u32) < *size) {
+                return di::Unexpected(BasicError::InvalidArgument);
+            }
+            auto const bytes = *data.subspan(offset + sizeof(u32), *size);
+            if constexpr (TableString<T>) {
+                using Enc = meta::Encoding<T>;
+                using CodeUnit = meta::EncodingCodeUnit<Enc>;
+                static_assert(sizeof(CodeUnit) == 1, "Only strings with single byte code units are supported.");
+
+                auto const code_units =
+                    Span<CodeUnit const> { reinterpret_cast<CodeUnit const*>(bytes.data()), bytes.size() };
+                if (!container::string::encoding::validate(Enc(), code_units)) {
+                    return di::Unexpected(BasicError::InvalidArgument);
+                }
+                return meta::TableAccess<T>(container::string::encoding::assume_valid, code_units.data(),
+                                            code_units.size());
+            } else {
+                using Value = meta::RemoveCV<meta::ContainerValue<T>>;
+                return Span<Value const> { reinterpret_cast<Value const*>(bytes.data()), bytes.size() };
+            }
+        } else if constexpr (TableStruct<T>) {
+            if (offset > data.size()) {
+                return di::Unexpected(BasicError::InvalidArgument);
+            }
+            return TableView<T>::create(*data.subspan(offset));
+        } else {
+            if (offset > data.size()) {
+                return di::Unexpected(BasicError::InvalidArgument);
+            }
+            return TableVectorView<meta::RemoveCV<meta::ContainerValue<T>>>::create(*data.subspan(offset));
+        }
+    }
+
+    template<typename T>
+    constexpr auto table_encoded_size(T const& value) -> usize;
+
+    template<typename T, typename M>
+    constexpr auto table_struct_size(T const& value, M fields) -> usize {
+        auto size = table_header_size + meta::TupleSize<M> * sizeof(u32);
+        tuple_for_each(
+            [&](auto field) {
+                auto const& field_value = field.get(value);
+                if constexpr (concepts::Optional<meta::RemoveCVRef<decltype(field_value)>>) {
+                    if (field_value) {
+                        size += table_encoded_size(*field_value);
+                    }
+                } else {
+                    size += table_encoded_size(field_value);
+                }
+            },
+            fields);
+        return size;
+    }
+
+    template<typename T>
+    constexpr auto table_encoded_size(T const& value) -> usize {
+        if constexpr (TableScalar<T>) {
+            return sizeof(T);
+        } else if constexpr (TableString<T>) {
+            return sizeof(u32) + value.span().size();
+        } else if constexpr (TableBytes<T>) {
+            return sizeof(u32) + container::size(value);
+        } else if constexpr (TableStruct<T>) {
+            return table_struct_size(value, meta::SerializeMetadata<TableFormat, T> {});
+        } else {
+            using Value = meta::RemoveCV<meta::ContainerValue<T>>;
+            if constexpr (TableScalar<Value>) {
+                return sizeof(u32) + container::size(value) * sizeof(Value);
+            } else {
+                auto size = sizeof(u32) + container::size(value) * sizeof(u32);
+                for (auto const& element : value) {
+                    size += table_encoded_size(element);
+                }
+                return size;
+            }
+        }
+    }
+}
+
+/// @brief A serializer for a schema-evolving binary format, which can be read in place.
+///
+/// @tparam Writer The type of the writer to write to.
+///
+/// Unlike the simple binary format, structures are written as tables. Each table starts with its total size and the
+/// number of fields written, followed by the offset of each field relative to the start of the table. An offset of 0
+/// marks an absent field, which is how empty optionals are stored. This makes it possible to both add fields to the end
+/// of a structure and to read records without parsing them (see TableView).
+///
+/// Integers and enums are stored inline in little endian. Since they are validated when read, enums must be reflected.
+/// Strings and arrays of bytes are stored as a 32 bit size followed by their data. Other containers are stored as a 32
+/// bit size, followed by either the elements (for integers and enums) or by the offset of each element relative to the
+/// start of the container.
+///
+/// To remain compatible with existing data, fields must only ever be appended to a structure, and never reordered or
+/// removed. A field which is no longer needed can be made optional and left empty instead.
+template<Impl<io::Writer> Writer>
+class TableSerializer {
+public:
+    using SerializationFormat = TableFormat;
+
+    template<concepts::NotDecaysTo<TableSerializer> T>
+    requires(ConstructibleFrom<Writer, T>)
+    // NOLINTNEXTLINE(bugprone-forwarding-reference-overload)
+    constexpr explicit TableSerializer(T&& writer) : m_writer(di::forward<T>(writer)) {}
+
+    template<typename T, concepts::InstanceOf<reflection::Fields> M>
+    requires(detail::TableStruct<meta::RemoveCVRef<T>>)
+    constexpr auto serialize(T&& value, M fields) -> meta::WriterResult<void, Writer> {
+        // NOTE: since nested tables are never larger than the outermost one, checking the size once is enough.
+        if (detail::table_struct_size(value, fields) > math::NumericLimits<u32>::max) {
+            return di::Unexpected(BasicError::ValueTooLarge);
+        }
+        return write_struct(value, fields);
+    }
+
+    constexpr auto writer() & -> Writer& { return m_writer; }
+    constexpr auto writer() const& -> Writer const& { return m_writer; }
+    constexpr auto writer() && -> Writer&& { return util::move(*this).m_writer; }
+
+private:
+    constexpr auto write(Span<byte const> bytes) -> meta::WriterResult<void, Writer> {
+        if constexpr (concepts::UncheckedWriter<meta::UnwrapReference<Writer>>) {
+            util::unwrap_reference(writer()).write_unchecked(bytes);
+            return {};
+        } else {
+            return io::write_exactly(writer(), bytes);
+        }
+    }
+
+    template<detail::TableScalar T>
+    constexpr auto write_scalar(T value) -> meta::WriterResult<void, Writer> {
+        auto const little_endian = LittleEndian<T>(value);
+        auto const as_bytes = di::bit_cast<Array<byte, sizeof(T)>>(little_endian);
+        return write(as_bytes.span());
+    }
+
+    template<typename T, typename M>
+    constexpr auto write_struct(T const& value, M fields) -> meta::WriterResult<void, Writer> {
+        DI_TRY(write_scalar(u32(detail::table_struct_size(value, fields))));
+        DI_TRY(write_scalar(u32(meta::TupleSize<M>)));
+
+        auto offset = detail::table_header_size + meta::TupleSize<M> * sizeof(u32);
+        DI_TRY(tuple_sequence<meta::WriterResult<void, Writer>>(
+            [&](auto field) -> meta::WriterResult<void, Writer> {
+                auto const& field_value = field.get(value);
+                if constexpr (concepts::Optional<meta::RemoveCVRef<decltype(field_value)>>) {
+                    if (!field_value) {
+                        return write_scalar(u32(0));
+                    }
+                    DI_TRY(write_scalar(u32(offset)));
+                    offset += detail::table_encoded_size(*field_value);
+                } else {
+                    DI_TRY(write_scalar(u32(offset)));
+                    offset += detail::table_encoded_size(field_value);
+                }
+                return {};
+            },
+            fields));
+
+        return tuple_sequence<meta::WriterResult<void, Writer>>(
+            [&](auto field) -> meta::WriterResult<void, Writer> {
+                auto const& field_value = field.get(value);
+                if constexpr (concepts::Optional<meta::RemoveCVRef<decltype(field_value)>>) {
+                    if (!field_value) {
+                        return {};
+                    }
+                    return write_value(*field_value);
+                } else {
+                    return write_value(field_value);
+                }
+            },
+            fields);
+    }
+
+    template<typename T>
+    constexpr auto write_value(T const& value) -> meta::WriterResult<void, Writer> {
+        if constexpr (detail::TableScalar<T>) {
+            return write_scalar(value);
+        } else if constexpr (detail::TableString<T>) {
+            auto const code_units = value.span();
+            DI_TRY(write_scalar(u32(code_units.size())));
+            return write(Span<byte const> { reinterpret_cast<byte const*>(code_units.data()), code_units.size() });
+        } else if constexpr (detail::TableBytes<T>) {
+            auto const size = container::size(value);
+            DI_TRY(write_scalar(u32(size)));
+            return write(Span<byte const> { reinterpret_cast<byte const*>(container::data(value)), size });
+        } else if constexpr (detail::TableStruct<T>) {
+            return write_struct(value, meta::SerializeMetadata<TableFormat, T> {});
+        } else {
+            using Value = meta::RemoveCV<meta::ContainerValue<T>>;
+            DI_TRY(write_scalar(u32(container::size(value))));
+            if constexpr (detail::TableScalar<Value>) {
+                for (auto const& element : value) {
+                    DI_TRY(write_scalar(element));
+                }
+                return {};
+            } else {
+                auto offset = sizeof(u32) + container::size(value) * sizeof(u32);
+                for (auto const& element : value) {
+                    DI_TRY(write_scalar(u32(offset)));
+                    offset += detail::table_encoded_size(element);
+                }
+                for (auto const& element : value) {
+                    DI_TRY(write_value(element));
+                }
+                return {};
+            }
+        }
+    }
+
+    Writer m_writer;
+};
+
+template<typename T>
+TableSerializer(T&&) -> TableSerializer<T>;
+
+namespace detail {
+    // Converts an in place view of a value into the value itself.
+    template<typename T>
+    constexpr auto table_materialize(meta::TableAccess<T> const& access) -> Result<T> {
+        if constexpr (concepts::Optional<T>) {
+            if (!access) {
+                return T();
+            }
+            return T(DI_TRY(table_materialize<meta::OptionalValue<T>>(*access)));
+        } else if constexpr (TableScalar<T> || concepts::SameAs<T, meta::TableAccess<T>>) {
+            // NOTE: this includes string views and spans, which refer to the serialized data.
+            return access;
+        } else if constexpr (TableString<T>) {
+            using Vec = decltype(di::declval<T>().take_underlying_vector());
+            auto vector = Vec();
+            if (!invoke_as_fallible([&] {
+                    return vector.append_container(access.span());
+                })) {
+                return di::Unexpected(BasicError::NotEnoughMemory);
+            }
+            return util::create<T>(di::move(vector));
+        } else if constexpr (TableBytes<T>) {
+            using Value = meta::RemoveCV<meta::ContainerValue<T>>;
+            return range(access.size()) | transform([&](usize index) -> Result<Value> {
+                       return access[index];
+                   }) |
+                   container::sequence_to<T>();
+        } else if constexpr (TableStruct<T>) {
+            // NOTE: for now, this requires T be default constructible. Absent fields keep their default values.
+            auto result = T {};
+            DI_TRY(tuple_sequence<Result<void>>(
+                [&]<typename F>(F field) -> Result<void> {
+                    using Value = meta::Type<F>;
+                    constexpr auto index = table_field_index<meta::SerializeMetadata<TableFormat, T>, F::pointer>();
+                    if (access.template has<index>()) {
+                        auto const field_access = DI_TRY(access.template get<index>());
+                        field.get(result) = DI_TRY(table_materialize<Value>(field_access));
+                    }
+                    return {};
+                },
+                meta::SerializeMetadata<TableFormat, T> {}));
+            return result;
+        } else {
+            using Value = meta::RemoveCV<meta::ContainerValue<T>>;
+            return range(access.size()) | transform([&](usize index) -> Result<Value> {
+                       return table_materialize<Value>(DI_TRY(access[index]));
+                   }) |
+                   container::sequence_to<T>();
+        }
+    }
+}
+
+/// @brief A deserializer for the table format.
+///
+/// @tparam Reader The type of the reader to read from, which must expose its data directly (like io::SpanReader).
+///
+/// Deserialization goes through a TableView, and so string views and spans of bytes refer directly to the serialized
+/// data.
+///
+/// @see TableSerializer
+template<Impl<io::Reader> Reader>
+class TableDeserializer {
+public:
+    template<typename T = void>
+    using Result = meta::ReaderResult<T, Reader>;
+
+    using DeserializationFormat = TableFormat;
+
+    template<concepts::NotDecaysTo<TableDeserializer> T>
+    requires(ConstructibleFrom<Reader, T>)
+    // NOLINTNEXTLINE(bugprone-forwarding-reference-overload)
+    constexpr explicit TableDeserializer(T&& reader) : m_reader(di::forward<T>(reader)) {}
+
+    template<concepts::DefaultConstructible T, concepts::InstanceOf<reflection::Fields> M>
+    requires(detail::TableStruct<T> && concepts::SpanBackedReader<meta::UnwrapReference<Reader>>)
+    constexpr auto deserialize(InPlaceType<T>, M) -> Result<T> {
+        auto& source = util::unwrap_reference(reader());
+        auto const view = DI_TRY(TableView<T>::create(source.remaining()));
+        auto result = DI_TRY(detail::table_materialize<T>(view));
+        DI_TRY(source.borrow(view.data().size()));
+        return result;
+    }
+
+    constexpr auto reader() & -> Reader& { return m_reader; }
+    constexpr auto reader() const& -> Reader const& { return m_reader; }
+    constexpr auto reader() && -> Reader&& { return util::move(*this).m_reader; }
+
+private:
+    Reader m_reader;
+};
+
+template<typename T>
+TableDeserializer(T&&) -> TableDeserializer<T>;
+
+struct TableFormat {
+    template<concepts::Impl<io::Writer> Writer, typename... Args>
+    requires(ConstructibleFrom<TableSerializer<meta::RemoveCVRef<Writer>>, Writer, Args...>)
+    constexpr static auto serializer(Writer&& writer, Args&&... args) {
+        return TableSerializer<meta::RemoveCVRef<Writer>>(di::forward<Writer>(writer), di::forward<Args>(args)...);
+    }
+
+    template<concepts::Impl<io::Reader> Reader, typename... Args>
+    requires(ConstructibleFrom<TableDeserializer<meta::RemoveCVRef<Reader>>, Reader, Args...>)
+    constexpr static auto deserializer(Reader&& reader, Args&&... args) {
+        return TableDeserializer<meta::RemoveCVRef<Reader>>(di::forward<Reader>(reader), di::forward<Args>(args)...);
+    }
+
+    // Tables know their own size, so there is no need to serialize them to find it.
+    template<typename T>
+    requires(detail::TableStruct<T>)
+    constexpr friend auto tag_invoke(types::Tag<serialize_size>, TableFormat, T const& value) -> usize {
+        return detail::table_encoded_size(value);
+    }
+};
+
+constexpr inline auto table_format = TableFormat {};
+
+namespace detail {
+    struct SerializeTableFunction {
+        template<Impl<io::Writer> Writer, Serializable<TableSerializer<Writer>> T, typename... Args>
+        requires(ConstructibleFrom<TableSerializer<ReferenceWrapper<meta::RemoveReference<Writer>>>,
+                                   ReferenceWrapper<meta::RemoveReference<Writer>>, Args...>)
+        constexpr auto operator()(Writer&& writer, T&& value, Args&&... args) const {
+            return serialize(table_format, di::ref(writer), value, di::forward<Args>(args)...);
+        }
+    };
+
+    template<typename T>
+    struct DeserializeTableFunction {
+        template<concepts::Impl<io::Reader> Reader, typename... Args>
+        requires(concepts::ConstructibleFrom<TableDeserializer<ReferenceWrapper<meta::RemoveCVRef<Reader>>>, Reader&,
+                                             Args...> &&
+                 concepts::Deserializable<T, TableDeserializer<ReferenceWrapper<meta::RemoveCVRef<Reader>>>>)
+        constexpr auto operator()(Reader&& reader, Args&&... args) const {
+            return serialization::deserialize<T>(table_format, ref(reader), util::forward<Args>(args)...);
+        }
+    };
+}
+
+constexpr inline auto serialize_table = detail::SerializeTableFunction {};
+
+template<typename T>
+constexpr inline auto deserialize_table = detail::DeserializeTableFunction<T> {};
+
+/// @brief Create a view of a structure serialized in the table format, without deserializing it.
+template<typename T>
+constexpr auto table_view(Span<byte const> data) -> Result<TableView<T>> {
+    return TableView<T>::create(data);
+}
+}
+
+namespace di {
+using serialization::deserialize_table;
+using serialization::serialize_table;
+using serialization::table_format;
+using serialization::table_view;
+using serialization::TableDeserializer;
+using serialization::TableFormat;
+using serialization::TableSerializer;
+using serialization::TableVectorView;
+using serialization::TableView;
+}
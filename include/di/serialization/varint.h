@@ -0,0 +1,130 @@
+#pragma once
+
+#include "di/math/numeric_limits.h"
+#include "di/meta/language.h"
+#include "di/types/byte.h"
+#include "di/types/integers.h"
+#include "di/vocab/optional/prelude.h"
+#include "di/vocab/span/prelude.h"
+#include "di/vocab/tuple/prelude.h"
+
+namespace di::serialization {
+/// @brief The maximum number of bytes needed to encode a value of type T as a LEB128 varint.
+template<concepts::Integral T>
+constexpr inline usize max_varint_size = (math::NumericLimits<meta::MakeUnsigned<T>>::bits + 6) / 7;
+
+/// @brief Map signed integers to unsigned ones such that values of small magnitude stay small.
+///
+/// This interleaves positive and negative values (0 -> 0, -1 -> 1, 1 -> 2, -2 -> 3, ...), so that a small negative
+/// number doesn't take the maximum number of bytes when encoded as a varint.
+template<concepts::Integral T>
+constexpr auto zigzag_encode(T value) -> meta::MakeUnsigned<T> {
+    using U = meta::MakeUnsigned<T>;
+    if constexpr (concepts::Signed<T>) {
+        return U((U(value) << 1) ^ U(value >> (math::NumericLimits<U>::bits - 1)));
+    } else {
+        return value;
+    }
+}
+
+template<concepts::Integral T>
+constexpr auto zigzag_decode(meta::MakeUnsigned<T> value) -> T {
+    if constexpr (concepts::Signed<T>) {
+        return T(T(value >> 1) ^ -T(value & 1));
+    } else {
+        return value;
+    }
+}
+
+/// @brief Encode an integer as a LEB128 varint, returning the number of bytes written to the output.
+///
+/// Signed integers are zigzag encoded first.
+template<concepts::Integral T>
+constexpr auto encode_varint(T value, Span<byte, max_varint_size<T>> output) -> usize {
+    auto raw = zigzag_encode(value);
+    auto size = usize(0);
+    while (raw >= 0x80) {
+        output[size++] = byte((raw & 0x7F) | 0x80);
+        raw >>= 7;
+    }
+    output[size++] = byte(raw);
+    return size;
+}
+
+namespace detail {
+    // Decodes a single varint, returning the number of bytes consumed, or 0 if the input is truncated or the value does
+    // not fit.
+    template<concepts::Integral T>
+    constexpr auto decode_one_varint(Span<byte const> input, T& output) -> usize {
+        using U = meta::MakeUnsigned<T>;
+        constexpr auto bits = math::NumericLimits<U>::bits;
+
+        auto raw = U(0);
+        for (auto i = usize(0); i < input.size() && i < max_varint_size<T>; i++) {
+            auto const part = U(u8(input[i]) & 0x7F);
+            auto const shift = i * 7;
+            if (shift + 7 > bits && (part >> (bits - shift)) != 0) {
+                return 0;
+            }
+            raw |= part << shift;
+            if ((u8(input[i]) & 0x80) == 0) {
+                output = zigzag_decode<T>(raw);
+                return i + 1;
+            }
+        }
+        return 0;
+    }
+}
+
+/// @brief Decode a LEB128 varint from the start of the input.
+///
+/// @return The decoded value and the number of bytes consumed, or nullopt if the input is truncated or malformed.
+template<concepts::Integral T>
+constexpr auto decode_varint(Span<byte const> input) -> Optional<Tuple<T, usize>> {
+    auto value = T(0);
+    auto const size = detail::decode_one_varint(input, value);
+    if (size == 0) {
+        return nullopt;
+    }
+    return make_tuple(value, size);
+}
+
+/// @brief Decode an array of varints from the start of the input.
+///
+/// @return The number of bytes consumed, or nullopt if the input does not contain `output.size()` valid varints.
+///
+/// Arrays of integers are typically dominated by small values, which encode as a single byte. So this checks the
+/// continuation bits of 8 bytes at a time, and when none are set, emits all 8 values without any per-byte branching.
+template<concepts::Integral T>
+constexpr auto decode_varints(Span<byte const> input, Span<T> output) -> Optional<usize> {
+    constexpr auto continuation_bits = u64(0x8080808080808080);
+
+    auto in = usize(0);
+    auto out = usize(0);
+    while (out < output.size()) {
+        if (input.size() - in >= 8 && output.size() - out >= 8) {
+            // NOTE: this is recognized as a single unaligned load by the compiler.
+            auto word = u64(0);
+            for (auto i = usize(0); i < 8; i++) {
+                word |= u64(u8(input[in + i])) << (i * 8);
+            }
+            if ((word & continuation_bits) == 0) {
+                for (auto i = usize(0); i < 8; i++) {
+                    output[out + i] = zigzag_decode<T>(meta::MakeUnsigned<T>((word >> (i * 8)) & 0xFF));
+                }
+                in += 8;
+                out += 8;
+                continue;
+            }
+        }
+
+        auto const size = detail::decode_one_varint(*input.subspan(in), output[out]);
+        if (size == 0) {
+            return nullopt;
+        }
+        in += size;
+        out++;
+    }
+    return in;
+}
+}
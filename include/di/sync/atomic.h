@@ -140,6 +140,17 @@ public:
         return as_ref().fetch_xor(value, order);
     }
 
+    void wait(T old, MemoryOrder order = MemoryOrder::SequentialConsistency) const { as_ref().wait(old, order); }
+    void wait(T old, MemoryOrder order = MemoryOrder::SequentialConsistency) const volatile {
+        as_ref().wait(old, order);
+    }
+
+    void notify_one() { as_ref().notify_one(); }
+    void notify_one() volatile { as_ref().notify_one(); }
+
+    void notify_all() { as_ref().notify_all(); }
+    void notify_all() volatile { as_ref().notify_all(); }
+
 private:
     T m_value;
 };
@@ -2,6 +2,7 @@
 
 #include "di/meta/core.h"
 #include "di/meta/language.h"
+#include "di/sync/atomic_wait.h"
 #include "di/sync/memory_order.h"
 #include "di/types/prelude.h"
 #include "di/util/addressof.h"
@@ -151,6 +152,15 @@ public:
         return __atomic_fetch_xor(m_pointer, value, util::to_underlying(order));
     }
 
+    void wait(T old, MemoryOrder order = MemoryOrder::SequentialConsistency) const {
+        detail::atomic_wait(m_pointer, old, [&] {
+            return load(order);
+        });
+    }
+
+    void notify_one() const { detail::atomic_notify(m_pointer, false); }
+    void notify_all() const { detail::atomic_notify(m_pointer, true); }
+
 private:
     T* m_pointer { nullptr };
 };
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "di/sync/memory_order.h"
+#include "di/util/to_underlying.h"
+
+namespace di::sync {
+inline void atomic_thread_fence(MemoryOrder order) {
+    __atomic_thread_fence(util::to_underlying(order));
+}
+}
+
+namespace di {
+using sync::atomic_thread_fence;
+}
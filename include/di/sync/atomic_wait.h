@@ -0,0 +1,130 @@
+#pragma once
+
+#include "di/platform/interference_size.h"
+#include "di/sync/atomic_thread_fence.h"
+#include "di/sync/cpu_relax.h"
+#include "di/sync/memory_order.h"
+#include "di/types/prelude.h"
+#include "di/util/to_underlying.h"
+
+// Blocking on an atomic is built on a single primitive, which sleeps on a 32 bit word until it is woken, as long as the
+// word still holds an expected value. On Linux, this is the futex system call, which is used regardless of whether or
+// not the standard library is available. Elsewhere, std::atomic_ref<u32>::wait() is used, unless DI_NO_USE_STD or
+// DI_CUSTOM_ATOMIC_WAIT is defined, in which case these functions must be defined by the environment.
+#if defined(DI_CUSTOM_ATOMIC_WAIT) || (defined(DI_NO_USE_STD) && !defined(__linux__))
+namespace di::sync::detail {
+void wait_on_address(u32 const* address, u32 expected);
+void wake_by_address(u32 const* address, bool all);
+}
+#elifdef __linux__
+#include "di/platform/linux_syscall.h"
+
+namespace di::sync::detail {
+inline void wait_on_address(u32 const* address, u32 expected) {
+    platform::linux_syscall::futex_wait(address, expected);
+}
+
+inline void wake_by_address(u32 const* address, bool all) {
+    platform::linux_syscall::futex_wake(address, all ? 0x7fffffff : 1);
+}
+}
+#else
+#include <atomic>
+
+namespace di::sync::detail {
+inline void wait_on_address(u32 const* address, u32 expected) {
+    std::atomic_ref<u32>(*const_cast<u32*>(address)).wait(expected, std::memory_order_relaxed);
+}
+
+inline void wake_by_address(u32 const* address, bool all) {
+    auto ref = std::atomic_ref<u32>(*const_cast<u32*>(address));
+    if (all) {
+        ref.notify_all();
+    } else {
+        ref.notify_one();
+    }
+}
+}
+#endif
+
+namespace di::sync::detail {
+// Every waiter registers itself in the parking slot its address hashes to, so that notifying an atomic nobody is
+// waiting on costs a single load instead of a system call. Values which are not 32 bits wide cannot be waited on
+// directly, so they instead sleep on the slot's sequence counter, which is bumped on every notification.
+struct alignas(platform::hardware_destructive_interference_size) ParkingSlot {
+    u32 waiters { 0 };
+    u32 sequence { 0 };
+};
+
+constexpr inline usize parking_table_size = 256;
+
+constinit inline ParkingSlot parking_table[parking_table_size] {};
+
+inline auto parking_slot(void const* address) -> ParkingSlot& {
+    auto const value = reinterpret_cast<uptr>(address);
+    return parking_table[((value >> 2) ^ (value >> 10)) % parking_table_size];
+}
+
+// The number of times the value is rechecked before going to sleep, which avoids a system call for short waits.
+constexpr inline usize atomic_wait_spin_count = 64;
+
+template<typename T>
+constexpr inline bool waits_on_address = sizeof(T) == sizeof(u32) && alignof(T) >= alignof(u32);
+
+template<typename T>
+auto same_representation(T const& a, T const& b) -> bool {
+    return __builtin_memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+template<typename T, typename Load>
+void atomic_wait(T const* address, T old, Load load) {
+    for (auto i = usize(0); i < atomic_wait_spin_count; i++) {
+        if (!same_representation(load(), old)) {
+            return;
+        }
+        cpu_relax();
+    }
+
+    auto& slot = parking_slot(address);
+    for (;;) {
+        // Registering as a waiter must be ordered before rechecking the value, which pairs with the fence in
+        // atomic_notify(), so that either the waiter observes the new value or the notifier observes the waiter. The
+        // recheck may be a relaxed load, which a sequentially consistent read-modify-write alone does not order, so
+        // this needs a fence as well.
+        __atomic_fetch_add(&slot.waiters, 1, util::to_underlying(MemoryOrder::SequentialConsistency));
+        atomic_thread_fence(MemoryOrder::SequentialConsistency);
+        if constexpr (waits_on_address<T>) {
+            if (same_representation(load(), old)) {
+                wait_on_address(reinterpret_cast<u32 const*>(address), __builtin_bit_cast(u32, old));
+            }
+        } else {
+            auto const sequence = __atomic_load_n(&slot.sequence, util::to_underlying(MemoryOrder::Acquire));
+            if (same_representation(load(), old)) {
+                wait_on_address(&slot.sequence, sequence);
+            }
+        }
+        __atomic_fetch_sub(&slot.waiters, 1, util::to_underlying(MemoryOrder::Release));
+
+        if (!same_representation(load(), old)) {
+            return;
+        }
+    }
+}
+
+template<typename T>
+void atomic_notify(T const* address, bool all) {
+    auto& slot = parking_slot(address);
+    atomic_thread_fence(MemoryOrder::SequentialConsistency);
+    if (__atomic_load_n(&slot.waiters, util::to_underlying(MemoryOrder::SequentialConsistency)) == 0) {
+        return;
+    }
+
+    if constexpr (waits_on_address<T>) {
+        wake_by_address(reinterpret_cast<u32 const*>(address), all);
+    } else {
+        // Other addresses may share this slot, so everyone must be woken up to avoid losing the notification.
+        __atomic_fetch_add(&slot.sequence, 1, util::to_underlying(MemoryOrder::SequentialConsistency));
+        wake_by_address(&slot.sequence, true);
+    }
+}
+}
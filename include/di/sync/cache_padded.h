@@ -0,0 +1,84 @@
+#pragma once
+
+#include "di/meta/operations.h"
+#include "di/platform/interference_size.h"
+#include "di/types/byte.h"
+#include "di/util/addressof.h"
+#include "di/util/forward.h"
+
+namespace di::sync {
+/// @brief Wrap a value so that it occupies its own cache line.
+///
+/// @tparam T The type of the value.
+///
+/// Values which are frequently written by different threads, like atomic counters, suffer from false sharing when they
+/// are placed next to unrelated data: every write invalidates the cache line for all other threads, even those which
+/// only access the neighboring fields. Wrapping such values in CachePadded aligns and pads them to
+/// hardware_destructive_interference_size, which prevents this at the cost of some memory.
+///
+/// @note Over-alignment is not honoured everywhere, most notably in coroutine frames, which are only aligned to
+/// __STDCPP_DEFAULT_NEW_ALIGNMENT__. Values which may live in such memory should use CacheIsolated instead.
+template<typename T>
+class alignas(platform::hardware_destructive_interference_size) CachePadded {
+public:
+    CachePadded()
+    requires(concepts::DefaultConstructible<T>)
+    = default;
+
+    template<typename... Args>
+    requires(concepts::ConstructibleFrom<T, Args...>)
+    constexpr explicit CachePadded(Args&&... args) : m_value(util::forward<Args>(args)...) {}
+
+    constexpr auto get() -> T& { return m_value; }
+    constexpr auto get() const -> T const& { return m_value; }
+
+    constexpr auto operator*() -> T& { return m_value; }
+    constexpr auto operator*() const -> T const& { return m_value; }
+
+    constexpr auto operator->() -> T* { return util::addressof(m_value); }
+    constexpr auto operator->() const -> T const* { return util::addressof(m_value); }
+
+private:
+    T m_value {};
+};
+
+/// @brief Wrap a value so that it does not share a cache line with its neighbors, without over-aligning it.
+///
+/// @tparam T The type of the value.
+///
+/// Unlike CachePadded, the value is surrounded by enough padding to be isolated wherever it is placed, so this works
+/// in memory which does not honour over-alignment. The cost is nearly twice as much padding.
+template<typename T>
+class CacheIsolated {
+public:
+    CacheIsolated()
+    requires(concepts::DefaultConstructible<T>)
+    = default;
+
+    template<typename... Args>
+    requires(concepts::ConstructibleFrom<T, Args...>)
+    constexpr explicit CacheIsolated(Args&&... args) : m_value(util::forward<Args>(args)...) {}
+
+    constexpr auto get() -> T& { return m_value; }
+    constexpr auto get() const -> T const& { return m_value; }
+
+    constexpr auto operator*() -> T& { return m_value; }
+    constexpr auto operator*() const -> T const& { return m_value; }
+
+    constexpr auto operator->() -> T* { return util::addressof(m_value); }
+    constexpr auto operator->() const -> T const* { return util::addressof(m_value); }
+
+private:
+    // The value's alignment guarantees that this much padding reaches the edge of the cache lines it occupies.
+    constexpr static auto padding_size = platform::hardware_destructive_interference_size - alignof(T);
+
+    byte m_padding_before[padding_size] {};
+    T m_value {};
+    byte m_padding_after[padding_size] {};
+};
+}
+
+namespace di {
+using sync::CacheIsolated;
+using sync::CachePadded;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "di/meta/core.h"
+#include "di/meta/language.h"
+#include "di/sync/concepts/lock.h"
+
+namespace di::concepts {
+template<typename T>
+concept SharedLock = Lock<T> && requires(T& lock) {
+    { lock.lock_shared() } -> LanguageVoid;
+    { lock.try_lock_shared() } -> SameAs<bool>;
+    { lock.unlock_shared() } -> LanguageVoid;
+};
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "di/platform/architecture.h"
+
+namespace di::sync {
+inline void cpu_relax() {
+#ifdef DI_X86_64
+    asm volatile("pause" ::: "memory");
+#elifdef DI_ARM64
+    asm volatile("isb" ::: "memory");
+#endif
+}
+}
+
+namespace di {
+using sync::cpu_relax;
+}
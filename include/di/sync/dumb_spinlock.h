@@ -1,18 +1,10 @@
 #pragma once
 
-#include "di/platform/architecture.h"
 #include "di/sync/atomic.h"
 #include "di/sync/concepts/lock.h"
+#include "di/sync/cpu_relax.h"
 
 namespace di::sync {
-inline void cpu_relax() {
-#ifdef DI_X86_64
-    asm volatile("pause" ::: "memory");
-#elifdef DI_ARM64
-    asm volatile("isb" ::: "memory");
-#endif
-}
-
 class DumbSpinlock {
 public:
     DumbSpinlock() = default;
@@ -39,6 +31,5 @@ private:
 }
 
 namespace di {
-using sync::cpu_relax;
 using sync::DumbSpinlock;
 }
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "di/sync/atomic.h"
+#include "di/sync/concepts/lock.h"
+#include "di/sync/cpu_relax.h"
+#include "di/types/prelude.h"
+
+namespace di::sync {
+/// @brief A mutual exclusion lock which spins briefly before putting the caller to sleep.
+///
+/// Contended lockers first spin with exponential backoff, which is enough to acquire the lock without a system call
+/// when critical sections are short. If the lock is still held after that, or if another thread is already sleeping on
+/// it, the caller parks using Atomic::wait(), so that oversubscribed threads do not burn CPU time the lock holder
+/// needs to make progress. Unlocking only issues a wake up when some thread has actually parked.
+///
+/// This is the default lock in DI_NO_USE_STD builds.
+///
+/// @see TicketLock
+class Mutex {
+private:
+    enum class State : u32 {
+        Unlocked,
+        Locked,
+        LockedWithWaiters,
+    };
+
+public:
+    /// The largest number of times cpu_relax() is called between attempts to acquire the lock while spinning.
+    constexpr static usize max_backoff = 64;
+
+    Mutex() = default;
+
+    Mutex(Mutex const&) = delete;
+    auto operator=(Mutex const&) -> Mutex& = delete;
+
+    void lock() {
+        if (try_lock()) {
+            return;
+        }
+
+        for (auto backoff = usize(1); backoff <= max_backoff; backoff *= 2) {
+            for (auto i = usize(0); i < backoff; i++) {
+                cpu_relax();
+            }
+
+            auto state = m_state.load(MemoryOrder::Relaxed);
+            if (state == State::LockedWithWaiters) {
+                break;
+            }
+            if (state == State::Unlocked &&
+                m_state.compare_exchange_weak(state, State::Locked, MemoryOrder::Acquire, MemoryOrder::Relaxed)) {
+                return;
+            }
+        }
+
+        // Since there is no way to know whether other threads are parked, the lock is conservatively marked as
+        // contended once this thread acquires it after sleeping.
+        while (m_state.exchange(State::LockedWithWaiters, MemoryOrder::Acquire) != State::Unlocked) {
+            m_state.wait(State::LockedWithWaiters, MemoryOrder::Relaxed);
+        }
+    }
+
+    auto try_lock() -> bool {
+        auto expected = State::Unlocked;
+        return m_state.compare_exchange_strong(expected, State::Locked, MemoryOrder::Acquire, MemoryOrder::Relaxed);
+    }
+
+    void unlock() {
+        if (m_state.exchange(State::Unlocked, MemoryOrder::Release) == State::LockedWithWaiters) {
+            m_state.notify_one();
+        }
+    }
+
+private:
+    Atomic<State> m_state { State::Unlocked };
+};
+
+static_assert(concepts::Lock<Mutex>, "Mutex must model di::Lock");
+}
+
+namespace di {
+using sync::Mutex;
+}
@@ -2,11 +2,22 @@
 
 #include "di/sync/atomic.h"
 #include "di/sync/atomic_ref.h"
+#include "di/sync/atomic_thread_fence.h"
+#include "di/sync/cache_padded.h"
+#include "di/sync/concepts/shared_lock.h"
 #include "di/sync/concepts/stoppable_token.h"
 #include "di/sync/concepts/stoppable_token_for.h"
 #include "di/sync/concepts/unstoppable_token.h"
+#include "di/sync/cpu_relax.h"
 #include "di/sync/dumb_spinlock.h"
 #include "di/sync/memory_order.h"
+#include "di/sync/mutex.h"
+#include "di/sync/read_mostly.h"
 #include "di/sync/scoped_lock.h"
+#include "di/sync/scoped_shared_lock.h"
+#include "di/sync/seq_lock.h"
+#include "di/sync/shared_mutex.h"
+#include "di/sync/stat_counter.h"
 #include "di/sync/stop_token/prelude.h"
 #include "di/sync/synchronized.h"
+#include "di/sync/ticket_lock.h"
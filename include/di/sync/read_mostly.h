@@ -0,0 +1,169 @@
+#pragma once
+
+#include "di/assert/assert_bool.h"
+#include "di/container/intrusive/list.h"
+#include "di/function/invoke.h"
+#include "di/meta/core.h"
+#include "di/meta/operations.h"
+#include "di/platform/interference_size.h"
+#include "di/platform/prelude.h"
+#include "di/sync/atomic.h"
+#include "di/sync/atomic_thread_fence.h"
+#include "di/sync/concepts/lock.h"
+#include "di/sync/cpu_relax.h"
+#include "di/sync/memory_order.h"
+#include "di/sync/scoped_lock.h"
+#include "di/types/prelude.h"
+#include "di/util/forward.h"
+#include "di/util/move.h"
+#include "di/util/scope_exit.h"
+
+namespace di::sync {
+/// @brief A cell holding a value which is read frequently and updated rarely.
+///
+/// @tparam T The type of the value.
+/// @tparam Lock The lock used to serialize writers and reader registration.
+///
+/// The value is stored as an immutable snapshot, which readers access without taking any lock. Writers copy the
+/// current snapshot, modify the copy, and publish it with an atomic pointer swap. The previous snapshot is freed once
+/// every reader which could still observe it has finished, using epoch-based reclamation.
+///
+/// Each thread reads through its own ReadMostly::Reader, which holds the epoch that thread is currently reading in, on
+/// a cache line of its own. This means a read only loads shared state and writes to memory private to the reader, so
+/// readers on different CPUs never contend with each other. The cost is paid by writers, who must wait for all
+/// readers in an older epoch to finish before reclaiming the old snapshot.
+///
+/// @warning Reads must not be nested, and readers must not block for long periods, as this stalls writers.
+///
+/// @see Synchronized
+template<typename T, concepts::Lock Lock = DefaultLock>
+class ReadMostly {
+public:
+    /// @brief A registered reader of a ReadMostly cell.
+    ///
+    /// A Reader must only be used by a single thread at a time, and must not outlive the cell it reads.
+    class alignas(platform::hardware_destructive_interference_size) Reader : public container::IntrusiveListNode<> {
+    public:
+        explicit Reader(ReadMostly& cell) : m_cell(cell) { m_cell.register_reader(*this); }
+
+        ~Reader() { m_cell.unregister_reader(*this); }
+
+        template<concepts::Invocable<T const&> Fun>
+        auto read(Fun&& function) -> meta::InvokeResult<Fun, T const&> {
+            DI_ASSERT(m_epoch.load(MemoryOrder::Relaxed) == 0);
+
+            // Announcing the epoch must be ordered before loading the snapshot, which pairs with the fence in
+            // ReadMostly::publish(), so that either the writer observes this reader or this reader observes the new
+            // snapshot.
+            m_epoch.store(m_cell.m_epoch.load(MemoryOrder::Acquire), MemoryOrder::Relaxed);
+            atomic_thread_fence(MemoryOrder::SequentialConsistency);
+
+            auto guard = ScopeExit([&] {
+                m_epoch.store(0, MemoryOrder::Release);
+            });
+            return function::invoke(util::forward<Fun>(function), *m_cell.m_current.load(MemoryOrder::Acquire));
+        }
+
+    private:
+        friend class ReadMostly;
+
+        ReadMostly& m_cell;
+
+        // The epoch this reader is reading in, or 0 if it is not reading. This is on its own cache line, so that
+        // it can be written without disturbing other readers.
+        alignas(platform::hardware_destructive_interference_size) Atomic<u64> m_epoch { 0 };
+    };
+
+    ReadMostly()
+    requires(concepts::DefaultConstructible<T>)
+        : m_current(new T()) {}
+
+    template<typename U>
+    requires(!concepts::SameAs<meta::RemoveCVRef<U>, InPlace> && !concepts::RemoveCVRefSameAs<U, ReadMostly> &&
+             concepts::ConstructibleFrom<T, U>)
+    explicit ReadMostly(U&& value) : m_current(new T(util::forward<U>(value))) {}
+
+    template<typename... Args>
+    requires(concepts::ConstructibleFrom<T, Args...>)
+    explicit ReadMostly(InPlace, Args&&... args) : m_current(new T(util::forward<Args>(args)...)) {}
+
+    ReadMostly(ReadMostly&&) = delete;
+
+    ~ReadMostly() {
+        DI_ASSERT(m_readers.empty());
+        delete m_current.load(MemoryOrder::Relaxed);
+    }
+
+    /// @brief Register a new reader for the calling thread.
+    auto reader() -> Reader { return Reader(*this); }
+
+    /// @brief Replace the value with a modified copy of the current snapshot.
+    ///
+    /// This blocks until no reader can observe the previous snapshot.
+    template<concepts::Invocable<T&> Fun>
+    requires(concepts::CopyConstructible<T>)
+    void update(Fun&& function) {
+        auto guard = ScopedLock(m_lock);
+        auto* next = new T(*m_current.load(MemoryOrder::Relaxed));
+        function::invoke(util::forward<Fun>(function), *next);
+        publish(next);
+    }
+
+    /// @brief Replace the value.
+    ///
+    /// This blocks until no reader can observe the previous snapshot.
+    void store(T value) {
+        auto guard = ScopedLock(m_lock);
+        publish(new T(util::move(value)));
+    }
+
+    /// @brief Copy the current value, without registering a reader.
+    ///
+    /// This takes the writer lock, and so is only suitable for threads which read the value infrequently.
+    auto read() const -> T
+    requires(concepts::CopyConstructible<T>)
+    {
+        auto guard = ScopedLock(m_lock);
+        return *m_current.load(MemoryOrder::Relaxed);
+    }
+
+private:
+    void register_reader(Reader& reader) {
+        auto guard = ScopedLock(m_lock);
+        m_readers.push_back(reader);
+    }
+
+    void unregister_reader(Reader& reader) {
+        auto guard = ScopedLock(m_lock);
+        m_readers.erase(reader);
+    }
+
+    // Must be called with m_lock held.
+    void publish(T* next) {
+        auto* previous = m_current.exchange(next, MemoryOrder::AcquireRelease);
+        auto const epoch = m_epoch.fetch_add(1, MemoryOrder::SequentialConsistency) + 1;
+        atomic_thread_fence(MemoryOrder::SequentialConsistency);
+
+        // Any reader still in an older epoch may have loaded the previous snapshot.
+        for (auto& reader : m_readers) {
+            for (;;) {
+                auto const reader_epoch = reader.m_epoch.load(MemoryOrder::Acquire);
+                if (reader_epoch == 0 || reader_epoch >= epoch) {
+                    break;
+                }
+                cpu_relax();
+            }
+        }
+        delete previous;
+    }
+
+    Atomic<T*> m_current;
+    Atomic<u64> m_epoch { 1 };
+    container::IntrusiveList<Reader> m_readers;
+    Lock mutable m_lock {};
+};
+}
+
+namespace di {
+using sync::ReadMostly;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "di/sync/concepts/shared_lock.h"
+
+namespace di::sync {
+template<concepts::SharedLock Lock>
+class ScopedSharedLock {
+public:
+    constexpr explicit ScopedSharedLock(Lock& lock) : m_lock(lock) { m_lock.lock_shared(); }
+
+    ScopedSharedLock(ScopedSharedLock const&) = delete;
+    auto operator=(ScopedSharedLock const&) -> ScopedSharedLock& = delete;
+
+    constexpr ~ScopedSharedLock() { m_lock.unlock_shared(); }
+
+private:
+    Lock& m_lock;
+};
+}
+
+namespace di {
+using sync::ScopedSharedLock;
+}
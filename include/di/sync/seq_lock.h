@@ -0,0 +1,117 @@
+#pragma once
+
+#include "di/meta/operations.h"
+#include "di/meta/trivial.h"
+#include "di/sync/atomic.h"
+#include "di/sync/atomic_thread_fence.h"
+#include "di/sync/cpu_relax.h"
+#include "di/sync/memory_order.h"
+#include "di/types/byte.h"
+#include "di/types/prelude.h"
+#include "di/util/bit_cast.h"
+
+namespace di::sync {
+/// @brief A cell for small, trivially copyable values, which readers access without writing to shared memory.
+///
+/// @tparam T The type of the value, which must be trivially copyable.
+///
+/// A writer makes the sequence number odd, copies the new value in, and then makes the sequence number even again.
+/// Readers copy the value out between two reads of the sequence number, and retry if a write was in progress or
+/// happened in the meantime. This means reads never modify shared cache lines, unlike taking a lock, so concurrent
+/// readers scale perfectly. The trade off is that readers can be starved by a continuous stream of writes, and that
+/// every read copies the whole value, so this is best suited for small values which change rarely, like statistics or
+/// clock calibration data.
+///
+/// The value is stored as an array of words which are accessed using relaxed atomic operations, so that a torn read
+/// racing with a writer is well-defined, and is simply discarded.
+///
+/// @see ReadMostly
+template<concepts::TriviallyCopyable T>
+class SeqLock {
+private:
+    using Word = uptr;
+
+    constexpr static usize word_count = (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+
+    struct Words {
+        Word words[word_count];
+    };
+
+public:
+    SeqLock()
+    requires(concepts::DefaultConstructible<T>)
+        : SeqLock(T()) {}
+
+    explicit SeqLock(T const& value) { write(value); }
+
+    SeqLock(SeqLock const&) = delete;
+    auto operator=(SeqLock const&) -> SeqLock& = delete;
+
+    auto load() const -> T {
+        for (;;) {
+            auto const before = m_sequence.load(MemoryOrder::Acquire);
+            if (before & 1) {
+                cpu_relax();
+                continue;
+            }
+
+            auto words = Words {};
+            for (auto i = usize(0); i < word_count; i++) {
+                words.words[i] = m_words[i].load(MemoryOrder::Relaxed);
+            }
+
+            // Order the reads of the value before rechecking the sequence number.
+            atomic_thread_fence(MemoryOrder::Acquire);
+            if (m_sequence.load(MemoryOrder::Relaxed) == before) {
+                return from_words(words);
+            }
+        }
+    }
+
+    /// @brief Replace the value.
+    ///
+    /// Concurrent writers are serialized against each other, by waiting for the sequence number to become even.
+    void store(T const& value) {
+        auto sequence = m_sequence.load(MemoryOrder::Relaxed);
+        for (;;) {
+            if (!(sequence & 1) && m_sequence.compare_exchange_weak(sequence, sequence + 1, MemoryOrder::Relaxed,
+                                                                     MemoryOrder::Relaxed)) {
+                break;
+            }
+            cpu_relax();
+            sequence = m_sequence.load(MemoryOrder::Relaxed);
+        }
+
+        // Order making the sequence number odd before the writes of the value.
+        atomic_thread_fence(MemoryOrder::Release);
+        write(value);
+        m_sequence.store(sequence + 2, MemoryOrder::Release);
+    }
+
+private:
+    static auto from_words(Words const& words) -> T {
+        struct Storage {
+            alignas(T) byte bytes[sizeof(T)];
+        };
+
+        auto storage = Storage {};
+        __builtin_memcpy(storage.bytes, words.words, sizeof(T));
+        return util::bit_cast<T>(storage);
+    }
+
+    void write(T const& value) {
+        auto words = Words {};
+        __builtin_memcpy(words.words, &value, sizeof(T));
+        for (auto i = usize(0); i < word_count; i++) {
+            m_words[i].store(words.words[i], MemoryOrder::Relaxed);
+        }
+    }
+
+    Atomic<usize> m_sequence { 0 };
+    Atomic<Word> m_words[word_count];
+};
+}
+
+namespace di {
+using sync::SeqLock;
+}
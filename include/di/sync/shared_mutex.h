@@ -0,0 +1,112 @@
+#pragma once
+
+#include "di/sync/atomic.h"
+#include "di/sync/concepts/shared_lock.h"
+#include "di/types/prelude.h"
+
+namespace di::sync {
+/// @brief A reader-writer lock, which allows any number of readers or a single writer.
+///
+/// The lock state is a single 32 bit word, holding the number of readers along with flags for an active writer and
+/// for parked threads. Blocked threads sleep using Atomic::wait(), and are only woken up when a thread has actually
+/// parked.
+///
+/// Writers are preferred: once a writer is waiting, new readers block until it has acquired and released the lock,
+/// so that a steady stream of readers cannot starve writers out.
+///
+/// @see Mutex
+class SharedMutex {
+private:
+    constexpr static auto writer = u32(1) << 31;
+    constexpr static auto waiters = u32(1) << 30;
+    constexpr static auto reader_mask = waiters - 1;
+
+public:
+    SharedMutex() = default;
+
+    SharedMutex(SharedMutex const&) = delete;
+    auto operator=(SharedMutex const&) -> SharedMutex& = delete;
+
+    void lock() {
+        auto state = m_state.load(MemoryOrder::Relaxed);
+        for (;;) {
+            // The waiters flag is preserved, since other threads may still be parked.
+            if ((state & (writer | reader_mask)) == 0) {
+                if (m_state.compare_exchange_weak(state, state | writer, MemoryOrder::Acquire, MemoryOrder::Relaxed)) {
+                    return;
+                }
+                continue;
+            }
+            if (!park(state)) {
+                continue;
+            }
+            state = m_state.load(MemoryOrder::Relaxed);
+        }
+    }
+
+    auto try_lock() -> bool {
+        auto state = m_state.load(MemoryOrder::Relaxed);
+        if ((state & (writer | reader_mask)) != 0) {
+            return false;
+        }
+        return m_state.compare_exchange_strong(state, state | writer, MemoryOrder::Acquire, MemoryOrder::Relaxed);
+    }
+
+    void unlock() {
+        if (m_state.exchange(0, MemoryOrder::Release) & waiters) {
+            m_state.notify_all();
+        }
+    }
+
+    void lock_shared() {
+        auto state = m_state.load(MemoryOrder::Relaxed);
+        for (;;) {
+            if ((state & (writer | waiters)) == 0) {
+                if (m_state.compare_exchange_weak(state, state + 1, MemoryOrder::Acquire, MemoryOrder::Relaxed)) {
+                    return;
+                }
+                continue;
+            }
+            if (!park(state)) {
+                continue;
+            }
+            state = m_state.load(MemoryOrder::Relaxed);
+        }
+    }
+
+    auto try_lock_shared() -> bool {
+        auto state = m_state.load(MemoryOrder::Relaxed);
+        if ((state & (writer | waiters)) != 0) {
+            return false;
+        }
+        return m_state.compare_exchange_strong(state, state + 1, MemoryOrder::Acquire, MemoryOrder::Relaxed);
+    }
+
+    void unlock_shared() {
+        // The last reader to leave wakes up the parked writer.
+        if (m_state.fetch_sub(1, MemoryOrder::Release) == (waiters | 1)) {
+            m_state.notify_all();
+        }
+    }
+
+private:
+    // Mark the lock as having waiters and sleep until the state changes. Returns false without sleeping if the state
+    // changed before the flag could be set, in which case state is updated to the current value.
+    auto park(u32& state) -> bool {
+        if ((state & waiters) == 0 &&
+            !m_state.compare_exchange_weak(state, state | waiters, MemoryOrder::Relaxed, MemoryOrder::Relaxed)) {
+            return false;
+        }
+        m_state.wait(state | waiters, MemoryOrder::Relaxed);
+        return true;
+    }
+
+    Atomic<u32> m_state { 0 };
+};
+
+static_assert(concepts::SharedLock<SharedMutex>, "SharedMutex must model di::SharedLock");
+}
+
+namespace di {
+using sync::SharedMutex;
+}
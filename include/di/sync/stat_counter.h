@@ -0,0 +1,70 @@
+#pragma once
+
+#include "di/sync/atomic.h"
+#include "di/sync/cache_padded.h"
+#include "di/sync/memory_order.h"
+#include "di/types/prelude.h"
+
+namespace di::sync {
+/// @brief A counter which many threads can update concurrently without contending with each other.
+///
+/// The count is split into shards, each on its own cache line, and every update only touches the calling thread's
+/// shard. Reading the counter sums all shards, which is cheap but only approximate while updates are in flight, so this
+/// is meant for statistics which are updated often and read rarely, like request or byte counts.
+///
+/// Arithmetic wraps around, so subtracting from the counter is supported as long as the total does not go negative.
+///
+/// @note Threads are assigned to shards by hashing the address of the caller's stack. Since each thread has its own
+/// stack, this spreads threads over the shards without any platform support for thread or CPU identifiers. Threads
+/// which hash to the same shard remain correct, but contend as if they shared a single atomic.
+class StatCounter {
+public:
+    /// The number of shards, which bounds the number of threads which can update the counter without contention.
+    constexpr static usize shard_count = 16;
+
+    StatCounter() = default;
+
+    StatCounter(StatCounter const&) = delete;
+    auto operator=(StatCounter const&) -> StatCounter& = delete;
+
+    void add(u64 amount = 1) { shard().fetch_add(amount, MemoryOrder::Relaxed); }
+    void sub(u64 amount = 1) { shard().fetch_sub(amount, MemoryOrder::Relaxed); }
+
+    /// @brief Read the sum of all shards.
+    ///
+    /// Updates which happen concurrently with this call may or may not be included.
+    auto load() const -> u64 {
+        auto result = u64(0);
+        for (auto const& shard : m_shards) {
+            result += shard->load(MemoryOrder::Relaxed);
+        }
+        return result;
+    }
+
+    /// @brief Reset the counter to 0.
+    ///
+    /// Updates which happen concurrently with this call may or may not be lost.
+    void reset() {
+        for (auto& shard : m_shards) {
+            shard->store(0, MemoryOrder::Relaxed);
+        }
+    }
+
+private:
+    auto shard() -> Atomic<u64>& {
+        auto marker = 0;
+        auto const address = reinterpret_cast<uptr>(&marker);
+
+        // Stacks of different threads are usually megabytes apart, so only the high bits of the address are used. This
+        // also keeps a thread on the same shard regardless of its call depth.
+        auto const hash = (address >> 20) * u64(0x9e3779b97f4a7c15);
+        return *m_shards[(hash >> 32) % shard_count];
+    }
+
+    CachePadded<Atomic<u64>> m_shards[shard_count];
+};
+}
+
+namespace di {
+using sync::StatCounter;
+}
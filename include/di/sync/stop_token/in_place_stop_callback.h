@@ -17,8 +17,11 @@ public:
                                                   util::move(static_cast<InPlaceStopCallback*>(self)->m_callback));
                                           })
         , m_callback(util::forward<C>(callback)) {
+        // Tokens which can never be stopped skip registration entirely, as do tokens which were already stopped.
         if (m_parent) {
-            if (!m_parent->try_add_callback(this)) {
+            if (m_parent->stop_requested() || !m_parent->try_add_callback(this)) {
+                // The callback was never registered, so there is nothing to remove on destruction.
+                m_already_executed.store(true, MemoryOrder::Relaxed);
                 function::invoke(util::move(m_callback));
             }
         }
@@ -1,11 +1,11 @@
 #pragma once
 
-#include "di/container/intrusive/prelude.h"
 #include "di/sync/atomic.h"
 #include "di/sync/stop_token/forward_declaration.h"
+#include "di/util/immovable.h"
 
 namespace di::sync::detail {
-class InPlaceStopCallbackBase : public container::IntrusiveListNode<> {
+class InPlaceStopCallbackBase : util::Immovable {
 private:
     friend class ::di::sync::InPlaceStopSource;
 
@@ -22,5 +22,9 @@ protected:
 
 private:
     void execute() { m_execute(this); }
+
+    // The next callback in the parent's list. This is written before the callback is published, and afterwards only
+    // while holding the parent's lock.
+    InPlaceStopCallbackBase* m_next { nullptr };
 };
 }
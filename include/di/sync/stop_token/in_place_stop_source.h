@@ -1,13 +1,23 @@
 #pragma once
 
-#include "di/container/intrusive/prelude.h"
+#include "di/assert/assert_bool.h"
 #include "di/platform/prelude.h"
 #include "di/sync/atomic.h"
+#include "di/sync/cpu_relax.h"
 #include "di/sync/stop_token/forward_declaration.h"
 #include "di/sync/stop_token/in_place_stop_callback_base.h"
 #include "di/sync/synchronized.h"
+#include "di/types/prelude.h"
 
 namespace di::sync {
+/// @brief A stop source which does not allocate, and whose callbacks live inside the stop callback objects.
+///
+/// Registered callbacks form an intrusive singly linked list, whose head is stored in a single atomic word along with
+/// the stop and lock flags. Registering a callback is lock-free: it pushes the callback onto the head of the list with
+/// a compare-and-swap, which fails once a stop was requested. Deregistering a callback must physically unlink it
+/// before its memory is reused, so this takes a short lock, which registrations never wait on. Since callbacks are
+/// usually destroyed in the reverse order they were registered, this is normally a single compare-and-swap at the head
+/// of the list.
 class InPlaceStopSource {
 private:
     template<typename>
@@ -15,21 +25,26 @@ private:
 
     friend class detail::InPlaceStopCallbackBase;
 
-    constexpr static u8 stop_flag = 1;
-    constexpr static u8 locked_flag = 2;
+    using CallbackBase = detail::InPlaceStopCallbackBase;
+
+    constexpr static uptr stop_flag = 1;
+    constexpr static uptr locked_flag = 2;
+    constexpr static uptr flag_mask = stop_flag | locked_flag;
+
+    static_assert(alignof(CallbackBase) > flag_mask, "Stop callbacks must leave room for flags in their address");
 
 public:
     InPlaceStopSource() = default;
 
     InPlaceStopSource(InPlaceStopSource&&) = delete;
 
-    ~InPlaceStopSource() { DI_ASSERT(m_callbacks.empty()); }
+    ~InPlaceStopSource() { DI_ASSERT(!head(m_state.load(MemoryOrder::Relaxed))); }
 
     [[nodiscard]] auto get_stop_token() const -> InPlaceStopToken;
     [[nodiscard]] auto stop_requested() const -> bool { return m_state.load(MemoryOrder::Acquire) & stop_flag; }
 
     auto request_stop() -> bool {
-        if (!lock_unless_stopped(true)) {
+        if (!lock(true)) {
             // Already stopped, return false.
             return false;
         }
@@ -37,73 +52,79 @@ public:
         // Remember the thread id which requested the stop.
         m_stopper_thread = get_current_thread_id();
 
-        // With the lock now aquired, iterate through each stop callback.
-        while (!m_callbacks.empty()) {
-            auto& callback = *m_callbacks.front();
-
+        // With the lock now aquired, iterate through each stop callback. Since the stop flag is set, no new callbacks
+        // can be registered, so the head of the list only changes while holding the lock.
+        while (auto* callback = head(m_state.load(MemoryOrder::Relaxed))) {
             // Mark the callback as being executed, with relaxed memory order
             // since this is synchronized by the spin lock.
             bool did_destroy_itself = false;
-            callback.m_did_destruct_in_same_thread.store(util::addressof(did_destroy_itself), MemoryOrder::Relaxed);
+            callback->m_did_destruct_in_same_thread.store(util::addressof(did_destroy_itself), MemoryOrder::Relaxed);
 
             // Remove the current callback from the list.
-            m_callbacks.pop_front();
+            m_state.store(reinterpret_cast<uptr>(callback->m_next) | stop_flag | locked_flag, MemoryOrder::Relaxed);
 
             // Unlock the list, allowing callback destructors the ability to
             // lock the list and remove themselves.
-            unlock(true);
+            unlock();
 
             // Execute the callback.
-            callback.execute();
+            callback->execute();
 
-            // Mark the callback as already done, if the object still exists.
+            // Mark the callback as already done, if the object still exists. The notification only uses the address
+            // of the flag, so it is fine if a waiting destructor has already run by then.
             if (!did_destroy_itself) {
-                callback.m_already_executed.store(true, MemoryOrder::Release);
+                callback->m_already_executed.store(true, MemoryOrder::Release);
+                callback->m_already_executed.notify_all();
             }
 
             // Reaquire the lock.
-            lock(true);
+            lock(false);
         }
 
-        unlock(true);
+        unlock();
         return true;
     }
 
 private:
-    auto try_add_callback(detail::InPlaceStopCallbackBase* callback) const -> bool {
-        if (!lock_unless_stopped(false)) {
-            return false;
-        }
+    static auto head(uptr state) -> CallbackBase* { return reinterpret_cast<CallbackBase*>(state & ~flag_mask); }
 
-        m_callbacks.push_front(*callback);
+    auto try_add_callback(CallbackBase* callback) const -> bool {
+        auto state = m_state.load(MemoryOrder::Relaxed);
+        for (;;) {
+            if (state & stop_flag) {
+                return false;
+            }
 
-        unlock(false);
-        return true;
+            // Pushing onto the list does not need the lock, so the lock flag is preserved as is.
+            callback->m_next = head(state);
+            if (m_state.compare_exchange_weak(state, reinterpret_cast<uptr>(callback) | (state & locked_flag),
+                                              MemoryOrder::Release, MemoryOrder::Relaxed)) {
+                return true;
+            }
+        }
     }
 
-    void remove_callback(detail::InPlaceStopCallbackBase* callback) const {
-        // Simple case: no stop request has happened.
-        if (lock_unless_stopped(false)) {
-            m_callbacks.erase(*callback);
+    void remove_callback(CallbackBase* callback) const {
+        lock(false);
 
-            unlock(false);
+        // Simple case: no stop request has happened.
+        if (!(m_state.load(MemoryOrder::Relaxed) & stop_flag)) {
+            unlink(callback);
+            unlock();
             return;
         }
 
-        // If a stop request occurred, synchronize on the spin lock.
-        lock(true);
-
         auto stopper_thread = m_stopper_thread;
         auto* did_destruct_in_same_thread = callback->m_did_destruct_in_same_thread.load(MemoryOrder::Relaxed);
         bool going_to_be_executed = !!did_destruct_in_same_thread;
 
         // Remove ourselves from the list with the lock held.
         if (!going_to_be_executed) {
-            m_callbacks.erase(*callback);
+            unlink(callback);
         }
 
         // Now unlock the spin lock.
-        unlock(true);
+        unlock();
 
         if (going_to_be_executed) {
             // If we are being executed by the current thread, notify the callback runner this object
@@ -112,44 +133,56 @@ private:
                 *did_destruct_in_same_thread = true;
             } else {
                 // Otherwise, wait for the callback's execution to complete before finishing.
-                while (!callback->m_already_executed.load(MemoryOrder::Acquire)) {
-                    ;
-                }
+                callback->m_already_executed.wait(false, MemoryOrder::Acquire);
             }
         }
     }
 
-    auto lock_unless_stopped(bool set_stop) const -> bool {
-        u8 flags = set_stop ? (stop_flag | locked_flag) : locked_flag;
+    // Must be called with the lock held.
+    void unlink(CallbackBase* callback) const {
+        // The callback is usually at the head of the list. This must use a compare-and-swap, since other callbacks
+        // can be pushed concurrently.
+        auto state = m_state.load(MemoryOrder::Acquire);
+        while (head(state) == callback) {
+            if (m_state.compare_exchange_weak(state, reinterpret_cast<uptr>(callback->m_next) | (state & flag_mask),
+                                              MemoryOrder::AcquireRelease, MemoryOrder::Acquire)) {
+                return;
+            }
+        }
+
+        // Otherwise, search for its predecessor. New callbacks are only ever pushed onto the head, so the rest of the
+        // list cannot change while the lock is held.
+        auto* previous = head(state);
+        while (previous->m_next != callback) {
+            DI_ASSERT(previous->m_next);
+            previous = previous->m_next;
+        }
+        previous->m_next = callback->m_next;
+    }
+
+    // Acquire the lock. If set_stop is true, this also sets the stop flag, and fails if it was already set.
+    auto lock(bool set_stop) const -> bool {
+        auto const flags = set_stop ? (stop_flag | locked_flag) : locked_flag;
 
-        u8 expected = m_state.load(MemoryOrder::Relaxed);
+        auto state = m_state.load(MemoryOrder::Relaxed);
         for (;;) {
-            // If already locked, return false.
-            if (expected & stop_flag) {
+            if (set_stop && (state & stop_flag)) {
                 return false;
             }
-
-            if (m_state.compare_exchange_weak(expected, flags, MemoryOrder::AcquireRelease, MemoryOrder::Relaxed)) {
-                // Lock aquired, return true.
+            if (state & locked_flag) {
+                cpu_relax();
+                state = m_state.load(MemoryOrder::Relaxed);
+                continue;
+            }
+            if (m_state.compare_exchange_weak(state, state | flags, MemoryOrder::Acquire, MemoryOrder::Relaxed)) {
                 return true;
             }
         }
     }
 
-    void lock(bool set_stop) const {
-        u8 flags = set_stop ? (stop_flag | locked_flag) : locked_flag;
-        while (!m_state.exchange(flags, MemoryOrder::Acquire)) {
-            ;
-        }
-    }
-
-    void unlock(bool set_stop) const {
-        u8 flags = set_stop ? stop_flag : 0;
-        m_state.store(flags, MemoryOrder::Release);
-    }
+    void unlock() const { m_state.fetch_and(~locked_flag, MemoryOrder::Release); }
 
-    mutable container::IntrusiveList<detail::InPlaceStopCallbackBase> m_callbacks;
-    mutable Atomic<u8> m_state { 0 };
+    mutable Atomic<uptr> m_state { 0 };
     ThreadId m_stopper_thread;
 };
 }
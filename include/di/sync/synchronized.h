@@ -6,7 +6,9 @@
 #include "di/meta/util.h"
 #include "di/platform/prelude.h"
 #include "di/sync/concepts/lock.h"
+#include "di/sync/concepts/shared_lock.h"
 #include "di/sync/scoped_lock.h"
+#include "di/sync/scoped_shared_lock.h"
 #include "di/util/guarded_reference.h"
 
 namespace di::sync {
@@ -37,6 +39,16 @@ public:
         return function::invoke(util::forward<Fun>(function), m_value);
     }
 
+    /// @brief Invoke a function with shared, read-only access to the value.
+    ///
+    /// Any number of readers may run concurrently, but they exclude callers of with_lock().
+    template<concepts::Invocable<Value const&> Fun>
+    requires(concepts::SharedLock<Lock>)
+    constexpr auto with_read_lock(Fun&& function) const -> meta::InvokeResult<Fun, Value const&> {
+        auto guard = ScopedSharedLock(m_lock);
+        return function::invoke(util::forward<Fun>(function), m_value);
+    }
+
     constexpr auto lock() { return LockedReference<Value, Lock>(m_value, m_lock); }
 
     constexpr auto get_assuming_no_concurrent_accesses() -> Value& { return m_value; }
@@ -45,8 +57,13 @@ public:
     constexpr auto read() const -> Value
     requires(concepts::CopyConstructible<Value>)
     {
-        auto guard = ScopedLock(m_lock);
-        return m_value;
+        if constexpr (concepts::SharedLock<Lock>) {
+            auto guard = ScopedSharedLock(m_lock);
+            return m_value;
+        } else {
+            auto guard = ScopedLock(m_lock);
+            return m_value;
+        }
     }
 
     constexpr auto get_lock() -> Lock& { return m_lock; }
@@ -0,0 +1,14 @@
+#pragma once
+
+namespace di::types {
+struct AllocatorArg {
+    explicit AllocatorArg() = default;
+};
+
+constexpr inline auto allocator_arg = AllocatorArg {};
+}
+
+namespace di {
+using types::allocator_arg;
+using types::AllocatorArg;
+}
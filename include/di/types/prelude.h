@@ -1,5 +1,6 @@
 #pragma once
 
+#include "di/types/allocator_arg.h"
 #include "di/types/byte.h"
 #include "di/types/char.h"
 #include "di/types/in_place.h"
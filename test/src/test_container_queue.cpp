@@ -1,5 +1,9 @@
+#include <thread>
+
 #include "di/container/queue/prelude.h"
+#include "di/container/vector/prelude.h"
 #include "di/container/view/prelude.h"
+#include "di/sync/prelude.h"
 #include "di/test/prelude.h"
 
 namespace container_queue {
@@ -68,8 +72,87 @@ constexpr static void queue() {
     ASSERT(b.empty());
 }
 
+static void mpmc_queue() {
+    auto queue = di::MpmcQueue<di::Vector<int>> {};
+    queue.reserve_from_nothing(3);
+    ASSERT_EQ(queue.capacity(), 4U);
+    ASSERT(!queue.try_pop());
+
+    for (auto i : di::range(4)) {
+        auto value = di::Vector<int> {};
+        value.push_back(i);
+        ASSERT(queue.try_push(di::move(value)));
+    }
+    ASSERT(!queue.try_push(di::Vector<int> {}));
+
+    auto front = queue.try_pop();
+    ASSERT(front);
+    ASSERT_EQ((*front)[0], 0);
+
+    di::Vector<int> output[4];
+    ASSERT_EQ(queue.try_pop_bulk(output), 3U);
+    ASSERT_EQ(output[0][0], 1);
+    ASSERT_EQ(output[2][0], 3);
+    ASSERT(!queue.try_pop());
+
+    // Pushing in bulk stops once the queue is full, and anything left over is destroyed with the queue.
+    ASSERT_EQ(queue.try_push_bulk(output), 4U);
+    ASSERT(queue.try_pop());
+}
+
+static void mpmc_queue_concurrent() {
+    constexpr auto per_producer = 10000;
+
+    auto queue = di::MpmcQueue<int> {};
+    queue.reserve_from_nothing(64);
+
+    auto sum = di::Atomic<i64>(0);
+    auto popped = di::Atomic<int>(0);
+
+    auto produce = [&] {
+        int values[8];
+        for (auto i = 1; i <= per_producer;) {
+            auto count = di::min(8, per_producer - i + 1);
+            for (auto j = 0; j < count; j++) {
+                values[j] = i + j;
+            }
+            auto pushed = queue.try_push_bulk({ values, usize(count) });
+            if (pushed == 0) {
+                std::this_thread::yield();
+            }
+            i += int(pushed);
+        }
+    };
+    auto consume = [&] {
+        int values[8];
+        while (popped.load() < 2 * per_producer) {
+            auto count = queue.try_pop_bulk(values);
+            if (count == 0) {
+                std::this_thread::yield();
+            }
+            for (auto j = usize(0); j < count; j++) {
+                sum.fetch_add(values[j]);
+            }
+            popped.fetch_add(int(count));
+        }
+    };
+
+    auto a = std::thread(produce);
+    auto b = std::thread(produce);
+    auto c = std::thread(consume);
+    auto d = std::thread(consume);
+    a.join();
+    b.join();
+    c.join();
+    d.join();
+
+    ASSERT_EQ(sum.load(), i64(per_producer) * (per_producer + 1));
+}
+
 TESTC(container_queue, priority_queue_basic)
 TESTC(container_queue, priority_queue_to)
 TESTC(container_queue, stack)
 TESTC(container_queue, queue)
+TEST(container_queue, mpmc_queue)
+TEST(container_queue, mpmc_queue_concurrent)
 }
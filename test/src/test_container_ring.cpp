@@ -1,3 +1,5 @@
+#include <thread>
+
 #include "di/container/ring/prelude.h"
 #include "di/test/prelude.h"
 
@@ -226,6 +228,65 @@ constexpr static void static_() {
     ASSERT_EQ(w.size(), 2U);
 }
 
+static void spsc() {
+    auto ring = di::SpscRing<M> {};
+    ring.reserve_from_nothing(5);
+    ASSERT_EQ(ring.capacity(), 8U);
+    ASSERT(!ring.try_pop());
+
+    M values[10] = { M { 0 }, M { 1 }, M { 2 }, M { 3 }, M { 4 }, M { 5 }, M { 6 }, M { 7 }, M { 8 }, M { 9 } };
+    ASSERT_EQ(ring.try_push_bulk(values), 8U);
+    ASSERT(!ring.try_push(M { 10 }));
+
+    auto front = ring.try_pop();
+    ASSERT(front);
+    ASSERT_EQ(front->x, 0);
+    ASSERT(ring.try_push(M { 10 }));
+
+    for (auto i : di::range(1, 8)) {
+        auto value = ring.try_pop();
+        ASSERT(value);
+        ASSERT_EQ(value->x, i);
+    }
+    ASSERT_EQ(ring.try_pop()->x, 10);
+    ASSERT(!ring.try_pop());
+}
+
+static void spsc_concurrent() {
+    constexpr auto count = 100000zu;
+
+    auto ring = di::SpscRing<usize> {};
+    ring.reserve_from_nothing(32);
+
+    auto producer = std::thread([&] {
+        usize values[9];
+        for (auto i = 0zu; i < count;) {
+            auto n = di::min(9zu, count - i);
+            for (auto j = 0zu; j < n; j++) {
+                values[j] = i + j;
+            }
+            auto pushed = ring.try_push_bulk({ values, n });
+            if (pushed == 0) {
+                std::this_thread::yield();
+            }
+            i += pushed;
+        }
+    });
+
+    // Elements must arrive in order, with nothing lost or duplicated.
+    usize values[13];
+    for (auto expected = 0zu; expected < count;) {
+        auto n = ring.try_pop_bulk(values);
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+        for (auto j = 0zu; j < n; j++) {
+            ASSERT_EQ(values[j], expected++);
+        }
+    }
+    producer.join();
+}
+
 TESTC(container_ring, basic)
 TESTC(container_ring, insert_container)
 TESTC(container_ring, reserve)
@@ -234,4 +295,6 @@ TESTC(container_ring, to)
 TESTC(container_ring, clone)
 TESTC(container_ring, compare)
 TESTC(container_ring, static_)
+TEST(container_ring, spsc)
+TEST(container_ring, spsc_concurrent)
 }
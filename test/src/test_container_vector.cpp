@@ -1,3 +1,5 @@
+#include "di/container/algorithm/equal.h"
+#include "di/container/allocator/arena_allocator.h"
 #include "di/container/allocator/infallible_allocator.h"
 #include "di/container/interface/erase.h"
 #include "di/container/vector/prelude.h"
@@ -277,6 +279,40 @@ constexpr static void allocate() {
     ASSERT_EQ(v.allocator().count(), 16);
 }
 
+static void arena() {
+    auto arena = di::Arena {};
+
+    auto small = arena.allocate(1, 1);
+    auto aligned = arena.allocate(8, 64);
+    ASSERT_EQ(reinterpret_cast<uptr>(aligned.data) % 64, 0U);
+    ASSERT_NOT_EQ(small.data, aligned.data);
+
+    // Allocations larger than a chunk get a chunk of their own.
+    auto large = arena.allocate(di::Arena::default_chunk_size * 4, 16);
+    ASSERT_EQ(large.count, di::Arena::default_chunk_size * 4);
+
+    {
+        auto v = di::Vector<i32, di::ArenaAllocator>(di::ArenaAllocator(arena));
+        for (auto i : di::range(10'000)) {
+            v.push_back(i);
+        }
+        ASSERT_EQ(v.size(), 10'000U);
+        ASSERT_EQ(v.allocator().arena(), &arena);
+
+        // Moving a vector carries its allocator along with its storage.
+        auto w = di::move(v);
+        ASSERT_EQ(w.allocator().arena(), &arena);
+        ASSERT(di::container::equal(w, di::range(10'000)));
+    }
+
+    // Without an arena, memory comes from the heap.
+    auto heap = di::Vector<i32, di::ArenaAllocator> {};
+    heap.push_back(1);
+    ASSERT_EQ(heap.allocator().arena(), nullptr);
+
+    arena.release();
+}
+
 TESTC(container_vector, basic)
 TESTC(container_vector, emplace_many)
 TESTC(container_vector, vector2d)
@@ -288,4 +324,5 @@ TESTC(container_vector, compare)
 TESTC(container_vector, static_)
 TESTC(container_vector, erase)
 TEST(container_vector, allocate)
+TEST(container_vector, arena)
 }
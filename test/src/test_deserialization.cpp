@@ -1,11 +1,23 @@
+#include "di/container/allocator/arena_allocator.h"
+#include "di/container/tree/tree_map.h"
+#include "di/execution/algorithm/sync_wait.h"
+#include "di/execution/coroutine/lazy.h"
+#include "di/execution/io/async_json_events.h"
+#include "di/execution/io/spsc_ring_channel.h"
+#include "di/format/prelude.h"
+#include "di/io/span_reader.h"
 #include "di/io/vector_reader.h"
 #include "di/io/vector_writer.h"
 #include "di/reflect/prelude.h"
 #include "di/serialization/binary_deserializer.h"
 #include "di/serialization/binary_serializer.h"
+#include "di/serialization/compact_binary_deserializer.h"
+#include "di/serialization/compact_binary_serializer.h"
 #include "di/serialization/json_deserializer.h"
 #include "di/serialization/json_deserializer_error.h"
+#include "di/serialization/json_event_reader.h"
 #include "di/serialization/json_value.h"
+#include "di/serialization/table_format.h"
 #include "di/test/prelude.h"
 #include "di/util/uuid.h"
 
@@ -61,6 +73,100 @@ constexpr static void json_value() {
 })"_sv);
 }
 
+static void json_object() {
+    // Members keep their insertion order, both when built by hand and when parsed.
+    auto x = di::json::Value {};
+    x["zebra"_sv] = 1;
+    x["apple"_sv] = 2;
+    x["mango"_sv] = 3;
+    ASSERT_EQ(*di::to_json_string(x), R"({"zebra":1,"apple":2,"mango":3})"_sv);
+
+    auto y = *di::from_json_string(R"({"b": 1, "a": 2, "b": 3})"_sv);
+    ASSERT_EQ(y.size(), 2);
+    ASSERT_EQ(y.at("b"_sv), 3);
+    ASSERT_EQ(*di::to_json_string(y), R"({"b":3,"a":2})"_sv);
+
+    // Grow the object well past the point where it is hash indexed.
+    auto object = di::json::Object {};
+    for (auto i : di::range(200)) {
+        auto key = di::format(u8"key{}"_sv, i);
+        ASSERT(di::get<1>(object.try_emplace(di::move(key), i64(i))));
+    }
+    ASSERT_EQ(object.size(), 200);
+    ASSERT(!di::get<1>(object.try_emplace("key42"_sv, 0)));
+    for (auto i : di::range(200)) {
+        ASSERT_EQ(object.at(di::format(u8"key{}"_sv, i)), i64(i));
+    }
+    ASSERT(!object.contains("key200"_sv));
+    ASSERT_EQ(di::get<0>(*object.front()), "key0"_sv);
+    ASSERT_EQ(di::get<0>(*object.back()), "key199"_sv);
+
+    // Erasing shifts later members down, which must not break lookups.
+    for (auto i : di::range(100)) {
+        ASSERT_EQ(object.erase(di::format(u8"key{}"_sv, 2 * i)), 1U);
+    }
+    ASSERT_EQ(object.size(), 100);
+    for (auto i : di::range(200)) {
+        ASSERT_EQ(object.contains(di::format(u8"key{}"_sv, i)), i % 2 == 1);
+    }
+    ASSERT_EQ(di::get<0>(*object.front()), "key1"_sv);
+
+    // Shrinking back below the threshold falls back to a linear search.
+    while (object.size() > 3) {
+        object.erase(object.begin());
+    }
+    ASSERT_EQ(object.at("key195"_sv), 195);
+    ASSERT_EQ(object.at("key199"_sv), 199);
+    ASSERT(!object.contains("key1"_sv));
+
+    object.clear();
+    ASSERT(object.empty());
+    object["key1"_sv] = 1;
+    ASSERT_EQ(object.at("key1"_sv), 1);
+
+    // Comparison ignores the member order.
+    auto a = *di::from_json_string(R"({"x": 1, "y": 2, "z": 3})"_sv);
+    auto b = *di::from_json_string(R"({"z": 3, "x": 1, "y": 2})"_sv);
+    auto c = *di::from_json_string(R"({"y": 2, "x": 1, "z": 4})"_sv);
+    auto d = *di::from_json_string(R"({"y": 2, "x": 1})"_sv);
+    ASSERT_EQ(a, b);
+    ASSERT_NOT_EQ(a, c);
+    ASSERT_NOT_EQ(a, d);
+    ASSERT((a <=> b) == 0);
+    ASSERT((a <=> c) < 0);
+    ASSERT((c <=> b) > 0);
+    ASSERT((d <=> a) < 0);
+}
+
+static void json_arena() {
+    using Value = di::json::BasicValue<di::ArenaAllocator>;
+
+    auto arena = di::Arena {};
+    auto value =
+        *di::from_json_string<Value>(R"({"name": "arena", "list": [1, "two", {"three": 3}], "empty": {}})"_sv,
+                                     di::ArenaAllocator(arena));
+    ASSERT_EQ(*value.at("name"_sv), "arena"_sv);
+    ASSERT_EQ(value["list"_sv].size(), 3U);
+    ASSERT_EQ(value["list"_sv][0], 1);
+    ASSERT_EQ(value["list"_sv][1], "two"_sv);
+    ASSERT_EQ(value["list"_sv][2]["three"_sv], 3);
+
+    // The allocator is propagated to every container in the document.
+    ASSERT_EQ(value.as_object()->allocator().arena(), &arena);
+    ASSERT_EQ(value["list"_sv].as_array()->allocator().arena(), &arena);
+    ASSERT_EQ(value["list"_sv][2].as_object()->allocator().arena(), &arena);
+    ASSERT_EQ(value["empty"_sv].as_object()->allocator().arena(), &arena);
+
+    // Values added afterwards fall back to the heap, and can be mixed freely with the rest of the document.
+    value["extra"_sv] = 4;
+    ASSERT_EQ(*di::to_json_string(value),
+              R"({"name":"arena","list":[1,"two",{"three":3}],"empty":{},"extra":4})"_sv);
+
+    // Without an allocator, the default constructed one is used.
+    auto heap = *di::from_json_string<Value>(R"([1, 2])"_sv);
+    ASSERT_EQ(heap.as_array()->allocator().arena(), nullptr);
+}
+
 constexpr static void json_escaped_string() {
     struct Case {
         di::StringView input;
@@ -290,10 +396,550 @@ constexpr static void binary() {
     do_test(mytype);
 }
 
+struct BorrowedType {
+    di::StringView name;
+    di::Span<byte const> payload;
+
+    constexpr friend auto tag_invoke(di::Tag<di::reflect>, di::InPlaceType<BorrowedType>) {
+        return di::make_fields<"BorrowedType">(di::field<"name", &BorrowedType::name>,
+                                               di::field<"payload", &BorrowedType::payload>);
+    }
+};
+
+static void binary_borrowed() {
+    auto payload = di::Array { byte(1), byte(2), byte(3) };
+
+    auto writer = di::VectorWriter<>();
+    ASSERT(di::serialize_binary(writer, BorrowedType { "hello"_sv, payload.span() }));
+    auto buffer = di::move(writer).vector();
+
+    auto reader = di::SpanReader(buffer.span());
+    auto result = di::deserialize_binary<BorrowedType>(reader);
+    ASSERT(result);
+    ASSERT_EQ(result->name, "hello"_sv);
+    ASSERT_EQ(result->payload.size(), 3U);
+    ASSERT_EQ(result->payload[2], byte(3));
+
+    // The views refer directly to the serialized data.
+    ASSERT(static_cast<void const*>(result->payload.data()) ==
+           static_cast<void const*>(buffer.data() + buffer.size() - 3));
+    ASSERT(reader.remaining().empty());
+
+    // Truncated data fails to deserialize instead of reading out of bounds.
+    auto truncated_reader = di::SpanReader(*buffer.span().first(buffer.size() - 1));
+    ASSERT(!di::deserialize_binary<BorrowedType>(truncated_reader));
+
+    // Only spans of types which accept any byte value are borrowed.
+    namespace detail = di::serialization::detail;
+    enum class SmallEnum : u8 { Value };
+    static_assert(detail::BorrowedView<di::Span<u8 const>>);
+    static_assert(detail::BorrowedView<di::Span<c8 const>>);
+    static_assert(!detail::BorrowedView<di::Span<bool const>>);
+    static_assert(!detail::BorrowedView<di::Span<SmallEnum const>>);
+}
+
+struct Pixel {
+    u8 r;
+    u8 g;
+    u8 b;
+    u8 a;
+
+    auto operator==(Pixel const&) const -> bool = default;
+
+    constexpr friend auto tag_invoke(di::Tag<di::reflect>, di::InPlaceType<Pixel>) {
+        return di::make_fields<"Pixel">(di::field<"r", &Pixel::r>, di::field<"g", &Pixel::g>,
+                                        di::field<"b", &Pixel::b>, di::field<"a", &Pixel::a>);
+    }
+};
+
+struct Swapped {
+    u16 first;
+    u16 second;
+
+    auto operator==(Swapped const&) const -> bool = default;
+
+    constexpr friend auto tag_invoke(di::Tag<di::reflect>, di::InPlaceType<Swapped>) {
+        return di::make_fields<"Swapped">(di::field<"second", &Swapped::second>,
+                                          di::field<"first", &Swapped::first>);
+    }
+};
+
+static void binary_bulk() {
+    namespace detail = di::serialization::detail;
+
+    static_assert(detail::binary_bulk_copyable(di::in_place_type<u32>));
+    static_assert(detail::binary_bulk_copyable(di::in_place_type<MyEnum>));
+    static_assert(detail::binary_bulk_copyable(di::in_place_type<Pixel>));
+    static_assert(!detail::binary_bulk_copyable(di::in_place_type<bool>));
+    static_assert(!detail::binary_bulk_copyable(di::in_place_type<MyType>));
+
+    ASSERT(detail::binary_layout_matches(di::in_place_type<Pixel>));
+    ASSERT(!detail::binary_layout_matches(di::in_place_type<Swapped>));
+
+    auto round_trip = []<typename T>(T const& value) {
+        auto writer = di::VectorWriter<>();
+        ASSERT(di::serialize_binary(writer, value));
+        auto buffer = di::move(writer).vector();
+
+        auto reader = di::SpanReader(buffer.span());
+        auto result = di::deserialize_binary<T>(reader);
+        ASSERT(result);
+        ASSERT_EQ(*result, value);
+        ASSERT(reader.remaining().empty());
+
+        // Truncated data fails to deserialize, instead of reading past the end of the buffer.
+        if (!value.empty()) {
+            auto truncated_reader = di::SpanReader(*buffer.span().first(buffer.size() - 1));
+            ASSERT(!di::deserialize_binary<T>(truncated_reader));
+        }
+        return buffer;
+    };
+
+    auto numbers = di::range(100000u) | di::to<di::Vector>();
+    auto numbers_buffer = round_trip(numbers);
+    ASSERT_EQ(numbers_buffer.size(), 8 + numbers.size() * sizeof(u32));
+    ASSERT_EQ(numbers_buffer[8 + 4 * 258 + 1], byte(1));
+
+    round_trip(di::Vector<u32> {});
+
+    auto pixels = di::Vector<Pixel> {};
+    pixels.push_back({ 1, 2, 3, 4 });
+    pixels.push_back({ 5, 6, 7, 8 });
+    auto pixels_buffer = round_trip(pixels);
+    ASSERT_EQ(pixels_buffer[8], byte(1));
+    ASSERT_EQ(pixels_buffer[15], byte(8));
+
+    // Structures whose reflected field order differs from their layout are written field by field.
+    auto swapped = di::Vector<Swapped> {};
+    swapped.push_back({ 1, 2 });
+    auto swapped_buffer = round_trip(swapped);
+    ASSERT_EQ(swapped_buffer[8], byte(2));
+    ASSERT_EQ(swapped_buffer[10], byte(1));
+}
+
+static void compact_binary() {
+    auto encode = [](auto const& value) {
+        auto writer = di::VectorWriter<>();
+        ASSERT(di::serialize_compact_binary(writer, value));
+        return di::move(writer).vector();
+    };
+
+    ASSERT_EQ(encode(u32(1)).size(), 1U);
+    ASSERT_EQ(encode(i32(-1)).size(), 1U);
+    ASSERT_EQ(encode(i64(-64)).size(), 1U);
+    ASSERT_EQ(encode(i64(64)).size(), 2U);
+    ASSERT(di::container::equal(encode(u64(300)), di::Array { byte(0xAC), byte(0x02) }));
+    ASSERT_EQ(encode(di::NumericLimits<u64>::max).size(), 10U);
+    ASSERT_EQ(encode("hello"_sv).size(), 6U);
+    ASSERT_EQ(encode(MyType { 1, 2, 3, true, "hello"_s }).size(), 10U);
+
+    auto do_test = []<di::concepts::EqualityComparable T>(T const& value) {
+        auto writer = di::VectorWriter<>();
+        ASSERT(di::serialize_compact_binary(writer, value));
+        auto reader = di::VectorReader(di::move(writer).vector());
+        auto result = di::deserialize_compact_binary<T>(reader);
+        ASSERT(result);
+        ASSERT_EQ(*result, value);
+    };
+
+    do_test(42);
+    do_test(-42);
+    do_test(false);
+    do_test(MyEnum::Baz);
+    do_test(di::NumericLimits<i64>::min);
+    do_test(di::NumericLimits<i64>::max);
+    do_test(di::NumericLimits<u64>::max);
+    do_test("hello"_s);
+    do_test(di::make_tuple(1, -2, 3));
+    do_test(di::Variant<int, di::String> { "hello"_s });
+    do_test(MyType { 1, -2, 300000, true, "hello"_s });
+
+    // Arrays of integers are decoded in bulk when reading from a span.
+    auto numbers = di::range(-1000, 1000) | di::transform([](int x) {
+                       return x * (x % 7);
+                   }) |
+                   di::to<di::Vector>();
+    do_test(numbers);
+
+    auto buffer = encode(numbers);
+    auto reader = di::SpanReader(buffer.span());
+    auto result = di::deserialize_compact_binary<di::Vector<int>>(reader);
+    ASSERT(result);
+    ASSERT_EQ(*result, numbers);
+    ASSERT(reader.remaining().empty());
+
+    // Sizes which exceed the available data are rejected before allocating.
+    auto bogus = encode(u64(1) << 40);
+    auto bogus_reader = di::SpanReader(bogus.span());
+    ASSERT(!di::deserialize_compact_binary<di::Vector<int>>(bogus_reader));
+
+    // Varints which don't fit in the destination type are rejected.
+    auto overlong = di::Array<byte, 11> {};
+    overlong.fill(byte(0xFF));
+    overlong[10] = byte(0x01);
+    auto overlong_reader = di::SpanReader(overlong.span());
+    ASSERT(!di::deserialize_compact_binary<u64>(overlong_reader));
+
+    auto too_large = encode(u32(70000));
+    auto too_large_reader = di::SpanReader(too_large.span());
+    ASSERT(!di::deserialize_compact_binary<u16>(too_large_reader));
+
+    // Truncated input is reported as an error, whichever field it ends in.
+    auto complete = encode(MyType { 1, -2, 300000, true, "hello"_s });
+    for (auto size = 0ZU; size < complete.size(); size++) {
+        auto truncated_reader = di::SpanReader(*complete.span().first(size));
+        ASSERT_EQ(di::deserialize_compact_binary<MyType>(truncated_reader),
+                  di::Unexpected(di::BasicError::ResultOutOfRange));
+    }
+}
+
+static void varint_bulk_decode() {
+    auto input = di::Vector<byte> {};
+    auto expected = di::Vector<i32> {};
+    for (auto i : di::range(100)) {
+        // Mix long runs of single byte values with occasional multi-byte ones.
+        auto value = i % 13 == 0 ? -100000 * i : i % 60 - 30;
+        auto buffer = di::Array<byte, di::serialization::max_varint_size<i32>> {};
+        auto size = di::serialization::encode_varint(value, buffer.span());
+        input.append_container(*buffer.span().first(size));
+        expected.push_back(value);
+    }
+
+    auto output = di::Vector<i32> {};
+    output.resize(expected.size());
+    auto consumed = di::serialization::decode_varints(input.span(), output.span());
+    ASSERT_EQ(consumed, input.size());
+    ASSERT_EQ(output, expected);
+
+    // Truncated input fails.
+    ASSERT(!di::serialization::decode_varints(*input.span().first(input.size() - 1), output.span()));
+}
+
+struct RecordV1 {
+    u32 id;
+    di::String name;
+
+    constexpr friend auto tag_invoke(di::Tag<di::reflect>, di::InPlaceType<RecordV1>) {
+        return di::make_fields<"Record">(di::field<"id", &RecordV1::id>, di::field<"name", &RecordV1::name>);
+    }
+};
+
+struct RecordV2 {
+    u32 id;
+    di::String name;
+    di::Optional<i64> score;
+    di::Vector<u16> tags;
+    di::Vector<Pixel> pixels;
+    u32 version { 2 };
+
+    auto operator==(RecordV2 const&) const -> bool = default;
+
+    constexpr friend auto tag_invoke(di::Tag<di::reflect>, di::InPlaceType<RecordV2>) {
+        return di::make_fields<"Record">(di::field<"id", &RecordV2::id>, di::field<"name", &RecordV2::name>,
+                                         di::field<"score", &RecordV2::score>, di::field<"tags", &RecordV2::tags>,
+                                         di::field<"pixels", &RecordV2::pixels>,
+                                         di::field<"version", &RecordV2::version>);
+    }
+};
+
+struct Settings {
+    bool enabled;
+    MyEnum kind;
+    di::Vector<Pixel> palette;
+
+    constexpr friend auto tag_invoke(di::Tag<di::reflect>, di::InPlaceType<Settings>) {
+        return di::make_fields<"Settings">(di::field<"enabled", &Settings::enabled>,
+                                           di::field<"kind", &Settings::kind>,
+                                           di::field<"palette", &Settings::palette>);
+    }
+};
+
+static void table_format() {
+    auto encode = [](auto const& value) {
+        auto writer = di::VectorWriter<>();
+        ASSERT(di::serialize_table(writer, value));
+        auto buffer = di::move(writer).vector();
+        ASSERT_EQ(buffer.size(), di::serialize_size(di::table_format, value));
+        return buffer;
+    };
+
+    auto record = RecordV2 { 7, "hello"_s, 42, {}, {}, 3 };
+    record.tags.push_back(1);
+    record.tags.push_back(500);
+    record.pixels.push_back({ 1, 2, 3, 4 });
+    record.pixels.push_back({ 5, 6, 7, 8 });
+
+    auto buffer = encode(record);
+    auto reader = di::SpanReader(buffer.span());
+    auto result = di::deserialize_table<RecordV2>(reader);
+    ASSERT(result);
+    ASSERT_EQ(*result, record);
+    ASSERT(reader.remaining().empty());
+
+    // Fields can be read in place, without deserializing the whole record.
+    auto view = di::table_view<RecordV2>(buffer.span());
+    ASSERT(view);
+    ASSERT_EQ(view->get<&RecordV2::id>(), 7U);
+    ASSERT_EQ(view->get<&RecordV2::name>(), "hello"_sv);
+    ASSERT_EQ(view->get<&RecordV2::score>(), di::Optional<i64>(42));
+    auto tags = view->get<&RecordV2::tags>();
+    ASSERT(tags);
+    ASSERT_EQ(tags->size(), 2U);
+    ASSERT_EQ((*tags)[1], u16(500));
+    auto pixels = view->get<&RecordV2::pixels>();
+    ASSERT(pixels);
+    auto pixel = (*pixels)[1];
+    ASSERT(pixel);
+    ASSERT_EQ(pixel->get<&Pixel::b>(), u8(7));
+
+    // Empty optionals are absent.
+    auto empty_score = record;
+    empty_score.score = di::nullopt;
+    auto empty_buffer = encode(empty_score);
+    auto empty_view = di::table_view<RecordV2>(empty_buffer.span());
+    ASSERT(empty_view);
+    ASSERT(!empty_view->has<2>());
+    auto empty = empty_view->get<&RecordV2::score>();
+    ASSERT(empty);
+    ASSERT(!*empty);
+
+    // Data written by an older version reads with the new fields defaulted.
+    auto old_buffer = encode(RecordV1 { 9, "old"_s });
+    auto old_reader = di::SpanReader(old_buffer.span());
+    auto upgraded = di::deserialize_table<RecordV2>(old_reader);
+    ASSERT(upgraded);
+    ASSERT_EQ(*upgraded, (RecordV2 { 9, "old"_s, {}, {}, {}, 2 }));
+
+    // Data written by a newer version reads with the unknown fields skipped.
+    auto new_reader = di::SpanReader(buffer.span());
+    auto downgraded = di::deserialize_table<RecordV1>(new_reader);
+    ASSERT(downgraded);
+    ASSERT_EQ(downgraded->id, 7U);
+    ASSERT_EQ(downgraded->name, "hello"_sv);
+    ASSERT(new_reader.remaining().empty());
+
+    // Corrupted offsets fail instead of reading out of bounds.
+    buffer[8 + 4 * 3] = byte(0xFF);
+    auto corrupted_reader = di::SpanReader(buffer.span());
+    ASSERT(!di::deserialize_table<RecordV2>(corrupted_reader));
+
+    // The header and 3 field offsets take 20 bytes, followed by the bool, the enum, and the vector. The vector starts
+    // with its size, followed by the offset of its only element.
+    auto settings = Settings { true, MyEnum::Baz, {} };
+    settings.palette.push_back({ 1, 2, 3, 4 });
+    auto settings_buffer = encode(settings);
+    auto settings_view = di::table_view<Settings>(settings_buffer.span());
+    ASSERT(settings_view);
+    ASSERT_EQ(settings_view->get<&Settings::enabled>(), true);
+    ASSERT_EQ(settings_view->get<&Settings::kind>(), MyEnum::Baz);
+
+    // Scalars which do not hold a valid value fail to read.
+    settings_buffer[20] = byte(2);
+    ASSERT(!settings_view->get<&Settings::enabled>());
+    settings_buffer[21] = byte(7);
+    ASSERT(!settings_view->get<&Settings::kind>());
+
+    // Offsets which point back into the offset table fail, rather than reading the same data again.
+    settings_buffer[29] = byte(0);
+    auto palette = settings_view->get<&Settings::palette>();
+    ASSERT(palette);
+    ASSERT(!(*palette)[0]);
+}
+
+namespace json_events_test {
+namespace json = di::serialization::json;
+
+template<typename T, typename... Args>
+static auto event(Args&&... args) {
+    return json::Event(di::in_place_type<T>, di::forward<Args>(args)...);
+}
+}
+
+static void json_events() {
+    using namespace json_events_test;
+
+    auto input = R"( {"name": "hello", "escaped": "a\né😀", "values": [1, -2, true, false, null],
+                     "skipped": {"a": [1, {"b": "}"}], "c": "\"]"}, "nested": {"x": [{}, []], "y": 0}, "last": 3}
+                     [] )"_sv;
+
+    auto reader = di::JsonEventReader(di::SpanReader(di::as_bytes(input.span())));
+    auto next = [&] {
+        auto result = reader.next();
+        ASSERT(result);
+        ASSERT(*result);
+        return **result;
+    };
+
+    ASSERT_EQ(next(), event<json::BeginObject>());
+    ASSERT_EQ(next(), event<json::Key>("name"_sv));
+
+    // Strings without escapes refer directly to the input.
+    auto name = next();
+    ASSERT_EQ(name, event<di::StringView>("hello"_sv));
+    ASSERT(di::get<di::StringView>(name).data() == input.data() + 11);
+
+    ASSERT_EQ(next(), event<json::Key>("escaped"_sv));
+    ASSERT_EQ(next(), event<di::StringView>("a\né😀"_sv));
+    ASSERT_EQ(next(), event<json::Key>("values"_sv));
+    ASSERT_EQ(next(), event<json::BeginArray>());
+    ASSERT_EQ(next(), event<json::Number>(1));
+    ASSERT_EQ(next(), event<json::Number>(-2));
+    ASSERT_EQ(next(), event<json::Bool>(true));
+    ASSERT_EQ(next(), event<json::Bool>(false));
+    ASSERT_EQ(next(), event<json::Null>());
+    ASSERT_EQ(next(), event<json::EndArray>());
+
+    // Skipping after a key skips its value, even when it contains delimiters inside of strings.
+    ASSERT_EQ(next(), event<json::Key>("skipped"_sv));
+    ASSERT(reader.skip());
+
+    ASSERT_EQ(next(), event<json::Key>("nested"_sv));
+    ASSERT_EQ(next(), event<json::BeginObject>());
+    ASSERT_EQ(next(), event<json::Key>("x"_sv));
+    ASSERT_EQ(next(), event<json::BeginArray>());
+    ASSERT_EQ(next(), event<json::BeginObject>());
+    ASSERT_EQ(next(), event<json::EndObject>());
+
+    // Skipping inside of an array skips the rest of it.
+    ASSERT(reader.skip());
+    ASSERT_EQ(next(), event<json::Key>("y"_sv));
+    ASSERT_EQ(next(), event<json::Number>(0));
+    ASSERT_EQ(next(), event<json::EndObject>());
+    ASSERT_EQ(next(), event<json::Key>("last"_sv));
+    ASSERT_EQ(next(), event<json::Number>(3));
+    ASSERT_EQ(next(), event<json::EndObject>());
+
+    // Multiple top-level values are read one after another.
+    ASSERT_EQ(next(), event<json::BeginArray>());
+    ASSERT_EQ(next(), event<json::EndArray>());
+    auto end = reader.next();
+    ASSERT(end);
+    ASSERT(!*end);
+
+    // Invalid input fails.
+    auto invalid = [](di::StringView input) {
+        auto reader = di::JsonEventReader(di::SpanReader(di::as_bytes(input.span())));
+        for (;;) {
+            auto result = reader.next();
+            if (!result) {
+                return true;
+            }
+            if (!*result) {
+                return false;
+            }
+        }
+    };
+    ASSERT(invalid(R"({"a" 1})"_sv));
+    ASSERT(invalid(R"([1,])"_sv));
+    ASSERT(invalid(R"([1})"_sv));
+    ASSERT(invalid(R"(["a)"_sv));
+    ASSERT(invalid(R"([01])"_sv));
+    ASSERT(invalid(R"(["\ud83d"])"_sv));
+    ASSERT(invalid(R"({"a": tru})"_sv));
+    ASSERT(!invalid(R"({"a": [true, {}]})"_sv));
+}
+
+static void json_events_chunked() {
+    using namespace json_events_test;
+
+    // Readers which can't be parsed in place are buffered, so long strings are split into chunks.
+    auto long_string = di::String {};
+    for (auto i : di::range(100000)) {
+        long_string.push_back(c32(U'a' + i % 26));
+        if (i % 1000 == 999) {
+            long_string.push_back(U'é');
+        }
+    }
+    auto input = di::Vector<byte> {};
+    for (auto part : { R"([{"skip": ")"_sv, long_string.view(), R"("}, ")"_sv, long_string.view(), R"(", 42])"_sv }) {
+        input.append_container(di::as_bytes(part.span()));
+    }
+
+    auto reader = di::JsonEventReader(di::VectorReader(di::move(input)));
+    auto next = [&] {
+        auto result = reader.next();
+        ASSERT(result);
+        ASSERT(*result);
+        return **result;
+    };
+
+    ASSERT_EQ(next(), event<json::BeginArray>());
+    ASSERT_EQ(next(), event<json::BeginObject>());
+    ASSERT_EQ(next(), event<json::Key>("skip"_sv));
+    ASSERT(reader.skip());
+    ASSERT_EQ(next(), event<json::EndObject>());
+
+    auto chunks = 0;
+    auto string = di::String {};
+    for (;;) {
+        auto piece = next();
+        if (auto chunk = di::get_if<json::StringChunk>(piece)) {
+            string.append(chunk->data);
+            chunks++;
+            continue;
+        }
+        string.append(di::get<di::StringView>(piece));
+        break;
+    }
+    ASSERT_GT(chunks, 0);
+    ASSERT_EQ(string, long_string);
+
+    ASSERT_EQ(next(), event<json::Number>(42));
+    ASSERT_EQ(next(), event<json::EndArray>());
+    auto end = reader.next();
+    ASSERT(end);
+    ASSERT(!*end);
+
+    // Keys are never split, so a key which is too long is an error instead of being buffered without bound.
+    auto long_key_input = di::Vector<byte> {};
+    for (auto part : { R"({")"_sv, long_string.view(), R"(": 1})"_sv }) {
+        long_key_input.append_container(di::as_bytes(part.span()));
+    }
+    auto long_key_reader = di::JsonEventReader(di::VectorReader(di::move(long_key_input)));
+    auto begin = long_key_reader.next();
+    ASSERT(begin);
+    ASSERT(*begin);
+    ASSERT_EQ(**begin, event<json::BeginObject>());
+    ASSERT(!long_key_reader.next());
+}
+
+static void json_events_async() {
+    using namespace json_events_test;
+
+    alignas(di::SpscByteRingHeader) auto memory = di::Array<byte, sizeof(di::SpscByteRingHeader) + 64> {};
+    auto channel = di::SpscRingChannel(*di::SpscByteRing::create(memory.span()));
+
+    auto input = R"({"a": [1, "b"]})"_sv;
+    ASSERT_EQ(channel.ring().try_write(di::as_bytes(input.span())), input.size_bytes());
+    channel.close();
+
+    auto count = [&]() -> di::Lazy<int> {
+        auto sequence = co_await di::async_json_events(channel);
+        auto numbers = 0;
+        auto strings = 0;
+        while (auto next = co_await di::execution::next(sequence)) {
+            numbers += di::holds_alternative<json::Number>(*next);
+            strings += di::holds_alternative<di::StringView>(*next);
+        }
+        co_return numbers * 10 + strings;
+    };
+    ASSERT_EQ(di::sync_wait(count()), 11);
+}
+
 TESTC(deserialization, json_value)
+TEST(deserialization, json_object)
+TEST(deserialization, json_arena)
 TEST(deserialization, json_escaped_string)
 TEST(deserialization, json_utf8_string)
 TESTC_CLANG(deserialization, json_literal)
 TESTC_CLANG(deserialization, json_reflect)
 TESTC_CLANG(deserialization, binary)
+TEST(deserialization, binary_borrowed)
+TEST(deserialization, binary_bulk)
+TEST(deserialization, compact_binary)
+TEST(deserialization, varint_bulk_decode)
+TEST(deserialization, table_format)
+TEST(deserialization, json_events)
+TEST(deserialization, json_events_chunked)
+TEST(deserialization, json_events_async)
 }
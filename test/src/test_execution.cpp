@@ -1,11 +1,17 @@
+#include <thread>
+
 #include "di/any/storage/hybrid_storage.h"
 #include "di/any/storage/prelude.h"
 #include "di/any/storage/unique_storage.h"
 #include "di/any/vtable/maybe_inline_vtable.h"
+#include "di/chrono/clock/prelude.h"
+#include "di/chrono/duration/prelude.h"
 #include "di/container/algorithm/prelude.h"
 #include "di/container/allocator/allocation_result.h"
 #include "di/container/allocator/allocator.h"
 #include "di/container/allocator/fail_allocator.h"
+#include "di/container/allocator/infallible_allocator.h"
+#include "di/container/vector/prelude.h"
 #include "di/container/view/prelude.h"
 #include "di/execution/algorithm/bulk.h"
 #include "di/execution/algorithm/ensure_started.h"
@@ -26,14 +32,18 @@
 #include "di/execution/algorithm/transfer_just.h"
 #include "di/execution/algorithm/use_resources.h"
 #include "di/execution/algorithm/when_all.h"
+#include "di/execution/algorithm/when_all_range.h"
 #include "di/execution/algorithm/with_env.h"
 #include "di/execution/any/any_operation_state.h"
 #include "di/execution/any/any_sender.h"
 #include "di/execution/concepts/prelude.h"
 #include "di/execution/concepts/receiver.h"
 #include "di/execution/concepts/receiver_of.h"
+#include "di/execution/context/epoll_context.h"
 #include "di/execution/context/inline_scheduler.h"
 #include "di/execution/context/run_loop.h"
+#include "di/execution/context/timing_wheel.h"
+#include "di/execution/context/trampoline_scheduler.h"
 #include "di/execution/interface/run.h"
 #include "di/execution/meta/completion_signatures_of.h"
 #include "di/execution/meta/sends_stopped.h"
@@ -56,6 +66,7 @@
 #include "di/util/prelude.h"
 #include "di/vocab/error/prelude.h"
 #include "di/vocab/expected/prelude.h"
+#include "di/vocab/optional/prelude.h"
 
 namespace execution {
 static void meta() {
@@ -171,6 +182,55 @@ static void just() {
         di::Unexpected(di::BasicError::InvalidArgument));
 }
 
+static void lazy_frame_allocator() {
+    struct CountingAllocator {
+        usize* allocations;
+        usize* deallocations;
+
+        auto allocate(usize size, usize alignment) const noexcept -> di::AllocationResult<> {
+            ++*allocations;
+            return di::InfallibleAllocator::allocate(size, alignment);
+        }
+
+        void deallocate(void* data, usize size, usize alignment) const noexcept {
+            ++*deallocations;
+            di::InfallibleAllocator::deallocate(data, size, alignment);
+        }
+    };
+
+    constexpr static auto task = [](di::AllocatorArg, auto, i32 value) -> di::Lazy<i32> {
+        co_return value * 2;
+    };
+
+    auto allocations = 0ZU;
+    auto deallocations = 0ZU;
+    auto allocator = CountingAllocator { &allocations, &deallocations };
+    ASSERT_EQ(di::sync_wait(task(di::allocator_arg, allocator, 21)), 42);
+    ASSERT_EQ(allocations, 1U);
+    ASSERT_EQ(deallocations, 1U);
+
+    ASSERT_EQ(di::sync_wait(task(di::allocator_arg, di::fail_allocator, 21)),
+              di::Unexpected(di::BasicError::NotEnoughMemory));
+
+    // Frames allocated without an explicit allocator come from the per-thread frame cache.
+    constexpr static auto plain_task = [](i32 value) -> di::Lazy<i32> {
+        co_return value * 2;
+    };
+    for (auto i = 0; i < 64; i++) {
+        ASSERT_EQ(di::sync_wait(plain_task(i)), i * 2);
+    }
+
+    // Frames freed by thread local destructors which run after the frame cache was destroyed must bypass it.
+    auto thread = std::thread([] {
+        thread_local auto holder = di::Optional<di::Lazy<i32>> {};
+
+        // Using the holder first ensures it is destroyed after the frame cache.
+        auto& lazy = holder;
+        lazy.emplace(plain_task(1));
+    });
+    thread.join();
+}
+
 static void coroutine() {
     namespace ex = di::execution;
 
@@ -203,6 +263,47 @@ static void coroutine() {
     ASSERT_EQ(di::sync_wait(stopped_direct()), di::Unexpected(di::BasicError::OperationCanceled));
 }
 
+static void symmetric_transfer() {
+    namespace ex = di::execution;
+
+    // Awaiting many senders which complete inline must not grow the stack.
+    constexpr static auto task = [] -> di::Lazy<i32> {
+        auto sum = 0;
+        for (auto i = 0; i < 1000000; i++) {
+            sum += co_await ex::just(1);
+        }
+        co_return sum;
+    };
+    ASSERT_EQ(di::sync_wait(task()), 1000000);
+
+    constexpr static auto error = [] -> di::Lazy<i32> {
+        for (auto i = 0; i < 1000000; i++) {
+            co_await ex::just();
+        }
+        co_await ex::just_error(di::BasicError::InvalidArgument);
+        co_return 0;
+    };
+    ASSERT_EQ(di::sync_wait(error()), di::Unexpected(di::BasicError::InvalidArgument));
+}
+
+static void trampoline_scheduler() {
+    namespace ex = di::execution;
+
+    auto scheduler = di::TrampolineScheduler {};
+    ASSERT_EQ(ex::sync_wait(ex::on(scheduler, ex::just(42))), 42);
+
+    // Repeatedly rescheduling from within a completion runs in bounded stack.
+    auto count = 0;
+    auto work = ex::schedule(scheduler) | ex::then([&] {
+                    ++count;
+                }) |
+                ex::repeat_effect_until([&] {
+                    return count == 1000000;
+                });
+    ASSERT(ex::sync_wait(di::move(work)));
+    ASSERT_EQ(count, 1000000);
+}
+
 static void then() {
     //! [then]
     namespace execution = di::execution;
@@ -522,6 +623,36 @@ static void when_all() {
     ASSERT(executed);
 }
 
+static void when_all_range() {
+    namespace ex = di::execution;
+
+    auto senders = di::Vector<decltype(ex::just(0))> {};
+    for (auto i = 0; i < 100; i++) {
+        senders.push_back(ex::just(i));
+    }
+    ASSERT_EQ(ex::sync_wait(ex::when_all_range(di::move(senders))), di::range(100) | di::to<di::Vector>());
+
+    auto void_senders = di::Vector<decltype(ex::just())> {};
+    for (auto i = 0; i < 10; i++) {
+        void_senders.push_back(ex::just());
+    }
+    ASSERT(ex::sync_wait(ex::when_all_range(di::move(void_senders))));
+
+    ASSERT(ex::sync_wait(ex::when_all_range(di::Vector<decltype(ex::just())> {})));
+
+    auto fallible_senders = di::Vector<decltype(ex::just_or_error(di::Result<int>(0)))> {};
+    fallible_senders.push_back(ex::just_or_error(di::Result<int>(1)));
+    fallible_senders.push_back(ex::just_or_error(di::Result<int>(di::Unexpected(di::BasicError::InvalidArgument))));
+    fallible_senders.push_back(ex::just_or_error(di::Result<int>(3)));
+    ASSERT_EQ(ex::sync_wait(ex::when_all_range(di::move(fallible_senders))),
+              di::Unexpected(di::BasicError::InvalidArgument));
+
+    auto failing = di::Vector<decltype(ex::just(0))> {};
+    failing.push_back(ex::just(0));
+    ASSERT_EQ(ex::sync_wait(ex::when_all_range(di::move(failing), di::fail_allocator)),
+              di::Unexpected(di::BasicError::NotEnoughMemory));
+}
+
 static void with_env() {
     //! [with_env]
     namespace execution = di::execution;
@@ -719,13 +850,189 @@ static void split() {
               di::Unexpected(di::BasicError::NotEnoughMemory));
 }
 
+static void schedule_after() {
+    namespace execution = di::execution;
+
+    auto start = di::SteadyClock::now();
+    auto send = execution::get_scheduler() | execution::let_value([](auto scheduler) {
+                    return execution::when_all(execution::schedule_after(scheduler, 2_ms) | execution::then([] {
+                                                   return 1;
+                                               }),
+                                               execution::schedule_after(scheduler, 1_ms) | execution::then([] {
+                                                   return 2;
+                                               }));
+                });
+    ASSERT_EQ(execution::sync_wait(di::move(send)), di::make_tuple(1, 2));
+    ASSERT(di::SteadyClock::now() - start >= 2_ms);
+
+    // Timers in the past complete immediately.
+    auto past = execution::get_scheduler() | execution::let_value([](auto scheduler) {
+                    return execution::schedule_at(scheduler, execution::now(scheduler) - 5_s);
+                });
+    ASSERT(execution::sync_wait(di::move(past)));
+
+    // Cancelling a timer completes it with stopped.
+    auto stop_source = di::InPlaceStopSource {};
+    auto env =
+        execution::make_env(di::empty_env, execution::with(execution::get_stop_token, stop_source.get_stop_token()));
+    auto long_timer = execution::get_scheduler() | execution::let_value([](auto scheduler) {
+                          return execution::schedule_after(scheduler, 1000_s);
+                      });
+    stop_source.request_stop();
+    ASSERT_EQ(execution::sync_wait(execution::with_env(env, di::move(long_timer))),
+              di::Unexpected(di::BasicError::OperationCanceled));
+
+    // A loop which is never idle still runs its timers.
+    auto busy_loop = di::RunLoop<> {};
+    auto fired = false;
+    execution::start_detached(execution::schedule_after(busy_loop.get_scheduler(), 1_ms) | execution::then([&] {
+                                  fired = true;
+                              }));
+    execution::start_detached(execution::schedule(busy_loop.get_scheduler()) | execution::repeat_effect_until([&] {
+                                  if (fired) {
+                                      busy_loop.finish();
+                                  }
+                                  return fired;
+                              }));
+    busy_loop.run();
+    ASSERT(fired);
+
+    // Stopping a loop completes its pending timers with stopped, instead of waiting for them to expire.
+    auto loop = di::RunLoop<> {};
+    auto stopped = false;
+    execution::start_detached(execution::schedule_after(loop.get_scheduler(), 1000_s) | execution::let_stopped([&] {
+                                  stopped = true;
+                                  return execution::just();
+                              }));
+    loop.finish();
+    loop.run();
+    ASSERT(stopped);
+}
+
+static void timing_wheel() {
+    struct Timer : di::TimingWheelNode {
+        explicit Timer(u64 deadline) : di::TimingWheelNode(deadline) {}
+    };
+
+    auto wheel = di::TimingWheel<Timer, 2, 2> { 10 };
+    auto timers = di::Array { Timer(10), Timer(11), Timer(13), Timer(40), Timer(200) };
+    for (auto& timer : timers) {
+        wheel.insert(timer);
+    }
+    ASSERT_EQ(wheel.size(), 5U);
+
+    auto expired = di::Vector<u64> {};
+    auto collect = [&](Timer& timer) {
+        expired.push_back(timer.deadline());
+    };
+
+    wheel.advance(10, collect);
+    ASSERT_EQ(expired, di::Array { u64(10) } | di::to<di::Vector>());
+    ASSERT_EQ(wheel.next_expiry_tick(), 11U);
+
+    wheel.erase(timers[2]);
+    ASSERT(!timers[2].linked());
+
+    wheel.advance(100, collect);
+    ASSERT_EQ(expired, (di::Array { u64(10), u64(11), u64(40) } | di::to<di::Vector>()));
+    ASSERT_EQ(wheel.size(), 1U);
+
+    wheel.advance(1000, collect);
+    ASSERT_EQ(expired, (di::Array { u64(10), u64(11), u64(40), u64(200) } | di::to<di::Vector>()));
+    ASSERT(wheel.empty());
+
+    // Draining removes every timer, including those in higher levels and the overflow list.
+    for (auto& timer : timers) {
+        wheel.insert(timer);
+    }
+    auto drained = 0U;
+    wheel.drain([&](Timer& timer) {
+        ASSERT(!timer.linked());
+        ++drained;
+    });
+    ASSERT_EQ(drained, 5U);
+    ASSERT(wheel.empty());
+}
+
+#ifdef __linux__
+static void epoll_context() {
+    namespace execution = di::execution;
+    namespace linux_syscall = di::platform::linux_syscall;
+
+    auto context = di::EpollContext::create();
+    ASSERT(context);
+    auto scheduler = context->get_scheduler();
+    auto loop = std::thread([&] {
+        context->run();
+    });
+
+    int fds[2];
+    ASSERT(!linux_syscall::is_error(
+        linux_syscall::socketpair(linux_syscall::address_family_unix, linux_syscall::socket_stream, 0, fds)));
+    auto a = di::EpollFile(*context, fds[0]);
+    auto b = di::EpollFile(*context, fds[1]);
+
+    // The read starts before anything is written, so it has to wait for epoll to report the socket as readable.
+    auto message = di::Array { byte(1), byte(2), byte(3) };
+    auto buffer = di::Array<byte, 3> {};
+    auto transfer = execution::when_all(execution::async_read_some(b, buffer.span()),
+                                        execution::schedule(scheduler) | execution::let_value([&] {
+                                            return execution::async_write_some(a, message.span());
+                                        }));
+    ASSERT_EQ(execution::sync_wait(di::move(transfer)), di::make_tuple(3ZU, 3ZU));
+    ASSERT(buffer == message);
+
+    // Cancelling a waiting read completes it with stopped.
+    auto stop_source = di::InPlaceStopSource {};
+    auto env =
+        execution::make_env(di::empty_env, execution::with(execution::get_stop_token, stop_source.get_stop_token()));
+    auto cancelled = execution::when_all(execution::with_env(env, execution::async_read_some(b, buffer.span())),
+                                         execution::schedule(scheduler) | execution::then([&] {
+                                             stop_source.request_stop();
+                                         }));
+    ASSERT_EQ(execution::sync_wait(di::move(cancelled)), di::Unexpected(di::BasicError::OperationCanceled));
+
+    // Accepting waits for the client to connect, on a socket in the abstract namespace.
+    char const name[] = "\0di-epoll-context-test";
+    auto address = *di::SocketAddress::unix_domain({ name, sizeof(name) - 1 });
+    auto received = di::Array<byte, 3> {};
+    auto connection = execution::use_resources(
+        [&](auto listener, auto client) {
+            return execution::async_bind(listener.get(), address) | execution::let_value([listener] {
+                       return execution::async_listen(listener.get(), 1);
+                   }) |
+                   execution::let_value([&, listener, client] {
+                       auto server = execution::use_resources(
+                           [&](auto accepted) {
+                               return execution::async_write_some(accepted.get(), message.span());
+                           },
+                           execution::async_accept(listener.get()));
+                       return execution::when_all(di::move(server), execution::async_connect(client.get(), address));
+                   }) |
+                   execution::let_value([&, client](usize) {
+                       return execution::async_read_some(client.get(), received.span());
+                   });
+        },
+        execution::async_make_socket(scheduler, linux_syscall::address_family_unix, linux_syscall::socket_stream),
+        execution::async_make_socket(scheduler, linux_syscall::address_family_unix, linux_syscall::socket_stream));
+    ASSERT_EQ(execution::sync_wait(di::move(connection)), 3ZU);
+    ASSERT(received == message);
+
+    context->finish();
+    loop.join();
+}
+#endif
+
 TEST(execution, meta)
 TEST(execution, sync_wait)
 TEST(execution, just)
 TEST(execution, lazy)
+TEST(execution, lazy_frame_allocator)
 TEST(execution, coroutine)
+TEST(execution, symmetric_transfer)
 TEST(execution, then)
 TEST(execution, inline_scheduler)
+TEST(execution, trampoline_scheduler)
 TEST(execution, let)
 TEST(execution, transfer)
 TEST(execution, as)
@@ -733,10 +1040,16 @@ TEST(execution, use_resources)
 TEST(execution, any_sender)
 TEST(execution, into_result)
 TEST(execution, when_all)
+TEST(execution, when_all_range)
 TEST(execution, with_env)
 TEST(execution, counting_scope)
 TEST(execution, start_detached)
 TEST(execution, ensure_started)
 TEST(execution, bulk)
 TEST(execution, split)
+TEST(execution, schedule_after)
+TEST(execution, timing_wheel)
+#ifdef __linux__
+TEST(execution, epoll_context)
+#endif
 }
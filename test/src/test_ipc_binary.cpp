@@ -1,14 +1,29 @@
+#include <thread>
+#include <unistd.h>
+
+#include "di/container/string/string_view.h"
 #include "di/container/vector/vector.h"
 #include "di/execution/algorithm/just.h"
 #include "di/execution/algorithm/just_from.h"
+#include "di/execution/algorithm/let.h"
+#include "di/execution/algorithm/on.h"
+#include "di/execution/algorithm/read.h"
+#include "di/execution/algorithm/repeat_effect_until.h"
 #include "di/execution/algorithm/sync_wait.h"
 #include "di/execution/algorithm/then.h"
 #include "di/execution/algorithm/use_resources.h"
+#include "di/execution/algorithm/when_all.h"
 #include "di/execution/algorithm/with_env.h"
+#include "di/execution/context/epoll_context.h"
+#include "di/execution/context/run_loop.h"
+#include "di/execution/interface/schedule.h"
 #include "di/execution/io/async_read_some.h"
 #include "di/execution/io/async_write_some.h"
 #include "di/execution/io/ipc_binary.h"
 #include "di/execution/io/ipc_protocol.h"
+#include "di/execution/io/shared_ring_channel.h"
+#include "di/execution/io/spsc_ring_channel.h"
+#include "di/execution/query/make_env.h"
 #include "di/execution/sequence/ignore_all.h"
 #include "di/execution/sequence/then_each.h"
 #include "di/function/overload.h"
@@ -18,6 +33,7 @@
 #include "di/io/vector_writer.h"
 #include "di/io/write_exactly.h"
 #include "di/serialization/binary_serializer.h"
+#include "di/sync/prelude.h"
 #include "di/test/prelude.h"
 
 namespace ipc_binary {
@@ -31,6 +47,33 @@ struct AsyncReader {
     }
 };
 
+struct CountingAsyncReader {
+    di::VectorReader<> sync_reader;
+    usize read_count { 0 };
+
+    friend auto tag_invoke(di::Tag<di::execution::async_read_some>, CountingAsyncReader& self, di::Span<byte> buffer,
+                           auto) {
+        return di::execution::just_from([&self, buffer] -> di::Result<usize> {
+            ++self.read_count;
+            return di::read_some(self.sync_reader, buffer);
+        });
+    }
+};
+
+// Completes every read inline with at most a single byte, so that a message takes many reads.
+struct TrickleAsyncReader {
+    di::VectorReader<> sync_reader;
+    usize read_count { 0 };
+
+    friend auto tag_invoke(di::Tag<di::execution::async_read_some>, TrickleAsyncReader& self, di::Span<byte> buffer,
+                           auto) {
+        return di::execution::just_from([&self, buffer] -> di::Result<usize> {
+            ++self.read_count;
+            return di::read_some(self.sync_reader, *buffer.first(1));
+        });
+    }
+};
+
 struct AsyncWriter {
     di::VectorWriter<> sync_writer;
 
@@ -42,6 +85,36 @@ struct AsyncWriter {
     }
 };
 
+struct FailingAsyncWriter {
+    usize write_count { 0 };
+
+    friend auto tag_invoke(di::Tag<di::execution::async_write_some>, FailingAsyncWriter& self, di::Span<byte const>,
+                           auto) {
+        return di::execution::just_from([&self] -> di::Result<usize> {
+            ++self.write_count;
+            return di::Unexpected(di::BasicError::InvalidArgument);
+        });
+    }
+};
+
+// Completes writes asynchronously on the scheduler of sync_wait(), so that multiple messages can be queued while a
+// write is in flight.
+struct ScheduledAsyncWriter {
+    using Scheduler = decltype(di::declval<di::RunLoop<>>().get_scheduler());
+
+    di::VectorWriter<> sync_writer;
+    di::Optional<Scheduler> scheduler;
+    usize write_count { 0 };
+
+    friend auto tag_invoke(di::Tag<di::execution::async_write_some>, ScheduledAsyncWriter& self,
+                           di::Span<byte const> buffer, auto) {
+        return di::execution::schedule(*self.scheduler) | di::execution::then([&self, buffer] -> di::Result<usize> {
+                   ++self.write_count;
+                   return di::write_some(self.sync_writer, buffer);
+               });
+    }
+};
+
 struct ClientMessage1 {
     int x;
     int y;
@@ -85,6 +158,24 @@ using MyProtocol = di::Protocol<di::meta::List<ClientMessage1, ClientMessage2>,
 static_assert(di::concepts::MessageWithReply<ClientMessage2>);
 static_assert(!di::concepts::MessageWithReply<ClientMessage2::Reply>);
 
+struct NamedMessage {
+    struct Reply {
+        di::StringView name;
+
+        constexpr friend auto tag_invoke(di::Tag<di::reflect>, di::InPlaceType<Reply>) {
+            return di::make_fields<"NamedMessage::Reply">(di::field<"name", &Reply::name>);
+        }
+    };
+
+    int x;
+
+    constexpr friend auto tag_invoke(di::Tag<di::reflect>, di::InPlaceType<NamedMessage>) {
+        return di::make_fields<"NamedMessage">(di::field<"x", &NamedMessage::x>);
+    }
+};
+
+using NamedProtocol = di::Protocol<di::meta::List<NamedMessage>, di::meta::List<ServerMessage>>;
+
 static void send() {
     auto read = AsyncReader {};
     auto write = AsyncWriter {};
@@ -177,7 +268,466 @@ static void send_with_reply() {
     ASSERT_EQ(r, 3);
 }
 
+static void recv_batched() {
+    auto client_read = AsyncReader {};
+    auto client_write = AsyncWriter {};
+
+    auto sent = 0;
+    auto client = di::execution::ipc_binary_connect_to_server<MyProtocol>(
+        di::ipc::Receiver(di::ref(client_read)), di::ipc::Transmitter(di::ref(client_write)),
+        di::ipc::Transmit([&sent](auto connection) {
+            return di::send(connection, ClientMessage1 { 1, 2 }) | di::execution::repeat_effect_until([&sent] {
+                       return ++sent == 100;
+                   });
+        }));
+    ASSERT(di::sync_wait(di::move(client)));
+
+    ASSERT_EQ(client_write.sync_writer.vector().size(), 2000);
+
+    auto read = CountingAsyncReader { di::VectorReader<> { di::move(client_write).sync_writer.vector() } };
+    auto write = AsyncWriter {};
+
+    auto count = 0;
+    auto sum = 0;
+    auto server = di::execution::ipc_binary_connect_to_client<MyProtocol>(di::ipc::Receiver(di::ref(read)),
+                                                                          di::ipc::Transmitter(di::ref(write)),
+                                                                          di::ipc::Receive(di::overload(
+                                                                              [&](ClientMessage1 message) {
+                                                                                  ++count;
+                                                                                  sum += message.x + message.y;
+                                                                              },
+                                                                              [&](auto) {})));
+    ASSERT(di::sync_wait(di::move(server)));
+
+    ASSERT_EQ(count, 100);
+    ASSERT_EQ(sum, 300);
+
+    // All messages fit in a single read, followed by a read which observes the end of the stream.
+    ASSERT_EQ(read.read_count, 2U);
+}
+
+static void recv_trickled() {
+    auto client_read = AsyncReader {};
+    auto client_write = AsyncWriter {};
+
+    auto sent = 0;
+    auto client = di::execution::ipc_binary_connect_to_server<MyProtocol>(
+        di::ipc::Receiver(di::ref(client_read)), di::ipc::Transmitter(di::ref(client_write)),
+        di::ipc::Transmit([&sent](auto connection) {
+            return di::send(connection, ClientMessage1 { 1, 2 }) | di::execution::repeat_effect_until([&sent] {
+                       return ++sent == 100;
+                   });
+        }));
+    ASSERT(di::sync_wait(di::move(client)));
+
+    // Every read completes inline, which must not recurse once per read.
+    auto read = TrickleAsyncReader { di::VectorReader<> { di::move(client_write).sync_writer.vector() } };
+    auto write = AsyncWriter {};
+
+    auto count = 0;
+    auto server = di::execution::ipc_binary_connect_to_client<MyProtocol>(di::ipc::Receiver(di::ref(read)),
+                                                                          di::ipc::Transmitter(di::ref(write)),
+                                                                          di::ipc::Receive(di::overload(
+                                                                              [&](ClientMessage1) {
+                                                                                  ++count;
+                                                                              },
+                                                                              [&](auto) {})));
+    ASSERT(di::sync_wait(di::move(server)));
+
+    ASSERT_EQ(count, 100);
+    ASSERT_EQ(read.read_count, 2001U);
+}
+
+static void send_coalesced() {
+    auto read = AsyncReader {};
+    auto write = ScheduledAsyncWriter {};
+
+    auto client = di::execution::ipc_binary_connect_to_server<MyProtocol>(
+        di::ipc::Receiver(di::ref(read)), di::ipc::Transmitter(di::ref(write)), di::ipc::Transmit([&](auto connection) {
+            return di::execution::get_scheduler() |
+                   di::execution::let_value([&write, connection](ScheduledAsyncWriter::Scheduler& scheduler) {
+                       write.scheduler = scheduler;
+                       return di::execution::when_all(di::send(connection, ClientMessage1 { 1, 2 }),
+                                                      di::send(connection, ClientMessage1 { 3, 4 }),
+                                                      di::send(connection, ClientMessage1 { 5, 6 }));
+                   });
+        }));
+    ASSERT(di::sync_wait(di::move(client)));
+
+    // The first message is written immediately, and the other two are written together once it finishes.
+    ASSERT_EQ(write.sync_writer.vector().size(), 60);
+    ASSERT_EQ(write.write_count, 2U);
+}
+
+static void reply_before_send_completes() {
+    auto initial_write = AsyncWriter {};
+    {
+        auto read = AsyncReader {};
+        auto server = di::execution::ipc_binary_connect_to_client<MyProtocol>(
+            di::ipc::Receiver(di::ref(read)), di::ipc::Transmitter(di::ref(initial_write)),
+            di::ipc::Transmit([&](auto connection) {
+                return di::send(connection, ClientMessage2::Reply { 1, 2 }, u32(0));
+            }));
+
+        ASSERT(di::sync_wait(di::move(server)));
+    }
+
+    // The reply is already available when the client starts reading, so it is processed while the request is still
+    // being written. This only works if the client waits for the reply before sending the request.
+    auto read = AsyncReader { di::VectorReader<> { di::move(initial_write).sync_writer.vector() } };
+    auto write = ScheduledAsyncWriter {};
+
+    auto r = 0;
+    auto client = di::execution::ipc_binary_connect_to_server<MyProtocol>(
+        di::ipc::Receiver(di::ref(read)), di::ipc::Transmitter(di::ref(write)), di::ipc::Transmit([&](auto connection) {
+            return di::execution::get_scheduler() |
+                   di::execution::let_value([&write, &r, connection](ScheduledAsyncWriter::Scheduler& scheduler) {
+                       write.scheduler = scheduler;
+                       return di::send(connection, ClientMessage2 { 1, 2, 3 }) |
+                              di::execution::then([&r](ClientMessage2::Reply reply) {
+                                  r = reply.x + reply.y;
+                              });
+                   });
+        }));
+    ASSERT(di::sync_wait(di::move(client)));
+
+    ASSERT_EQ(r, 3);
+    ASSERT_EQ(write.write_count, 1U);
+}
+
+static void borrowed_reply_before_send_completes() {
+    auto initial_write = AsyncWriter {};
+    {
+        auto read = AsyncReader {};
+        auto server = di::execution::ipc_binary_connect_to_client<NamedProtocol>(
+            di::ipc::Receiver(di::ref(read)), di::ipc::Transmitter(di::ref(initial_write)),
+            di::ipc::Transmit([&](auto connection) {
+                return di::send(connection, NamedMessage::Reply { "hello"_sv }, u32(0)) |
+                       di::execution::let_value([connection] {
+                           return di::send(connection, NamedMessage::Reply { "world"_sv }, u32(0));
+                       });
+            }));
+
+        ASSERT(di::sync_wait(di::move(server)));
+    }
+
+    // Reading a byte at a time empties the receive buffer after the first reply, so the duplicate reply is read into
+    // the same bytes before the request finishes being written. The first reply must not be affected by that.
+    auto read = TrickleAsyncReader { di::VectorReader<> { di::move(initial_write).sync_writer.vector() } };
+    auto write = ScheduledAsyncWriter {};
+
+    auto name_matches = false;
+    auto client = di::execution::ipc_binary_connect_to_server<NamedProtocol>(
+        di::ipc::Receiver(di::ref(read)), di::ipc::Transmitter(di::ref(write)), di::ipc::Transmit([&](auto connection) {
+            return di::execution::get_scheduler() |
+                   di::execution::let_value([&write, &name_matches,
+                                             connection](ScheduledAsyncWriter::Scheduler& scheduler) {
+                       write.scheduler = scheduler;
+                       return di::send(connection, NamedMessage { 1 }) |
+                              di::execution::then([&name_matches](NamedMessage::Reply reply) {
+                                  name_matches = reply.name == "hello"_sv;
+                              });
+                   });
+        }));
+    ASSERT(di::sync_wait(di::move(client)));
+
+    ASSERT(name_matches);
+}
+
+static void send_after_write_error() {
+    auto read = AsyncReader {};
+    auto write = FailingAsyncWriter {};
+
+    // Once a write failed, later messages fail without being written.
+    auto second_failed = false;
+    auto client = di::execution::ipc_binary_connect_to_server<MyProtocol>(
+        di::ipc::Receiver(di::ref(read)), di::ipc::Transmitter(di::ref(write)), di::ipc::Transmit([&](auto connection) {
+            return di::send(connection, ClientMessage1 { 1, 2 }) |
+                   di::execution::let_error([&second_failed, connection](di::Error) {
+                       return di::send(connection, ClientMessage1 { 3, 4 }) |
+                              di::execution::let_error([&second_failed](di::Error) {
+                                  second_failed = true;
+                                  return di::execution::just();
+                              });
+                   });
+        }));
+    ASSERT(di::sync_wait(di::move(client)));
+
+    ASSERT(second_failed);
+    ASSERT_EQ(write.write_count, 1U);
+}
+
+static void send_stopped() {
+    auto read = AsyncReader {};
+    auto write = ScheduledAsyncWriter {};
+
+    // The second message is queued behind the first one's write when it is stopped, so it completes with stopped
+    // without waiting for that write.
+    auto stop_source = di::InPlaceStopSource {};
+    auto env = di::execution::make_env(di::empty_env, di::execution::with(di::execution::get_stop_token,
+                                                                          stop_source.get_stop_token()));
+    auto stopped = false;
+    auto client = di::execution::ipc_binary_connect_to_server<MyProtocol>(
+        di::ipc::Receiver(di::ref(read)), di::ipc::Transmitter(di::ref(write)), di::ipc::Transmit([&](auto connection) {
+            return di::execution::get_scheduler() |
+                   di::execution::let_value([&, connection](ScheduledAsyncWriter::Scheduler& scheduler) {
+                       write.scheduler = scheduler;
+                       return di::execution::when_all(
+                           di::send(connection, ClientMessage1 { 1, 2 }),
+                           di::execution::with_env(env, di::send(connection, ClientMessage1 { 3, 4 })) |
+                               di::execution::let_stopped([&stopped] {
+                                   stopped = true;
+                                   return di::execution::just();
+                               }),
+                           di::execution::just_from([&stop_source] {
+                               stop_source.request_stop();
+                           }));
+                   });
+        }));
+    ASSERT(di::sync_wait(di::move(client)));
+
+    ASSERT(stopped);
+}
+
+static void wait_for_reply_stopped() {
+    auto read = AsyncReader {};
+    auto write = AsyncWriter {};
+
+    // The request is written, but the reply never arrives. Stopping the sender removes its reply waiter.
+    auto stop_source = di::InPlaceStopSource {};
+    auto env = di::execution::make_env(di::empty_env, di::execution::with(di::execution::get_stop_token,
+                                                                          stop_source.get_stop_token()));
+    auto stopped = false;
+    auto client = di::execution::ipc_binary_connect_to_server<MyProtocol>(
+        di::ipc::Receiver(di::ref(read)), di::ipc::Transmitter(di::ref(write)), di::ipc::Transmit([&](auto connection) {
+            auto request = di::execution::with_env(env, di::send(connection, ClientMessage2 { 1, 2, 3 })) |
+                           di::execution::then([](ClientMessage2::Reply) {}) |
+                           di::execution::let_stopped([&stopped] {
+                               stopped = true;
+                               return di::execution::just();
+                           });
+            return di::execution::when_all(di::move(request), di::execution::just_from([&stop_source] {
+                                               stop_source.request_stop();
+                                           }));
+        }));
+    ASSERT(di::sync_wait(di::move(client)));
+
+    ASSERT(stopped);
+    ASSERT_EQ(write.sync_writer.vector().size(), 24U);
+}
+
+static void spsc_byte_ring_corrupted() {
+    alignas(di::SpscByteRingHeader) auto memory = di::Array<byte, sizeof(di::SpscByteRingHeader) + 32> {};
+    auto ring = *di::SpscByteRing::create(memory.span());
+    auto data = di::Array<byte, 64> {};
+    ASSERT_EQ(ring.try_write(*data.first(8)), 8U);
+
+    // A write position too far ahead of the read position would make the reader copy past the end of the ring.
+    auto& header = *reinterpret_cast<di::SpscByteRingHeader*>(memory.data());
+    header.write_position.store(1000, di::MemoryOrder::Relaxed);
+    ASSERT(ring.closed());
+    ASSERT_EQ(ring.readable(), 0U);
+    ASSERT_EQ(ring.writable(), 0U);
+    ASSERT_EQ(ring.try_read(data.span()), 0U);
+    ASSERT_EQ(ring.try_write(data.span()), 0U);
+
+    // The same goes for a read position which is ahead of the write position.
+    header.write_position.store(8, di::MemoryOrder::Relaxed);
+    header.read_position.store(9, di::MemoryOrder::Relaxed);
+    ASSERT(ring.closed());
+    ASSERT_EQ(ring.try_read(data.span()), 0U);
+
+    // A channel over a corrupted ring reports end of file, and fails to write.
+    auto channel = di::SpscRingChannel(ring);
+    ASSERT_EQ(di::sync_wait(di::execution::async_read_some(channel, data.span())), 0U);
+    ASSERT_EQ(di::sync_wait(di::execution::async_write_some(channel, data.span())), 0U);
+}
+
+static void spsc_ring_channel() {
+    // Use tiny rings, so that messages wrap around and both sides have to wait for each other.
+    alignas(di::SpscByteRingHeader) auto client_memory = di::Array<byte, sizeof(di::SpscByteRingHeader) + 32> {};
+    alignas(di::SpscByteRingHeader) auto server_memory = di::Array<byte, sizeof(di::SpscByteRingHeader) + 32> {};
+
+    auto client_to_server = di::SpscRingChannel(*di::SpscByteRing::create(client_memory.span()));
+    auto server_to_client = di::SpscRingChannel(*di::SpscByteRing::create(server_memory.span()));
+    ASSERT_EQ(client_to_server.ring().capacity(), 32U);
+
+    auto sent = 0;
+    auto received = 0;
+    auto r = 0;
+    auto client = di::execution::ipc_binary_connect_to_server<MyProtocol>(
+        di::ipc::Receiver(di::ref(server_to_client)), di::ipc::Transmitter(di::ref(client_to_server)),
+        di::ipc::Transmit([&](auto connection) {
+            return di::send(connection, ClientMessage2 { 1, 2, 3 }) |
+                   di::execution::then([&](ClientMessage2::Reply reply) {
+                       r += reply.x + reply.y;
+                   }) |
+                   di::execution::repeat_effect_until([&] {
+                       return ++sent == 10;
+                   }) |
+                   di::execution::then([&] {
+                       client_to_server.close();
+                   });
+        }));
+
+    auto server = di::execution::ipc_binary_connect_to_client<MyProtocol>(
+        di::ipc::Receiver(di::ref(client_to_server)), di::ipc::Transmitter(di::ref(server_to_client)),
+        di::ipc::Receive(di::overload(
+            [&](ClientMessage2 message) {
+                ++received;
+                return ClientMessage2::Reply { message.x, message.y };
+            },
+            [&](auto) {})));
+
+    ASSERT(di::sync_wait(di::execution::when_all(di::move(client), di::move(server) | di::execution::then([&] {
+                                                                        server_to_client.close();
+                                                                    }))));
+
+    ASSERT_EQ(received, 10);
+    ASSERT_EQ(r, 30);
+}
+
+#ifdef __linux__
+static void shared_ring_channel() {
+    namespace execution = di::execution;
+
+    // Use tiny rings, so that both sides have to wait for each other. Each side runs on its own context and thread, and
+    // attaches to the rings through its own file descriptors, just as another process would.
+    auto client_context = di::EpollContext::create();
+    ASSERT(client_context);
+    auto server_context = di::EpollContext::create();
+    ASSERT(server_context);
+    auto client_loop = std::thread([&] {
+        client_context->run();
+    });
+    auto server_loop = std::thread([&] {
+        server_context->run();
+    });
+
+    auto client_channel = di::SharedRingChannel::create(*client_context, 32);
+    ASSERT(client_channel);
+    auto server_channel = di::SharedRingChannel::attach(*server_context, dup(client_channel->fd()),
+                                                        dup(client_channel->peer_doorbell()), 32);
+    ASSERT(server_channel);
+    client_channel->close_peer_doorbell();
+
+    auto received = 0;
+    auto server = di::execution::ipc_binary_connect_to_client<MyProtocol>(
+                      di::ipc::Receiver(di::ref(*server_channel)), di::ipc::Transmitter(di::ref(*server_channel)),
+                      di::ipc::Receive(di::overload(
+                          [&](ClientMessage2 message) {
+                              ++received;
+                              return ClientMessage2::Reply { message.x, message.y };
+                          },
+                          [&](auto) {}))) |
+                  execution::then([&] {
+                      server_channel->close();
+                  });
+
+    auto sent = 0;
+    auto r = 0;
+    auto client = di::execution::ipc_binary_connect_to_server<MyProtocol>(
+        di::ipc::Receiver(di::ref(*client_channel)), di::ipc::Transmitter(di::ref(*client_channel)),
+        di::ipc::Transmit([&](auto connection) {
+            return di::send(connection, ClientMessage2 { 1, 2, 3 }) |
+                   di::execution::then([&](ClientMessage2::Reply reply) {
+                       r += reply.x + reply.y;
+                   }) |
+                   di::execution::repeat_effect_until([&] {
+                       return ++sent == 10;
+                   }) |
+                   di::execution::then([&] {
+                       client_channel->close();
+                   });
+        }));
+
+    ASSERT(execution::sync_wait(execution::when_all(execution::on(client_context->get_scheduler(), di::move(client)),
+                                                    execution::on(server_context->get_scheduler(), di::move(server)))));
+    ASSERT_EQ(received, 10);
+    ASSERT_EQ(r, 30);
+
+    client_context->finish();
+    server_context->finish();
+    client_loop.join();
+    server_loop.join();
+}
+
+static void shared_ring_channel_peer_exit() {
+    namespace execution = di::execution;
+
+    auto context = di::EpollContext::create();
+    ASSERT(context);
+    auto scheduler = context->get_scheduler();
+    auto loop = std::thread([&] {
+        context->run();
+    });
+
+    auto channel = di::SharedRingChannel::create(*context, 32);
+    ASSERT(channel);
+    auto buffer = di::Array<byte, 4> {};
+    {
+        auto peer = di::SharedRingChannel::attach(*context, dup(channel->fd()), dup(channel->peer_doorbell()), 32);
+        ASSERT(peer);
+        channel->close_peer_doorbell();
+
+        // A parked read completes with stopped once its stop token is triggered.
+        auto stop_source = di::InPlaceStopSource {};
+        auto env = execution::make_env(di::empty_env,
+                                       execution::with(execution::get_stop_token, stop_source.get_stop_token()));
+        auto read = execution::with_env(env, execution::async_read_some(*channel, buffer.span()));
+        auto cancelled = execution::when_all(di::move(read), execution::just_from([&] {
+                                                 stop_source.request_stop();
+                                             }));
+        ASSERT_EQ(execution::sync_wait(execution::on(scheduler, di::move(cancelled))),
+                  di::Unexpected(di::BasicError::OperationCanceled));
+    }
+
+    // The peer exited without closing its ring, so the read observes end of file instead of waiting forever.
+    ASSERT_EQ(execution::sync_wait(execution::on(scheduler, execution::async_read_some(*channel, buffer.span()))), 0ZU);
+
+    context->finish();
+    loop.join();
+}
+
+static void shared_ring_channel_attach_invalid() {
+    namespace linux_syscall = di::platform::linux_syscall;
+
+    // The memfd comes from the peer, so it must be checked before mapping it, as accessing the mapping beyond the end
+    // of the file faults.
+    auto context = di::EpollContext::create();
+    ASSERT(context);
+    auto channel = di::SharedRingChannel::create(*context, 32);
+    ASSERT(channel);
+
+    auto too_small = di::SharedRingChannel::attach(*context, dup(channel->fd()), dup(channel->peer_doorbell()), 64);
+    ASSERT(!too_small);
+    ASSERT(too_small.error() == di::BasicError::InvalidArgument);
+
+    auto unsealed = linux_syscall::memfd_create("di-test", linux_syscall::mfd_cloexec);
+    ASSERT(!linux_syscall::is_error(unsealed));
+    ASSERT(!linux_syscall::is_error(linux_syscall::ftruncate(int(unsealed), 4096)));
+    auto truncatable = di::SharedRingChannel::attach(*context, int(unsealed), dup(channel->peer_doorbell()), 32);
+    ASSERT(!truncatable);
+    ASSERT(truncatable.error() == di::BasicError::InvalidArgument);
+}
+#endif
+
 TEST(ipc_binary, send)
 TEST(ipc_binary, recv)
 TEST(ipc_binary, send_with_reply)
+TEST(ipc_binary, recv_batched)
+TEST(ipc_binary, recv_trickled)
+TEST(ipc_binary, send_coalesced)
+TEST(ipc_binary, reply_before_send_completes)
+TEST(ipc_binary, borrowed_reply_before_send_completes)
+TEST(ipc_binary, send_after_write_error)
+TEST(ipc_binary, send_stopped)
+TEST(ipc_binary, wait_for_reply_stopped)
+TEST(ipc_binary, spsc_byte_ring_corrupted)
+TEST(ipc_binary, spsc_ring_channel)
+#ifdef __linux__
+TEST(ipc_binary, shared_ring_channel)
+TEST(ipc_binary, shared_ring_channel_peer_exit)
+TEST(ipc_binary, shared_ring_channel_attach_invalid)
+#endif
 }
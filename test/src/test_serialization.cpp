@@ -1,6 +1,7 @@
 #include "di/io/interface/writer.h"
 #include "di/io/prelude.h"
 #include "di/io/string_writer.h"
+#include "di/io/unchecked_span_writer.h"
 #include "di/io/vector_writer.h"
 #include "di/reflect/prelude.h"
 #include "di/serialization/binary_serializer.h"
@@ -261,6 +262,25 @@ constexpr static void json_escaped_string() {
     auto r1 = *di::to_json_string(s);
 
     ASSERT_EQ(r1, R"("a\b\f\n\r\t\u000B\u001F \"\\b")"_sv);
+
+    auto r2 =
+        *di::to_json_string("0123456789abcdef\"0123456789abcdef\n\x01 long runs of text, including héllo wörld"_sv);
+    ASSERT_EQ(r2, R"("0123456789abcdef\"0123456789abcdef\n\u0001 long runs of text, including héllo wörld")"_sv);
+
+    auto r3 = *di::to_json_string(""_sv);
+    ASSERT_EQ(r3, R"("")"_sv);
+}
+
+constexpr static void json_numbers() {
+    auto r1 = *di::to_json_string(
+        di::Array<i64, 6> { 0, 7, -7, 10, di::NumericLimits<i64>::min, di::NumericLimits<i64>::max });
+    ASSERT_EQ(r1, "[0,7,-7,10,-9223372036854775808,9223372036854775807]"_sv);
+
+    auto r2 = *di::to_json_string(di::Array<u64, 3> { 99, 100, di::NumericLimits<u64>::max });
+    ASSERT_EQ(r2, "[99,100,18446744073709551615]"_sv);
+
+    auto r3 = *di::to_json_string(di::Array<i8, 2> { -128, 127 });
+    ASSERT_EQ(r3, "[-128,127]"_sv);
 }
 
 constexpr static void binary() {
@@ -286,10 +306,51 @@ constexpr static void binary() {
                                 5_b, 0_b, 0_b, 0_b, 0_b, 0_b, 0_b, 0_b, 'h'_b, 'e'_b, 'l'_b, 'l'_b, 'o'_b });
 }
 
+struct FixedPoint {
+    i32 x;
+    i32 y;
+    u8 z;
+    MyEnum tag;
+
+    constexpr friend auto tag_invoke(di::Tag<di::reflect>, di::InPlaceType<FixedPoint>) {
+        return di::make_fields<"FixedPoint">(di::field<"x", &FixedPoint::x>, di::field<"y", &FixedPoint::y>,
+                                             di::field<"z", &FixedPoint::z>, di::field<"tag", &FixedPoint::tag>);
+    }
+};
+
+constexpr static void binary_size() {
+    namespace detail = di::serialization::detail;
+
+    static_assert(*detail::binary_fixed_size(di::in_place_type<FixedPoint>) == 13);
+    static_assert(*detail::binary_fixed_size(di::in_place_type<di::Tuple<u16, FixedPoint>>) == 15);
+    static_assert(!detail::binary_fixed_size(di::in_place_type<MyType>));
+    static_assert(!detail::binary_fixed_size(di::in_place_type<di::Variant<int, i64>>));
+
+    auto point = FixedPoint { 1, 2, 3, MyEnum::Baz };
+    ASSERT_EQ(di::serialize_size(di::binary_format, point), 13u);
+    ASSERT_EQ(di::serialize_size(di::binary_format, di::make_tuple(u16(1), point)), 15u);
+
+    // Types which aren't fixed size still fall back to measuring the output.
+    auto custom = MyType { 1, 2, 3, true, "hello"_sv };
+    ASSERT_EQ(di::serialize_size(di::binary_format, custom), 26u);
+
+    // Serializing into presized storage produces the same bytes as the checked path.
+    auto expected = di::VectorWriter<>();
+    ASSERT(di::serialize_binary(expected, custom));
+
+    auto storage = di::Array<byte, 26> {};
+    auto writer = di::UncheckedSpanWriter(storage.span());
+    ASSERT(di::serialize_binary(writer, custom));
+    ASSERT_EQ(writer.written(), 26u);
+    ASSERT(di::container::equal(storage, expected.vector()));
+}
+
 TESTC(serialization, json_basic)
 TESTC(serialization, json_pretty)
 TESTC(serialization, json_reflect)
 TESTC(serialization, json_value)
 TESTC(serialization, json_escaped_string)
+TESTC(serialization, json_numbers)
 TESTC(serialization, binary)
+TESTC(serialization, binary_size)
 }
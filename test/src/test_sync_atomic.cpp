@@ -0,0 +1,81 @@
+#include <thread>
+
+#include "di/sync/prelude.h"
+#include "di/test/prelude.h"
+
+namespace sync_atomic {
+static void wait_unchanged() {
+    // Waiting on a value which already differs must return immediately, and notifying with no waiters is a no-op.
+    auto word = di::Atomic<u32>(1);
+    word.wait(0);
+    word.notify_one();
+    word.notify_all();
+
+    auto wide = di::Atomic<u64>(1);
+    wide.wait(0);
+    wide.notify_all();
+
+    auto value = 5;
+    auto ref = di::AtomicRef<int>(value);
+    ref.wait(4);
+    ref.notify_one();
+}
+
+template<typename T>
+static void ping_pong() {
+    constexpr auto rounds = T(1000);
+
+    auto value = di::Atomic<T>(0);
+    auto thread = std::thread([&] {
+        for (auto i = T(0); i < rounds; i++) {
+            value.wait(T(2 * i));
+            value.store(T(2 * i + 2));
+            value.notify_one();
+        }
+    });
+
+    for (auto i = T(0); i < rounds; i++) {
+        value.store(T(2 * i + 1));
+        value.notify_one();
+        value.wait(T(2 * i + 1));
+    }
+    thread.join();
+
+    ASSERT_EQ(value.load(), T(2 * rounds));
+}
+
+static void ping_pong_word() {
+    ping_pong<u32>();
+}
+
+static void ping_pong_parked() {
+    ping_pong<u64>();
+    ping_pong<u16>();
+}
+
+static void notify_all() {
+    auto flag = di::Atomic<bool>(false);
+    auto woken = di::Atomic<u32>(0);
+
+    auto wait = [&] {
+        flag.wait(false);
+        woken.fetch_add(1);
+    };
+    auto a = std::thread(wait);
+    auto b = std::thread(wait);
+    auto c = std::thread(wait);
+
+    flag.store(true);
+    flag.notify_all();
+
+    a.join();
+    b.join();
+    c.join();
+    ASSERT_EQ(woken.load(), 3U);
+}
+
+TEST(sync_atomic, wait_unchanged)
+TEST(sync_atomic, ping_pong_word)
+TEST(sync_atomic, ping_pong_parked)
+TEST(sync_atomic, notify_all)
+}
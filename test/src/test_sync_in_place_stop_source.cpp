@@ -1,3 +1,5 @@
+#include <thread>
+
 #include "di/sync/prelude.h"
 #include "di/test/prelude.h"
 
@@ -51,5 +53,82 @@ static void basic() {
     ASSERT(!did_happen2);
 }
 
+static void out_of_order() {
+    auto source = di::InPlaceStopSource {};
+    auto token = source.get_stop_token();
+
+    auto count = 0;
+    auto increment = [&] {
+        count++;
+    };
+
+    // Destroy callbacks from the middle and the tail of the list, and not just the head.
+    auto* a = new di::InPlaceStopCallback(token, increment);
+    auto* b = new di::InPlaceStopCallback(token, increment);
+    auto* c = new di::InPlaceStopCallback(token, increment);
+    auto* d = new di::InPlaceStopCallback(token, increment);
+    delete b;
+    delete a;
+
+    ASSERT(source.request_stop());
+    ASSERT_EQ(count, 2);
+    delete c;
+    delete d;
+
+    // Registering after a stop request runs the callback immediately.
+    {
+        auto late = di::InPlaceStopCallback(token, increment);
+        ASSERT_EQ(count, 3);
+    }
+    ASSERT_EQ(count, 3);
+
+    // Callbacks on a token without a source are never registered.
+    {
+        auto never = di::InPlaceStopCallback(di::InPlaceStopToken {}, increment);
+    }
+    ASSERT_EQ(count, 3);
+}
+
+static void concurrent() {
+    constexpr auto thread_count = 4;
+    constexpr auto iterations = 1000;
+
+    auto source = di::InPlaceStopSource {};
+    auto executed = di::Atomic<int>(0);
+    auto registered = di::Atomic<int>(0);
+
+    std::thread threads[thread_count];
+    for (auto& thread : threads) {
+        thread = std::thread([&] {
+            for (auto i = 0; i < iterations; i++) {
+                auto callback = di::InPlaceStopCallback(source.get_stop_token(), [&] {
+                    executed.fetch_add(1);
+                });
+
+                // Halfway through, wait for the stop request while a callback is registered.
+                if (i == iterations / 2) {
+                    registered.fetch_add(1);
+                    while (!source.stop_requested()) {
+                        di::cpu_relax();
+                    }
+                }
+            }
+        });
+    }
+
+    while (registered.load() != thread_count) {
+        di::cpu_relax();
+    }
+    ASSERT(source.request_stop());
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // The callback registered during the stop request runs, and so does every callback registered afterwards.
+    ASSERT_EQ(executed.load(), thread_count * (iterations / 2));
+}
+
 TEST(sync_in_place_stop_source, basic)
+TEST(sync_in_place_stop_source, out_of_order)
+TEST(sync_in_place_stop_source, concurrent)
 }
@@ -0,0 +1,59 @@
+#include <thread>
+
+#include "di/sync/prelude.h"
+#include "di/test/prelude.h"
+
+namespace sync_mutex {
+template<typename Lock>
+static void basic() {
+    auto lock = Lock {};
+    ASSERT(lock.try_lock());
+    ASSERT(!lock.try_lock());
+    lock.unlock();
+
+    lock.lock();
+    ASSERT(!lock.try_lock());
+    lock.unlock();
+    ASSERT(lock.try_lock());
+    lock.unlock();
+}
+
+// Oversubscribe the lock, so that contended threads are forced to back off (and, for Mutex, park).
+template<typename Lock>
+static void contended() {
+    constexpr auto thread_count = 8;
+    constexpr auto iterations = 10000;
+
+    auto counter = di::Synchronized<int, Lock>(0);
+    auto worker = [&] {
+        for (auto i = 0; i < iterations; i++) {
+            counter.with_lock([](int& value) {
+                value++;
+            });
+        }
+    };
+
+    std::thread threads[thread_count];
+    for (auto& thread : threads) {
+        thread = std::thread(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(counter.read(), thread_count * iterations);
+}
+
+static void mutex() {
+    basic<di::Mutex>();
+    contended<di::Mutex>();
+}
+
+static void ticket_lock() {
+    basic<di::TicketLock>();
+    contended<di::TicketLock>();
+}
+
+TEST(sync_mutex, mutex)
+TEST(sync_mutex, ticket_lock)
+}
@@ -0,0 +1,75 @@
+#include <thread>
+
+#include "di/sync/prelude.h"
+#include "di/test/prelude.h"
+
+namespace sync_read_mostly {
+static void basic() {
+    auto cell = di::ReadMostly<int>(1);
+    auto reader = cell.reader();
+
+    auto value = reader.read([](int const& current) {
+        return current;
+    });
+    ASSERT_EQ(value, 1);
+
+    cell.update([](int& current) {
+        current += 2;
+    });
+    value = reader.read([](int const& current) {
+        return current;
+    });
+    ASSERT_EQ(value, 3);
+
+    cell.store(5);
+    ASSERT_EQ(cell.read(), 5);
+}
+
+static void concurrent() {
+    constexpr auto reader_count = 4;
+    constexpr auto updates = 1000;
+
+    struct Pair {
+        int a { 0 };
+        int b { 0 };
+    };
+
+    auto cell = di::ReadMostly<Pair> {};
+    auto done = di::Atomic<bool>(false);
+    auto torn = di::Atomic<int>(0);
+
+    std::thread readers[reader_count];
+    for (auto& thread : readers) {
+        thread = std::thread([&] {
+            auto reader = cell.reader();
+            auto last = 0;
+            while (!done.load(di::MemoryOrder::Relaxed)) {
+                reader.read([&](Pair const& pair) {
+                    // Snapshots are immutable and published in order, so they are never torn and never go backwards.
+                    if (pair.a != pair.b || pair.a < last) {
+                        torn.fetch_add(1);
+                    }
+                    last = pair.a;
+                });
+            }
+        });
+    }
+
+    for (auto i = 0; i < updates; i++) {
+        cell.update([](Pair& pair) {
+            pair.a++;
+            pair.b++;
+        });
+    }
+    done.store(true);
+    for (auto& thread : readers) {
+        thread.join();
+    }
+
+    ASSERT_EQ(torn.load(), 0);
+    ASSERT_EQ(cell.read().a, updates);
+}
+
+TEST(sync_read_mostly, basic)
+TEST(sync_read_mostly, concurrent)
+}
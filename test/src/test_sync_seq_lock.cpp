@@ -0,0 +1,62 @@
+#include <thread>
+
+#include "di/sync/prelude.h"
+#include "di/test/prelude.h"
+
+namespace sync_seq_lock {
+struct Calibration {
+    u64 offset { 0 };
+    u32 multiplier { 0 };
+    u8 shift { 0 };
+
+    auto operator==(Calibration const&) const -> bool = default;
+};
+
+static void basic() {
+    auto lock = di::SeqLock<Calibration> {};
+    ASSERT_EQ(lock.load(), Calibration {});
+
+    lock.store({ 1, 2, 3 });
+    ASSERT_EQ(lock.load(), (Calibration { 1, 2, 3 }));
+
+    auto small = di::SeqLock<u8>(7);
+    ASSERT_EQ(small.load(), 7);
+    small.store(8);
+    ASSERT_EQ(small.load(), 8);
+}
+
+static void concurrent() {
+    constexpr auto reader_count = 4;
+    constexpr auto writes = u64(10000);
+
+    auto lock = di::SeqLock<Calibration> {};
+    auto done = di::Atomic<bool>(false);
+    auto torn = di::Atomic<int>(0);
+
+    std::thread readers[reader_count];
+    for (auto& thread : readers) {
+        thread = std::thread([&] {
+            while (!done.load(di::MemoryOrder::Relaxed)) {
+                auto value = lock.load();
+                if (value.multiplier != u32(value.offset) || value.shift != u8(value.offset)) {
+                    torn.fetch_add(1);
+                }
+            }
+        });
+    }
+
+    for (auto i = u64(1); i <= writes; i++) {
+        lock.store({ i, u32(i), u8(i) });
+    }
+    done.store(true);
+    for (auto& thread : readers) {
+        thread.join();
+    }
+
+    ASSERT_EQ(torn.load(), 0);
+    ASSERT_EQ(lock.load().offset, writes);
+}
+
+TEST(sync_seq_lock, basic)
+TEST(sync_seq_lock, concurrent)
+}
@@ -0,0 +1,73 @@
+#include <thread>
+
+#include "di/sync/prelude.h"
+#include "di/test/prelude.h"
+
+namespace sync_shared_mutex {
+static void basic() {
+    auto lock = di::SharedMutex {};
+
+    ASSERT(lock.try_lock_shared());
+    ASSERT(lock.try_lock_shared());
+    ASSERT(!lock.try_lock());
+    lock.unlock_shared();
+    lock.unlock_shared();
+
+    ASSERT(lock.try_lock());
+    ASSERT(!lock.try_lock());
+    ASSERT(!lock.try_lock_shared());
+    lock.unlock();
+
+    lock.lock_shared();
+    lock.unlock_shared();
+    lock.lock();
+    lock.unlock();
+}
+
+static void synchronized() {
+    constexpr auto writer_count = 2;
+    constexpr auto reader_count = 4;
+    constexpr auto iterations = 10000;
+
+    struct Pair {
+        int a { 0 };
+        int b { 0 };
+    };
+
+    auto value = di::Synchronized<Pair, di::SharedMutex> {};
+    auto torn = di::Atomic<int>(0);
+
+    std::thread threads[writer_count + reader_count];
+    for (auto i = 0; i < writer_count + reader_count; i++) {
+        if (i < writer_count) {
+            threads[i] = std::thread([&] {
+                for (auto j = 0; j < iterations; j++) {
+                    value.with_lock([](Pair& pair) {
+                        pair.a++;
+                        pair.b++;
+                    });
+                }
+            });
+        } else {
+            threads[i] = std::thread([&] {
+                for (auto j = 0; j < iterations; j++) {
+                    value.with_read_lock([&](Pair const& pair) {
+                        if (pair.a != pair.b) {
+                            torn.fetch_add(1);
+                        }
+                    });
+                }
+            });
+        }
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(torn.load(), 0);
+    ASSERT_EQ(value.read().a, writer_count * iterations);
+}
+
+TEST(sync_shared_mutex, basic)
+TEST(sync_shared_mutex, synchronized)
+}
@@ -0,0 +1,79 @@
+#include <thread>
+
+#include "di/sync/prelude.h"
+#include "di/test/prelude.h"
+
+namespace sync_stat_counter {
+static void cache_padded() {
+    static_assert(alignof(di::CachePadded<u8>) == di::hardware_destructive_interference_size);
+    static_assert(sizeof(di::CachePadded<u8>) == di::hardware_destructive_interference_size);
+
+    struct Large {
+        u8 bytes[200];
+    };
+    static_assert(sizeof(di::CachePadded<Large>) % di::hardware_destructive_interference_size == 0);
+
+    struct Counters {
+        di::CachePadded<di::Atomic<u32>> a { 1U };
+        di::CachePadded<di::Atomic<u32>> b;
+    };
+    auto counters = Counters {};
+    ASSERT_EQ(counters.a->load(), 1U);
+    ASSERT_EQ(counters.b->load(), 0U);
+    ASSERT_GT(reinterpret_cast<uptr>(&counters.b) - reinterpret_cast<uptr>(&counters.a),
+              di::hardware_destructive_interference_size - 1);
+
+    // CacheIsolated keeps the value's own alignment, and pads it on both sides instead.
+    static_assert(alignof(di::CacheIsolated<di::Atomic<u32>>) == alignof(di::Atomic<u32>));
+
+    struct Isolated {
+        u8 before { 0 };
+        di::CacheIsolated<di::Atomic<u32>> value { 2U };
+        u8 after { 0 };
+    };
+    auto isolated = Isolated {};
+    ASSERT_EQ(isolated.value->load(), 2U);
+
+    auto const padding = di::hardware_destructive_interference_size - alignof(di::Atomic<u32>);
+    auto const value_address = reinterpret_cast<uptr>(&*isolated.value);
+    ASSERT_GT_EQ(value_address - reinterpret_cast<uptr>(&isolated.before), padding);
+    ASSERT_GT_EQ(reinterpret_cast<uptr>(&isolated.after) - value_address, padding);
+}
+
+static void basic() {
+    auto counter = di::StatCounter {};
+    ASSERT_EQ(counter.load(), 0U);
+
+    counter.add();
+    counter.add(5);
+    counter.sub(2);
+    ASSERT_EQ(counter.load(), 4U);
+
+    counter.reset();
+    ASSERT_EQ(counter.load(), 0U);
+}
+
+static void concurrent() {
+    constexpr auto thread_count = 8;
+    constexpr auto iterations = 10000;
+
+    auto counter = di::StatCounter {};
+    std::thread threads[thread_count];
+    for (auto& thread : threads) {
+        thread = std::thread([&] {
+            for (auto i = 0; i < iterations; i++) {
+                counter.add();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(counter.load(), u64(thread_count * iterations));
+}
+
+TEST(sync_stat_counter, cache_padded)
+TEST(sync_stat_counter, basic)
+TEST(sync_stat_counter, concurrent)
+}